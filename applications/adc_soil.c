@@ -57,6 +57,7 @@ void adc1_2_entry(void * parameters)
         sensor_msg_t *msg = rt_malloc(sizeof(sensor_msg_t));
         if (!msg) {
             rt_kprintf("malloc for soil msg failed\n");
+            sensor_msg_stats.dropped++;
             continue;
         }
 
@@ -72,7 +73,10 @@ void adc1_2_entry(void * parameters)
 
         if (result != RT_EOK) {
             rt_kprintf("rt_mq_send soil error: %d\n", result);
+            sensor_msg_stats.dropped++;
             rt_free(msg);
+        } else {
+            sensor_msg_stats.sent++;
         }
 
         rt_mutex_release(sensor_msg_mutex);
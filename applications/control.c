@@ -9,58 +9,41 @@
  */
 #include <rtthread.h>
 #include <rtdevice.h>
-#include <sys/socket.h>
-#include <arpa/inet.h>
 #include "board.h"
 #include "sensor_msg.h"
+#include "control.h"
+#include "http_cache.h"
+#include "http_push.h"
+#include "http_server.h"
+#include "sensor_history.h"
 #include "sean_ws2812b.h"
 #include <wlan_mgnt.h>
 #include <wlan_cfg.h>
 #include <drv_sdio.h>
 
-//硬件配置
-#define FAN_PWM_DEVICE     "pwm3"
-#define FAN_PWM_CHANNEL    2
-#define FAN_PERIOD         10000000  //10ms周期
-#define SERVO_PWM_DEVICE   "pwm3"
-#define SERVO_PWM_CHANNEL  3
-#define SERVO_PERIOD       20000000  //20ms周期
-#define SERVO_MIN_PULSE    500000    //0.5ms (0°)
-#define SERVO_MAX_PULSE    2500000   //2.5ms (180°)
-#define WATER_PUMP_PIN     GET_PIN(H, 3)
-
-
-
-
 #define AP_SSID              "NURSERY"
 #define AP_PASSWORD          "12345678"
 #define AP_CHANNEL           6
 
-#define HTTP_PORT            80
-#define MAX_CONNECTIONS      5
-#define RECV_BUF_SIZE        1024
-
-
-//控制命令定义
-#define CMD_MANUAL_ENABLE  200
-#define CMD_MANUAL_DISABLE 201
-#define PUMP_CTRL_BASE     300
-
 //全局变量
 static struct rt_device_pwm *pwm_fan;
 static struct rt_device_pwm *pwm_servo;
 static rt_tick_t pump_start_time = 0;
 uint8_t g_manual_ctrl = CMD_MANUAL_DISABLE;
 
-//传感器数据结构
-typedef struct {
-    float temperature;
-    float humidity;
-    float soil_humidity;
-    float light_intensity;
-} sensor_data_t;
-
-static sensor_data_t sensor_data = {0};
+sensor_data_t sensor_data = {.growth_stage = GROWTH_STAGE_UNKNOWN};
+volatile rt_uint32_t sensor_data_version;
+
+const sensor_channel_t g_sensor_channels[] = {
+    {"temp",  &sensor_data.temperature,     1},
+    {"humi",  &sensor_data.humidity,        1},
+    {"soil",  &sensor_data.soil_humidity,   1},
+    {"light", &sensor_data.light_intensity, 1},
+    {"stage", &sensor_data.growth_stage,    0},
+    {"stage_conf", &sensor_data.growth_confidence, 2},
+    {"pest",  &sensor_data.pest_count,      0},
+};
+const rt_size_t g_sensor_channel_num = sizeof(g_sensor_channels) / sizeof(g_sensor_channels[0]);
 static struct rt_wlan_info ap_info;
 
 //网页HTML内容
@@ -71,20 +54,48 @@ const char *index_html =
     "<p><a href='/control.html'>设备控制</a></p></body></html>";
 
 const char *dashboard_html =
-    "<html><head><title>仪表盘</title><meta http-equiv=\"refresh\" content=\"2\">"
+    "<html><head><title>仪表盘</title>"
     "<style>body{font-family:Arial,sans-serif;margin:20px}</style></head>"
     "<body><h1>环境数据监测</h1>"
     "<div id='sensor-data'>加载中...</div>"
+    "<h2>定时照片</h2>"
+    "<div id='snaps'>加载中...</div>"
     "<script>"
-    "function updateData(){"
-    "  fetch('/api/sensors').then(r=>r.json()).then(data=>{"
-    "    document.getElementById('sensor-data').innerHTML = "
-    "      `温度: ${data.temp}°C<br>湿度: ${data.humi}%<br>"
-    "      土壤湿度: ${data.soil}%<br>光照: ${data.light}Lux`;"
+    "var data={};"
+    "function render(){"
+    "  document.getElementById('sensor-data').innerHTML = "
+    "    `温度: ${data.temp}°C<br>湿度: ${data.humi}%<br>"
+    "    土壤湿度: ${data.soil}%<br>光照: ${data.light}Lux<br>"
+    "    生长阶段: ${data.stage>=0?['幼苗','营养生长','开花'][data.stage]+' ('+data.stage_conf+')':'--'}<br>"
+    "    虫害: ${data.pest>0?data.pest+'处':'无'}`;"
+    "}"
+    "function merge(d){Object.assign(data,d);render();}"
+    "function poll(){fetch('/api/sensors').then(r=>r.json()).then(merge);}"
+    // 优先使用SSE推送增量，不支持时退回2秒轮询
+    "if(window.EventSource){"
+    "  new EventSource('/api/events').onmessage=function(e){merge(JSON.parse(e.data));};"
+    "}else{"
+    "  setInterval(poll, 2000);"
+    "  poll();"
+    "}"
+    // 照片列表和图片都需要登录；文件发送缓冲只有两块，只给最新几张出缩略图，其余给链接
+    "function snaps(){"
+    "  var el=document.getElementById('snaps');"
+    "  fetch('/api/snapshots').then(function(r){"
+    "    if(r.status==401){el.innerHTML=\"请先在<a href='/control.html'>设备控制</a>页登录\";return;}"
+    "    if(!r.ok){el.textContent='不可用';return;}"
+    "    return r.json().then(function(d){"
+    "      if(!d.files.length){el.textContent='暂无照片';return;}"
+    "      el.innerHTML=d.files.map(function(f,i){"
+    "        var u=d.dir+'/'+f;"
+    "        return i<8?`<a href='${u}' target='_blank'><img src='${u}' width='160' loading='lazy' title='${f}'></a>`"
+    "                  :`<br><a href='${u}' target='_blank'>${f}</a>`;"
+    "      }).join(' ');"
+    "    });"
     "  });"
     "}"
-    "setInterval(updateData, 2000);"
-    "updateData();"
+    "snaps();"
+    "setInterval(snaps, 60000);"
     "</script></body></html>";
 
 const char *control_html =
@@ -112,27 +123,40 @@ const char *control_html =
     "<button id='pump-off'>关闭</button>"
     "</div>"
 
+    "<div class='control-group'>"
+    "<input type='password' id='pass' placeholder='管理密码'>"
+    "<button id='login'>登录</button> <span id='login-state'></span>"
+    "</div>"
+
     "<script>"
-    "// 风扇控制"
+    //风扇控制
     "document.getElementById('fan-slider').oninput = function(){"
     "  document.getElementById('fan-value').textContent = this.value;"
     "  fetch('/api/control?cmd=' + this.value);"
     "};"
 
-    "// 舵机控制"
+    //舵机控制
     "document.getElementById('servo-slider').oninput = function(){"
     "  var angle = parseInt(this.value);"
     "  document.getElementById('servo-value').textContent = angle;"
     "  fetch('/api/control?cmd=' + (103 + angle));"  // 103-283对应0-180°
     "};"
 
-    "// 水泵控制"
+    //水泵控制
     "document.getElementById('pump-on').onclick = function(){"
     "  fetch('/api/control?cmd=301');"  // 开启水泵
     "};"
     "document.getElementById('pump-off').onclick = function(){"
     "  fetch('/api/control?cmd=300');"  // 关闭水泵
     "};"
+
+    //登录，令牌由Cookie带回，之后的控制请求自动携带
+    "document.getElementById('login').onclick = function(){"
+    "  fetch('/api/login', {method:'POST', body:'password=' + document.getElementById('pass').value})"
+    "  .then(function(r){"
+    "    document.getElementById('login-state').textContent = r.ok ? '已登录' : '密码错误';"
+    "  });"
+    "};"
     "</script></body></html>";
 
 //启动AP模式
@@ -229,136 +253,83 @@ void auto_thread()
     }
 }
 
-//HTTP服务器线程
-static void http_server_thread(void *parameter)
+void sensor_json_write(json_writer_t *w)
 {
-    int sock, connected;
-    struct sockaddr_in server_addr, client_addr;
-    socklen_t client_addr_len = sizeof(client_addr);
-    char recv_data[1024];
-    int is_running = 1;
-
-    //创建socket
-    if ((sock = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
-        rt_kprintf("Socket创建失败\n");
-        return;
+    rt_size_t i;
+
+    json_object_begin(w);
+    for (i = 0; i < g_sensor_channel_num; i++) {
+        json_key(w, g_sensor_channels[i].key);
+        json_float(w, *g_sensor_channels[i].value, g_sensor_channels[i].decimals);
     }
+    json_object_end(w);
+}
 
-    //配置服务器地址
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(80);
-    server_addr.sin_addr.s_addr = INADDR_ANY;
+static void http_send_page(int sock, const char *html)
+{
+    int len = rt_strlen(html);
 
-    //绑定socket
-    if (bind(sock, (struct sockaddr *)&server_addr, sizeof(server_addr)) != RT_EOK)
-    {
-        rt_kprintf("绑定端口80失败\n");
-        closesocket(sock);
-        return;
+    if (http_send_header(sock, 200, "text/html", len) == RT_EOK) {
+        http_sock_flush(&sock, html, len);
     }
+}
 
-    //开始监听
-    listen(sock, 5);
-    rt_kprintf("HTTP服务器已启动，监听端口80\n");
-
-    while (is_running) {
-        //接受客户端连接
-        if ((connected = accept(sock, (struct sockaddr *)&client_addr, &client_addr_len)) < 0) {
-            rt_kprintf("接受连接失败\n");
-            continue;
-        }
+//处理网页请求
+static void index_handler(http_request_t *req)
+{
+    http_send_page(req->sock, index_html);
+}
+HTTP_ROUTE_EXPORT(root, HTTP_GET, "/", index_handler, HTTP_ROUTE_NONE);
+HTTP_ROUTE_EXPORT(index, HTTP_GET, "/index.html", index_handler, HTTP_ROUTE_NONE);
 
-        //接收客户端数据
-        int recv_len = recv(connected, recv_data, sizeof(recv_data) - 1, 0);
-        if (recv_len <= 0) {
-            closesocket(connected);
-            continue;
-        }
-        recv_data[recv_len] = '\0';
+static void dashboard_handler(http_request_t *req)
+{
+    http_send_page(req->sock, dashboard_html);
+}
+HTTP_ROUTE_EXPORT(dashboard, HTTP_GET, "/dashboard.html", dashboard_handler, HTTP_ROUTE_NONE);
 
-        //解析请求类型和路径
-        char *method = strtok(recv_data, " ");
-        char *path = strtok(NULL, " ");
+static void control_page_handler(http_request_t *req)
+{
+    http_send_page(req->sock, control_html);
+}
+HTTP_ROUTE_EXPORT(control_page, HTTP_GET, "/control.html", control_page_handler, HTTP_ROUTE_NONE);
 
-        if (!method || !path) {
-            closesocket(connected);
-            continue;
-        }
+static void sensors_build(http_request_t *req, json_writer_t *w)
+{
+    sensor_json_write(w);
+}
 
-        //处理API请求
-        if (strcmp(path, "/api/sensors") == 0) {
-            char json[128];
-            rt_snprintf(json, sizeof(json),
-                "{\"temp\":%.1f,\"humi\":%.1f,\"soil\":%.1f,\"light\":%.1f}",
-                sensor_data.temperature,
-                sensor_data.humidity,
-                sensor_data.soil_humidity,
-                sensor_data.light_intensity);
-
-            char header[256];
-            rt_snprintf(header, sizeof(header),
-                "HTTP/1.1 200 OK\r\n"
-                "Content-Type: application/json\r\n"
-                "Content-Length: %d\r\n\r\n",
-                rt_strlen(json));
-
-            send(connected, header, rt_strlen(header), 0);
-            send(connected, json, rt_strlen(json), 0);
-        }
-        //处理控制命令
-        else if (strcmp(path, "/api/control") == 0) {
-            char *cmd_str = strstr(recv_data, "cmd=");
-            if (cmd_str) {
-                handle_control_command(atoi(cmd_str + 4));
-                send(connected, "HTTP/1.1 200 OK\r\n\r\nOK", 22, 0);
-            } else {
-                send(connected, "HTTP/1.1 400 Bad Request\r\n\r\nError", 33, 0);
-            }
-        }
-        //处理网页请求
-        else if (strcmp(path, "/") == 0 || strcmp(path, "/index.html") == 0) {
-            char header[256];
-            rt_snprintf(header, sizeof(header),
-                "HTTP/1.1 200 OK\r\n"
-                "Content-Type: text/html\r\n"
-                "Content-Length: %d\r\n\r\n",
-                rt_strlen(index_html));
-
-            send(connected, header, rt_strlen(header), 0);
-            send(connected, index_html, rt_strlen(index_html), 0);
-        }
-        else if (strcmp(path, "/dashboard.html") == 0) {
-            char header[256];
-            rt_snprintf(header, sizeof(header),
-                "HTTP/1.1 200 OK\r\n"
-                "Content-Type: text/html\r\n"
-                "Content-Length: %d\r\n\r\n",
-                rt_strlen(dashboard_html));
-
-            send(connected, header, rt_strlen(header), 0);
-            send(connected, dashboard_html, rt_strlen(dashboard_html), 0);
-        }
-        else if (strcmp(path, "/control.html") == 0) {
-            char header[256];
-            rt_snprintf(header, sizeof(header),
-                "HTTP/1.1 200 OK\r\n"
-                "Content-Type: text/html\r\n"
-                "Content-Length: %d\r\n\r\n",
-                rt_strlen(control_html));
-
-            send(connected, header, rt_strlen(header), 0);
-            send(connected, control_html, rt_strlen(control_html), 0);
-        }
-        //处理其他请求
-        else {
-            send(connected, "HTTP/1.1 404 Not Found\r\n\r\nNot Found", 36, 0);
-        }
+//处理API请求，两次传感器更新之间的轮询直接由缓存回复
+static void sensors_handler(http_request_t *req)
+{
+    http_cache_send(req, sensor_data_version, sensors_build);
+}
+HTTP_ROUTE_EXPORT(sensors, HTTP_GET, "/api/sensors", sensors_handler, HTTP_ROUTE_NONE);
 
-        closesocket(connected);
+//SSE推送通道，连接交由http_push管理，不在此处关闭
+static void events_handler(http_request_t *req)
+{
+    if (http_push_attach(req->sock) == RT_EOK) {
+        req->detached = RT_TRUE;
+        return;
     }
+    http_send_simple(req->sock, 503, "Busy");
+}
+HTTP_ROUTE_EXPORT(events, HTTP_GET, "/api/events", events_handler, HTTP_ROUTE_NONE);
+
+//处理控制命令
+static void control_handler(http_request_t *req)
+{
+    rt_int32_t cmd;
 
-    closesocket(sock);
+    if (http_query_int(req->query, "cmd", &cmd) == RT_EOK) {
+        handle_control_command(cmd);
+        http_send_simple(req->sock, 200, "OK");
+    } else {
+        http_send_simple(req->sock, 400, "Error");
+    }
 }
+HTTP_ROUTE_EXPORT(control, HTTP_GET, "/api/control", control_handler, HTTP_ROUTE_AUTH);
 
 //主控制线程
 void control_center_entry(void *parameters)
@@ -386,16 +357,7 @@ void control_center_entry(void *parameters)
     rt_pin_write(WATER_PUMP_PIN, PIN_LOW);
 
     //创建HTTP服务器线程
-    rt_thread_t http_thread = rt_thread_create("http_server",
-                                             http_server_thread,
-                                             RT_NULL,
-                                             2048,
-                                             10,
-                                             10);
-    if (http_thread) {
-        rt_thread_startup(http_thread);
-        rt_kprintf("HTTP服务器线程已启动\n");
-    }
+    http_server_start();
 
     //主循环 - 处理传感器数据和控制逻辑
     while (1) {
@@ -404,23 +366,45 @@ void control_center_entry(void *parameters)
         //从消息队列接收传感器数据指针
         if (rt_mq_recv(sensor_msg_mq, &msg_ptr, sizeof(msg_ptr), RT_WAITING_FOREVER) == RT_EOK) {
             if (msg_ptr) {
+                rt_tick_t latency = rt_tick_get() - msg_ptr->timestamp;
+                float *field = RT_NULL;
+
+                sensor_msg_stats.received++;
+                sensor_msg_stats.latency_total += latency;
+                if (latency > sensor_msg_stats.latency_max) {
+                    sensor_msg_stats.latency_max = latency;
+                }
+
                 // 更新全局传感器数据
                 switch (msg_ptr->sensor_id) {
                 case TEMP_INSIDE:
-                    sensor_data.temperature = msg_ptr->value;
+                    field = &sensor_data.temperature;
                     break;
                 case HUMI_INSIDE:
-                    sensor_data.humidity = msg_ptr->value;
+                    field = &sensor_data.humidity;
                     break;
                 case HUMI_EARTH:
-                    sensor_data.soil_humidity = msg_ptr->value;
+                    field = &sensor_data.soil_humidity;
                     break;
                 case LIGHT_OUTSIDE:
-                    sensor_data.light_intensity = msg_ptr->value;
+                    field = &sensor_data.light_intensity;
+                    break;
+                case GROWTH_STAGE:
+                    field = &sensor_data.growth_stage;
+                    break;
+                case GROWTH_CONF:
+                    field = &sensor_data.growth_confidence;
+                    break;
+                case PEST_DETECT:
+                    field = &sensor_data.pest_count;
                     break;
                 default:
                     break;
                 }
+                if (field && *field != msg_ptr->value) {
+                    *field = msg_ptr->value;
+                    sensor_data_version++;
+                }
 
                 rt_kprintf("传感器更新: T=%.1fC H=%.1f%% S=%.1f%% L=%.1fLux\n",
                           sensor_data.temperature,
@@ -428,6 +412,11 @@ void control_center_entry(void *parameters)
                           sensor_data.soil_humidity,
                           sensor_data.light_intensity);
 
+                // 推送变化给SSE订阅者
+                http_push_publish();
+                // 累计分钟均值并落盘
+                sensor_history_sample();
+
                 // 释放消息内存
                 rt_free(msg_ptr);
             }
@@ -449,7 +438,7 @@ void control_center_entry(void *parameters)
 }
 
 // 初始化函数
-static int control_center_init(void)
+int control_center_init(void)
 {
     rt_thread_t control_thread = rt_thread_create("control_center",
                                                control_center_entry,
@@ -13,6 +13,7 @@
 #include <rtthread.h>
 #include <rtdevice.h>
 #include "sensor_msg.h"
+#include "json_writer.h"
 
 // PWM设备配置
 #define FAN_PWM_DEVICE     "pwm3"
@@ -33,20 +34,40 @@
 #define CMD_MANUAL_DISABLE 201
 #define PUMP_CTRL_BASE     300         // 水泵控制命令基准值
 
+#define GROWTH_STAGE_UNKNOWN  (-1)    // 还没有推理结果，仪表盘显示为"--"
+
 // 传感器数据结构
 typedef struct {
     float temperature;     // 温度 (°C)
     float humidity;        // 空气湿度 (%)
     float soil_humidity;   // 土壤湿度 (%)
     float light_intensity; // 光照强度 (Lux)
+    float growth_stage;    // 生长阶段：0幼苗 1营养生长 2开花，GROWTH_STAGE_UNKNOWN为尚未识别
+    float growth_confidence; // 生长阶段置信度 (0~1)
+    float pest_count;      // 视觉确认的虫害目标数
 } sensor_data_t;
 
+// 传感器通道描述，API层按此表输出，新增通道只需在表中追加
+typedef struct {
+    const char *key;       // JSON键名
+    float *value;          // 指向sensor_data中的字段
+    rt_uint8_t decimals;   // 输出的小数位数
+} sensor_channel_t;
+
+#define SENSOR_CHANNEL_MAX 16
+
 // 全局变量声明
 extern sensor_data_t sensor_data;
+extern const sensor_channel_t g_sensor_channels[];
+extern const rt_size_t g_sensor_channel_num;
 extern uint8_t g_manual_ctrl;
+// 传感器数据版本号，任一通道数值变化时加一，供响应缓存判断是否过期
+extern volatile rt_uint32_t sensor_data_version;
 
 // 函数声明
 void control_center_entry(void *parameters);
 int control_center_init(void);
+// 按通道表输出当前传感器数据对象
+void sensor_json_write(json_writer_t *w);
 
 #endif /* APPLICATIONS_CONTROL_H_ */
@@ -54,6 +54,7 @@ static void read_temp_entry(void *parameter)
 
             if (!temp_msg || !humi_msg) {
                 rt_kprintf("malloc for sensor msg failed\n");
+                sensor_msg_stats.dropped += 2;
                 if (temp_msg) rt_free(temp_msg);
                 if (humi_msg) rt_free(humi_msg);
                 continue;
@@ -76,12 +77,18 @@ static void read_temp_entry(void *parameter)
             result = rt_mq_send(sensor_msg_mq, &temp_msg, sizeof(sensor_msg_t*));
             if (result != RT_EOK) {
                 rt_kprintf("rt_mq_send TEMP_INSIDE ERR\n");
+                sensor_msg_stats.dropped++;
+            } else {
+                sensor_msg_stats.sent++;
             }
 
             rt_sem_take(sensor_msg_sem_empty, RT_WAITING_FOREVER);
             result = rt_mq_send(sensor_msg_mq, &humi_msg, sizeof(sensor_msg_t*));
             if (result != RT_EOK) {
                 rt_kprintf("rt_mq_send HUMI_INSIDE ERR\n");
+                sensor_msg_stats.dropped++;
+            } else {
+                sensor_msg_stats.sent++;
             }
 
             rt_mutex_release(sensor_msg_mutex);
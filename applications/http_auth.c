@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include <string.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <easyflash.h>
+#include "board.h"
+#include "control.h"
+#include "http_auth.h"
+#include "metrics.h"
+
+/*
+ * 令牌 = hex(payload) + hex(tag)
+ * payload: epoch(4) + 会话号(4) + 过期时间(4)，小端
+ * tag:     HMAC-SHA256(key, payload)的前16字节
+ * HMAC的ipad/opad两块在加载密钥时各压缩一次并缓存中间状态，
+ * 校验一个令牌只需两次SHA-256块压缩。
+ * epoch存放在EasyFlash环境变量auth_epoch中，加一即吊销全部旧令牌。
+ */
+
+#define AUTH_BODY_MAX             72
+#define AUTH_BENCH_LOOPS          10000
+
+typedef struct sha256_ctx_
+{
+    rt_uint32_t h[8];
+    rt_uint32_t total;
+    rt_uint8_t buf[64];
+} sha256_ctx_t;
+
+static struct
+{
+    volatile rt_bool_t ready;       /* 校验路径不持锁读取，置位前其余字段已写好 */
+    rt_uint32_t epoch;
+    rt_uint32_t sid;
+    rt_uint8_t key[AUTH_KEY_SIZE];
+    rt_uint8_t pass[32];            /* 管理密码的SHA-256 */
+    sha256_ctx_t inner;             /* 已压缩key^ipad的中间状态 */
+    sha256_ctx_t outer;             /* 已压缩key^opad的中间状态 */
+} auth;
+
+// 密码错误的客户端地址及冷却结束时刻，由auth_lock保护
+static struct
+{
+    rt_uint32_t addr;
+    rt_tick_t until;
+} auth_lockout[AUTH_LOCKOUT_SLOTS];
+
+struct http_auth_stats http_auth_stats;
+
+METRIC_EXPORT(auth_login_ok, "http_auth_logins_total", "result=\"ok\"", METRIC_COUNTER,
+              "Login attempts", &http_auth_stats.logins);
+METRIC_EXPORT(auth_login_fail, "http_auth_logins_total", "result=\"failed\"", METRIC_COUNTER,
+              "Login attempts", &http_auth_stats.login_failures);
+METRIC_EXPORT(auth_ok, "http_auth_checks_total", "result=\"ok\"", METRIC_COUNTER,
+              "Token checks on protected routes", &http_auth_stats.verified);
+METRIC_EXPORT(auth_reject, "http_auth_checks_total", "result=\"rejected\"", METRIC_COUNTER,
+              "Token checks on protected routes", &http_auth_stats.rejected);
+
+static rt_mutex_t auth_lock;
+
+static const rt_uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define ROR32(x, n)     (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256_block(rt_uint32_t h[8], const rt_uint8_t *p)
+{
+    rt_uint32_t w[64];
+    rt_uint32_t a, b, c, d, e, f, g, k;
+    int i;
+
+    for (i = 0; i < 16; i++) {
+        w[i] = (rt_uint32_t)p[i * 4] << 24 | (rt_uint32_t)p[i * 4 + 1] << 16 |
+               (rt_uint32_t)p[i * 4 + 2] << 8 | p[i * 4 + 3];
+    }
+    for (i = 16; i < 64; i++) {
+        rt_uint32_t s0 = ROR32(w[i - 15], 7) ^ ROR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        rt_uint32_t s1 = ROR32(w[i - 2], 17) ^ ROR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = h[0]; b = h[1]; c = h[2]; d = h[3];
+    e = h[4]; f = h[5]; g = h[6]; k = h[7];
+    for (i = 0; i < 64; i++) {
+        rt_uint32_t t1 = k + (ROR32(e, 6) ^ ROR32(e, 11) ^ ROR32(e, 25)) +
+                         ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];
+        rt_uint32_t t2 = (ROR32(a, 2) ^ ROR32(a, 13) ^ ROR32(a, 22)) +
+                         ((a & b) ^ (a & c) ^ (b & c));
+
+        k = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+    h[4] += e; h[5] += f; h[6] += g; h[7] += k;
+}
+
+static void sha256_init(sha256_ctx_t *ctx)
+{
+    static const rt_uint32_t iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+
+    rt_memcpy(ctx->h, iv, sizeof(iv));
+    ctx->total = 0;
+}
+
+static void sha256_update(sha256_ctx_t *ctx, const void *data, rt_size_t len)
+{
+    const rt_uint8_t *p = data;
+
+    while (len > 0) {
+        rt_size_t fill = ctx->total % 64;
+        rt_size_t n = 64 - fill < len ? 64 - fill : len;
+
+        rt_memcpy(ctx->buf + fill, p, n);
+        ctx->total += n;
+        p += n;
+        len -= n;
+        if (ctx->total % 64 == 0) {
+            sha256_block(ctx->h, ctx->buf);
+        }
+    }
+}
+
+static void sha256_final(sha256_ctx_t *ctx, rt_uint8_t out[32])
+{
+    rt_uint32_t bits = ctx->total * 8;
+    rt_size_t fill = ctx->total % 64;
+    int i;
+
+    ctx->buf[fill++] = 0x80;
+    if (fill > 56) {
+        rt_memset(ctx->buf + fill, 0, 64 - fill);
+        sha256_block(ctx->h, ctx->buf);
+        fill = 0;
+    }
+    rt_memset(ctx->buf + fill, 0, 60 - fill);
+    ctx->buf[60] = bits >> 24;
+    ctx->buf[61] = bits >> 16;
+    ctx->buf[62] = bits >> 8;
+    ctx->buf[63] = bits;
+    sha256_block(ctx->h, ctx->buf);
+
+    for (i = 0; i < 8; i++) {
+        out[i * 4] = ctx->h[i] >> 24;
+        out[i * 4 + 1] = ctx->h[i] >> 16;
+        out[i * 4 + 2] = ctx->h[i] >> 8;
+        out[i * 4 + 3] = ctx->h[i];
+    }
+}
+
+static void hmac_pad_state(sha256_ctx_t *ctx, const rt_uint8_t *key, rt_uint8_t pad)
+{
+    rt_uint8_t block[64];
+    int i;
+
+    for (i = 0; i < 64; i++) {
+        block[i] = (i < AUTH_KEY_SIZE ? key[i] : 0) ^ pad;
+    }
+    sha256_init(ctx);
+    sha256_update(ctx, block, sizeof(block));
+}
+
+//从缓存的中间状态出发，只压缩消息块和外层块
+static void auth_sign(const rt_uint8_t *msg, rt_size_t len, rt_uint8_t mac[32])
+{
+    sha256_ctx_t ctx = auth.inner;
+
+    sha256_update(&ctx, msg, len);
+    sha256_final(&ctx, mac);
+    ctx = auth.outer;
+    sha256_update(&ctx, mac, 32);
+    sha256_final(&ctx, mac);
+}
+
+static void put_le32(rt_uint8_t *p, rt_uint32_t v)
+{
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+}
+
+static rt_uint32_t get_le32(const rt_uint8_t *p)
+{
+    return p[0] | (rt_uint32_t)p[1] << 8 | (rt_uint32_t)p[2] << 16 | (rt_uint32_t)p[3] << 24;
+}
+
+static void auth_hex_encode(const rt_uint8_t *in, rt_size_t len, char *out)
+{
+    static const char hex[] = "0123456789abcdef";
+    rt_size_t i;
+
+    for (i = 0; i < len; i++) {
+        out[i * 2] = hex[in[i] >> 4];
+        out[i * 2 + 1] = hex[in[i] & 0x0f];
+    }
+    out[len * 2] = '\0';
+}
+
+static int auth_hex_digit(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+static rt_err_t auth_hex_decode(const char *in, rt_uint8_t *out, rt_size_t len)
+{
+    rt_size_t i;
+
+    for (i = 0; i < len; i++) {
+        int hi = auth_hex_digit(in[i * 2]);
+        int lo = hi < 0 ? -1 : auth_hex_digit(in[i * 2 + 1]);
+
+        if (lo < 0) {
+            return -RT_EINVAL;
+        }
+        out[i] = (rt_uint8_t)(hi << 4 | lo);
+    }
+    return RT_EOK;
+}
+
+//板上未启用RNG外设，用芯片UID、SysTick计数和运行时数据混合出随机密钥，只在首次启动时生成一次
+static void auth_random(rt_uint8_t out[32])
+{
+    sha256_ctx_t ctx;
+    rt_uint32_t seed[6];
+    int i;
+
+    sha256_init(&ctx);
+    for (i = 0; i < 8; i++) {
+        seed[0] = HAL_GetUIDw0();
+        seed[1] = HAL_GetUIDw1();
+        seed[2] = HAL_GetUIDw2();
+        seed[3] = rt_tick_get();
+        seed[4] = SysTick->VAL;
+        seed[5] = (rt_uint32_t)time(RT_NULL);
+        sha256_update(&ctx, seed, sizeof(seed));
+        sha256_update(&ctx, &sensor_data, sizeof(sensor_data));
+        rt_thread_mdelay(1 + (SysTick->VAL & 0x07));
+    }
+    sha256_final(&ctx, out);
+}
+
+static void auth_hash_password(const char *pass, rt_uint8_t out[32])
+{
+    sha256_ctx_t ctx;
+
+    sha256_init(&ctx);
+    sha256_update(&ctx, pass, rt_strlen(pass));
+    sha256_final(&ctx, out);
+}
+
+//启动时加载密钥和epoch，首次启动时生成密钥并写入EasyFlash
+static void auth_load(void)
+{
+    rt_size_t saved = 0;
+
+    rt_mutex_take(auth_lock, RT_WAITING_FOREVER);
+    if (!auth.ready) {
+        ef_get_env_blob("auth_key", auth.key, sizeof(auth.key), &saved);
+        if (saved != sizeof(auth.key)) {
+            auth_random(auth.key);
+            ef_set_env_blob("auth_key", auth.key, sizeof(auth.key));
+        }
+        saved = 0;
+        ef_get_env_blob("auth_epoch", &auth.epoch, sizeof(auth.epoch), &saved);
+        if (saved != sizeof(auth.epoch)) {
+            auth.epoch = 0;
+        }
+        saved = 0;
+        ef_get_env_blob("auth_pass", auth.pass, sizeof(auth.pass), &saved);
+        if (saved != sizeof(auth.pass)) {
+            rt_kprintf("auth: using default password, set one with auth_passwd\n");
+            auth_hash_password(AUTH_DEFAULT_PASSWORD, auth.pass);
+        }
+        hmac_pad_state(&auth.inner, auth.key, 0x36);
+        hmac_pad_state(&auth.outer, auth.key, 0x5c);
+        auth.sid = rt_tick_get();
+        __DMB();
+        auth.ready = RT_TRUE;
+    }
+    rt_mutex_release(auth_lock);
+}
+
+static rt_err_t auth_verify(const char *token)
+{
+    rt_uint8_t raw[AUTH_PAYLOAD_SIZE + AUTH_TAG_SIZE];
+    rt_uint8_t mac[32];
+    rt_uint8_t diff = 0;
+    int i;
+
+    if (rt_strlen(token) < AUTH_TOKEN_LEN ||
+        auth_hex_decode(token, raw, sizeof(raw)) != RT_EOK) {
+        return -RT_EINVAL;
+    }
+    auth_sign(raw, AUTH_PAYLOAD_SIZE, mac);
+    //逐字节比较全部tag，耗时与不匹配位置无关
+    for (i = 0; i < AUTH_TAG_SIZE; i++) {
+        diff |= mac[i] ^ raw[AUTH_PAYLOAD_SIZE + i];
+    }
+    if (diff != 0 || get_le32(raw) != auth.epoch) {
+        return -RT_EINVAL;
+    }
+    if (get_le32(raw + 8) < (rt_uint32_t)time(RT_NULL)) {
+        return -RT_ETIMEOUT;
+    }
+    return RT_EOK;
+}
+
+static void auth_issue(char token[AUTH_TOKEN_LEN + 1], rt_uint32_t *expires)
+{
+    rt_uint8_t raw[AUTH_PAYLOAD_SIZE + 32];
+
+    rt_mutex_take(auth_lock, RT_WAITING_FOREVER);
+    *expires = (rt_uint32_t)time(RT_NULL) + AUTH_TOKEN_TTL;
+    put_le32(raw, auth.epoch);
+    put_le32(raw + 4, ++auth.sid);
+    put_le32(raw + 8, *expires);
+    rt_mutex_release(auth_lock);
+
+    auth_sign(raw, AUTH_PAYLOAD_SIZE, raw + AUTH_PAYLOAD_SIZE);
+    auth_hex_encode(raw, AUTH_PAYLOAD_SIZE + AUTH_TAG_SIZE, token);
+}
+
+//取出请求中的令牌，Cookie中可能有多项，只截取token=之后的部分
+static rt_err_t auth_token_get(http_request_t *req, char *buf, rt_size_t size)
+{
+    char *p;
+
+    if (http_header_get(req, "Authorization", buf, size) == RT_EOK &&
+        rt_strncmp(buf, "Bearer ", 7) == 0) {
+        rt_memmove(buf, buf + 7, rt_strlen(buf + 7) + 1);
+        return RT_EOK;
+    }
+    if (http_header_get(req, "Cookie", buf, size) == RT_EOK &&
+        (p = strstr(buf, "token=")) != RT_NULL) {
+        rt_memmove(buf, p + 6, rt_strlen(p + 6) + 1);
+        return RT_EOK;
+    }
+    return -RT_EEMPTY;
+}
+
+rt_err_t http_auth_check(http_request_t *req)
+{
+    char token[AUTH_TOKEN_LEN + 64];
+    rt_err_t result;
+
+    //在I/O线程中调用，只读：密钥未加载（EasyFlash不可用）时一律拒绝
+    if (!auth.ready) {
+        http_auth_stats.rejected++;
+        return -RT_EBUSY;
+    }
+    result = auth_token_get(req, token, sizeof(token));
+    if (result == RT_EOK) {
+        result = auth_verify(token);
+    }
+    if (result == RT_EOK) {
+        http_auth_stats.verified++;
+    } else {
+        http_auth_stats.rejected++;
+    }
+    return result;
+}
+
+rt_uint32_t http_auth_revoke(void)
+{
+    rt_uint32_t epoch;
+
+    if (!auth.ready) {
+        return auth.epoch;
+    }
+    rt_mutex_take(auth_lock, RT_WAITING_FOREVER);
+    epoch = auth.epoch + 1;
+    if (ef_set_env_blob("auth_epoch", &epoch, sizeof(epoch)) == EF_NO_ERR) {
+        auth.epoch = epoch;
+    }
+    epoch = auth.epoch;
+    rt_mutex_release(auth_lock);
+
+    return epoch;
+}
+
+static rt_uint32_t auth_peer_addr(int sock)
+{
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+
+    if (getpeername(sock, (struct sockaddr *)&addr, &len) != 0) {
+        return 0;
+    }
+    return addr.sin_addr.s_addr;
+}
+
+static rt_bool_t auth_locked_out(rt_uint32_t addr)
+{
+    rt_tick_t now = rt_tick_get();
+    rt_bool_t locked = RT_FALSE;
+    int i;
+
+    rt_mutex_take(auth_lock, RT_WAITING_FOREVER);
+    for (i = 0; i < AUTH_LOCKOUT_SLOTS; i++) {
+        if (auth_lockout[i].addr == addr && (rt_int32_t)(auth_lockout[i].until - now) > 0) {
+            locked = RT_TRUE;
+        }
+    }
+    rt_mutex_release(auth_lock);
+
+    return locked;
+}
+
+static void auth_lockout_add(rt_uint32_t addr)
+{
+    rt_tick_t now = rt_tick_get();
+    int i, slot = 0;
+
+    rt_mutex_take(auth_lock, RT_WAITING_FOREVER);
+    //同一客户端沿用原条目，否则替换最早到期的
+    for (i = 0; i < AUTH_LOCKOUT_SLOTS; i++) {
+        if (auth_lockout[i].addr == addr) {
+            slot = i;
+            break;
+        }
+        if ((rt_int32_t)(auth_lockout[i].until - auth_lockout[slot].until) < 0) {
+            slot = i;
+        }
+    }
+    auth_lockout[slot].addr = addr;
+    auth_lockout[slot].until = now + rt_tick_from_millisecond(AUTH_LOGIN_DELAY_MS);
+    http_auth_stats.login_failures++;
+    rt_mutex_release(auth_lock);
+}
+
+//POST /api/login，body为"password=..."，成功后以Cookie和JSON两种方式返回令牌
+//密码错误后该客户端在冷却期内的登录直接回429，slow工作线程不为减速暴力尝试而睡眠
+static void login_handler(http_request_t *req)
+{
+    char body[AUTH_BODY_MAX];
+    char token[AUTH_TOKEN_LEN + 1];
+    char extra[AUTH_TOKEN_LEN + 64];
+    char reply[AUTH_TOKEN_LEN + 48];
+    rt_uint8_t hash[32];
+    rt_uint8_t diff = 0;
+    rt_uint32_t expires;
+    rt_uint32_t peer;
+    rt_size_t len = 0;
+    int i;
+
+    if (!auth.ready) {
+        http_send_simple(req->sock, 503, "auth unavailable");
+        return;
+    }
+    peer = auth_peer_addr(req->sock);
+    if (auth_locked_out(peer)) {
+        http_send_simple(req->sock, 429, "Too Many Requests");
+        return;
+    }
+    if (req->content_length <= 0 || req->content_length >= (rt_int32_t)sizeof(body)) {
+        http_send_simple(req->sock, 400, "bad login");
+        return;
+    }
+    while (len < (rt_size_t)req->content_length) {
+        int n = http_read_body(req, body + len, req->content_length - len);
+
+        if (n <= 0) {
+            return;
+        }
+        len += n;
+    }
+    body[len] = '\0';
+
+    if (rt_strncmp(body, "password=", 9) != 0) {
+        http_send_simple(req->sock, 400, "bad login");
+        return;
+    }
+    auth_hash_password(body + 9, hash);
+    for (i = 0; i < (int)sizeof(hash); i++) {
+        diff |= hash[i] ^ auth.pass[i];
+    }
+    if (diff != 0) {
+        auth_lockout_add(peer);
+        http_send_simple(req->sock, 401, "Unauthorized");
+        return;
+    }
+
+    auth_issue(token, &expires);
+    http_auth_stats.logins++;
+
+    rt_snprintf(extra, sizeof(extra), "Set-Cookie: token=%s; Path=/; HttpOnly; Max-Age=%d\r\n",
+                token, AUTH_TOKEN_TTL);
+    len = rt_snprintf(reply, sizeof(reply), "{\"token\":\"%s\",\"expires\":%u}",
+                      token, (unsigned int)expires);
+    if (http_send_header_extra(req->sock, 200, "application/json", len, extra) == RT_EOK) {
+        http_sock_flush(&req->sock, reply, len);
+    }
+}
+HTTP_ROUTE_EXPORT(login, HTTP_POST, "/api/login", login_handler, HTTP_ROUTE_SLOW);
+
+//POST /api/revoke，使包括当前令牌在内的所有令牌失效
+static void revoke_handler(http_request_t *req)
+{
+    http_auth_revoke();
+    http_send_simple(req->sock, 200, "OK");
+}
+HTTP_ROUTE_EXPORT(revoke, HTTP_POST, "/api/revoke", revoke_handler, HTTP_ROUTE_SLOW | HTTP_ROUTE_AUTH);
+
+static int http_auth_init(void)
+{
+    auth_lock = rt_mutex_create("http_auth", RT_IPC_FLAG_FIFO);
+    if (auth_lock == RT_NULL) {
+        rt_kprintf("create http_auth lock failed\n");
+        return -RT_ENOMEM;
+    }
+    return RT_EOK;
+}
+INIT_COMPONENT_EXPORT(http_auth_init);
+
+//EasyFlash在INIT_ENV阶段已由rt_hw_easyflash_init初始化。首次启动生成密钥要多次延时采样
+//并写flash，放在启动阶段完成，HTTP的I/O线程只做只读校验
+static int http_auth_load(void)
+{
+    auth_load();
+    return RT_EOK;
+}
+INIT_APP_EXPORT(http_auth_load);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void auth_revoke(int argc, char **argv)
+{
+    rt_kprintf("auth epoch is now %d\n", http_auth_revoke());
+}
+MSH_CMD_EXPORT(auth_revoke, revoke all issued http session tokens);
+
+static void auth_passwd(int argc, char **argv)
+{
+    rt_uint8_t hash[32];
+
+    if (argc != 2) {
+        rt_kprintf("usage: auth_passwd <password>\n");
+        return;
+    }
+    if (!auth.ready) {
+        rt_kprintf("auth key not loaded\n");
+        return;
+    }
+    auth_hash_password(argv[1], hash);
+    if (ef_set_env_blob("auth_pass", hash, sizeof(hash)) != EF_NO_ERR) {
+        rt_kprintf("save password failed\n");
+        return;
+    }
+    rt_memcpy(auth.pass, hash, sizeof(hash));
+    http_auth_revoke();
+    rt_kprintf("password changed, old tokens revoked\n");
+}
+MSH_CMD_EXPORT(auth_passwd, set the http admin password);
+
+//完整HMAC（每次重算ipad/opad）与缓存中间状态的校验对比
+static void auth_bench(int argc, char **argv)
+{
+    char token[AUTH_TOKEN_LEN + 1];
+    rt_uint8_t payload[AUTH_PAYLOAD_SIZE];
+    rt_uint8_t mac[32];
+    rt_uint32_t expires;
+    rt_tick_t start, full_ticks, cached_ticks;
+    int i, ok = 0;
+
+    if (!auth.ready) {
+        rt_kprintf("auth key not loaded\n");
+        return;
+    }
+    auth_issue(token, &expires);
+    auth_hex_decode(token, payload, sizeof(payload));
+
+    start = rt_tick_get();
+    for (i = 0; i < AUTH_BENCH_LOOPS; i++) {
+        sha256_ctx_t ctx;
+
+        hmac_pad_state(&ctx, auth.key, 0x36);
+        sha256_update(&ctx, payload, sizeof(payload));
+        sha256_final(&ctx, mac);
+        hmac_pad_state(&ctx, auth.key, 0x5c);
+        sha256_update(&ctx, mac, sizeof(mac));
+        sha256_final(&ctx, mac);
+    }
+    full_ticks = rt_tick_get() - start;
+
+    start = rt_tick_get();
+    for (i = 0; i < AUTH_BENCH_LOOPS; i++) {
+        ok += auth_verify(token) == RT_EOK;
+    }
+    cached_ticks = rt_tick_get() - start;
+
+    rt_kprintf("auth_bench: %d loops, %d verified\n", AUTH_BENCH_LOOPS, ok);
+    rt_kprintf("  full hmac   : %d us/op\n",
+               full_ticks * (1000000 / RT_TICK_PER_SECOND) / AUTH_BENCH_LOOPS);
+    rt_kprintf("  cached key  : %d us/op (incl. hex decode and compare)\n",
+               cached_ticks * (1000000 / RT_TICK_PER_SECOND) / AUTH_BENCH_LOOPS);
+}
+MSH_CMD_EXPORT(auth_bench, benchmark http token verification);
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_HTTP_AUTH_H_
+#define APPLICATIONS_HTTP_AUTH_H_
+
+#include <rtthread.h>
+#include "http_server.h"
+
+#define AUTH_KEY_SIZE             32
+#define AUTH_PAYLOAD_SIZE         12      /* epoch + 会话号 + 过期时间 */
+#define AUTH_TAG_SIZE             16      /* 截断的HMAC-SHA256 */
+#define AUTH_TOKEN_LEN            ((AUTH_PAYLOAD_SIZE + AUTH_TAG_SIZE) * 2)
+#define AUTH_TOKEN_TTL            (12 * 3600)     /* 令牌有效期，秒 */
+#define AUTH_LOGIN_DELAY_MS       500     /* 密码错误后同一客户端的冷却时间，期间登录直接拒绝 */
+#define AUTH_LOCKOUT_SLOTS        4       /* 同时记录冷却中的客户端数 */
+#define AUTH_DEFAULT_PASSWORD     "12345678"      /* 未设置auth_pass时的初始密码 */
+
+struct http_auth_stats
+{
+    rt_uint32_t logins;
+    rt_uint32_t login_failures;
+    rt_uint32_t verified;
+    rt_uint32_t rejected;
+};
+
+extern struct http_auth_stats http_auth_stats;
+
+// 校验请求携带的令牌（Authorization: Bearer 或 Cookie: token=）
+rt_err_t http_auth_check(http_request_t *req);
+// 吊销全部已签发的令牌，返回新的epoch
+rt_uint32_t http_auth_revoke(void);
+
+#endif /* APPLICATIONS_HTTP_AUTH_H_ */
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include <string.h>
+#include <time.h>
+#include "board.h"
+#include "http_cache.h"
+#include "metrics.h"
+
+typedef struct http_cache_slot_
+{
+    rt_bool_t valid;
+    rt_uint32_t hash;
+    rt_uint32_t version;
+    rt_uint32_t used;               /* LRU时间戳 */
+    rt_size_t len;
+    char key[HTTP_CACHE_KEY_SIZE];
+    char body[HTTP_CACHE_BODY_SIZE];
+} http_cache_slot_t;
+
+typedef struct http_cache_sink_
+{
+    char *buf;
+    rt_size_t len;
+} http_cache_sink_t;
+
+struct http_cache_stats http_cache_stats;
+
+METRIC_EXPORT(cache_hit, "http_cache_requests_total", "result=\"hit\"", METRIC_COUNTER,
+              "Cached API responses by outcome", &http_cache_stats.hits);
+METRIC_EXPORT(cache_miss, "http_cache_requests_total", "result=\"miss\"", METRIC_COUNTER,
+              "Cached API responses by outcome", &http_cache_stats.misses);
+METRIC_EXPORT(cache_304, "http_cache_requests_total", "result=\"not_modified\"", METRIC_COUNTER,
+              "Cached API responses by outcome", &http_cache_stats.not_modified);
+METRIC_EXPORT(cache_bypass, "http_cache_requests_total", "result=\"bypass\"", METRIC_COUNTER,
+              "Cached API responses by outcome", &http_cache_stats.bypass);
+
+static http_cache_slot_t http_cache[HTTP_CACHE_SLOTS];
+static rt_uint32_t http_cache_clock;
+static rt_uint32_t http_cache_nonce;
+static rt_mutex_t http_cache_lock;
+
+static rt_uint32_t http_cache_hash(const char *s)
+{
+    rt_uint32_t h = 2166136261u;
+
+    while (*s) {
+        h = (h ^ (rt_uint8_t)*s++) * 16777619u;
+    }
+    return h;
+}
+
+/*
+ * 每次启动不同的随机数，混进ETag。数据版本号在重启后从0重新计数，
+ * 不带它时客户端手里重启前的ETag可能对上内容不同的新版本而得到304。
+ * 在第一个请求时生成，把请求到来的时刻也混进去。
+ */
+static rt_uint32_t http_cache_boot_nonce(void)
+{
+    char seed[48];
+
+    rt_mutex_take(http_cache_lock, RT_WAITING_FOREVER);
+    while (http_cache_nonce == 0) {
+        rt_snprintf(seed, sizeof(seed), "%x-%x-%x-%x", (unsigned int)time(RT_NULL),
+                    (unsigned int)rt_tick_get(), (unsigned int)SysTick->VAL, (unsigned int)DWT->CYCCNT);
+        http_cache_nonce = http_cache_hash(seed);
+    }
+    rt_mutex_release(http_cache_lock);
+
+    return http_cache_nonce;
+}
+
+static rt_err_t http_cache_sink(void *ctx, const char *buf, rt_size_t len)
+{
+    http_cache_sink_t *sink = ctx;
+
+    if (sink->len + len > HTTP_CACHE_BODY_SIZE) {
+        return -RT_EFULL;
+    }
+    rt_memcpy(sink->buf + sink->len, buf, len);
+    sink->len += len;
+    return RT_EOK;
+}
+
+//内容超出缓存上限时按原来的方式分块流式发送
+static void http_cache_stream(http_request_t *req, http_cache_build_t build)
+{
+    char chunk[HTTP_CHUNK_SIZE];
+    json_writer_t w;
+
+    if (http_send_header(req->sock, 200, "application/json", -1) != RT_EOK) {
+        return;
+    }
+    json_writer_init(&w, chunk, sizeof(chunk), http_chunk_flush, &req->sock);
+    build(req, &w);
+    if (json_writer_finish(&w) == RT_EOK) {
+        http_chunk_end(req->sock);
+    }
+}
+
+static http_cache_slot_t *http_cache_find(const char *key, rt_uint32_t hash)
+{
+    int i;
+
+    for (i = 0; i < HTTP_CACHE_SLOTS; i++) {
+        http_cache_slot_t *s = &http_cache[i];
+
+        if (s->valid && s->hash == hash && rt_strcmp(s->key, key) == 0) {
+            return s;
+        }
+    }
+    return RT_NULL;
+}
+
+//取已有条目，没有则换出空闲或最久未用的条目
+static http_cache_slot_t *http_cache_claim(const char *key, rt_uint32_t hash)
+{
+    http_cache_slot_t *victim = http_cache_find(key, hash);
+    int i;
+
+    if (victim != RT_NULL) {
+        return victim;
+    }
+    victim = &http_cache[0];
+    for (i = 1; i < HTTP_CACHE_SLOTS && victim->valid; i++) {
+        if (!http_cache[i].valid || http_cache[i].used < victim->used) {
+            victim = &http_cache[i];
+        }
+    }
+    rt_strncpy(victim->key, key, sizeof(victim->key));
+    victim->hash = hash;
+    return victim;
+}
+
+void http_cache_send(http_request_t *req, rt_uint32_t version, http_cache_build_t build)
+{
+    char key[HTTP_CACHE_KEY_SIZE];
+    char body[HTTP_CACHE_BODY_SIZE];
+    char etag[32];
+    char extra[80];
+    char value[64];
+    http_cache_slot_t *slot;
+    rt_uint32_t hash;
+    rt_size_t len = 0;
+
+    if (rt_snprintf(key, sizeof(key), "%s?%s", req->path, req->query ? req->query : "")
+        >= (int)sizeof(key)) {
+        http_cache_stats.bypass++;
+        http_cache_stream(req, build);
+        return;
+    }
+    hash = http_cache_hash(key);
+
+    //ETag只由启动随机数、键和版本决定，客户端已有最新内容时不碰缓存
+    rt_snprintf(etag, sizeof(etag), "\"%08x-%08x-%x\"", (unsigned int)http_cache_boot_nonce(),
+                (unsigned int)hash, (unsigned int)version);
+    if (http_header_get(req, "If-None-Match", value, sizeof(value)) == RT_EOK &&
+        strstr(value, etag) != RT_NULL) {
+        http_cache_stats.not_modified++;
+        rt_snprintf(extra, sizeof(extra), "ETag: %s\r\n", etag);
+        http_send_header_extra(req->sock, 304, RT_NULL, 0, extra);
+        return;
+    }
+
+    //命中时只拷贝出预生成的内容，发送在锁外进行
+    rt_mutex_take(http_cache_lock, RT_WAITING_FOREVER);
+    slot = http_cache_find(key, hash);
+    if (slot != RT_NULL && slot->version == version) {
+        len = slot->len;
+        rt_memcpy(body, slot->body, len);
+        slot->used = ++http_cache_clock;
+        http_cache_stats.hits++;
+    }
+    rt_mutex_release(http_cache_lock);
+
+    if (len == 0) {
+        http_cache_sink_t sink = {body, 0};
+        char chunk[64];
+        json_writer_t w;
+
+        json_writer_init(&w, chunk, sizeof(chunk), http_cache_sink, &sink);
+        build(req, &w);
+        if (json_writer_finish(&w) != RT_EOK) {
+            http_cache_stats.bypass++;
+            http_cache_stream(req, build);
+            return;
+        }
+        len = sink.len;
+        http_cache_stats.misses++;
+
+        rt_mutex_take(http_cache_lock, RT_WAITING_FOREVER);
+        slot = http_cache_claim(key, hash);
+        rt_memcpy(slot->body, body, len);
+        slot->len = len;
+        slot->version = version;
+        slot->used = ++http_cache_clock;
+        slot->valid = RT_TRUE;
+        rt_mutex_release(http_cache_lock);
+    }
+
+    rt_snprintf(extra, sizeof(extra), "ETag: %s\r\nCache-Control: no-cache\r\n", etag);
+    if (http_send_header_extra(req->sock, 200, "application/json", len, extra) == RT_EOK) {
+        http_sock_flush(&req->sock, body, len);
+    }
+}
+
+static int http_cache_init(void)
+{
+    http_cache_lock = rt_mutex_create("http_cache", RT_IPC_FLAG_FIFO);
+    if (http_cache_lock == RT_NULL) {
+        rt_kprintf("create http_cache lock failed\n");
+        return -RT_ENOMEM;
+    }
+    return RT_EOK;
+}
+INIT_COMPONENT_EXPORT(http_cache_init);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void http_cache_info(int argc, char **argv)
+{
+    int i;
+
+    rt_kprintf("hits %d, misses %d, 304 %d, bypass %d\n",
+               http_cache_stats.hits, http_cache_stats.misses,
+               http_cache_stats.not_modified, http_cache_stats.bypass);
+    for (i = 0; i < HTTP_CACHE_SLOTS; i++) {
+        if (http_cache[i].valid) {
+            rt_kprintf("  %-32s v%d %d bytes\n", http_cache[i].key,
+                       http_cache[i].version, http_cache[i].len);
+        }
+    }
+}
+MSH_CMD_EXPORT(http_cache_info, show http response cache entries and hit rate);
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_HTTP_CACHE_H_
+#define APPLICATIONS_HTTP_CACHE_H_
+
+#include <rtthread.h>
+#include "json_writer.h"
+#include "http_server.h"
+
+#define HTTP_CACHE_SLOTS          4       /* 缓存条目数 */
+#define HTTP_CACHE_KEY_SIZE       48      /* 路径+查询串，超长的请求不缓存 */
+#define HTTP_CACHE_BODY_SIZE      256     /* 单条响应上限，超出时直接流式发送 */
+
+// 生成响应内容，由缓存层提供writer，内容超出上限时自动改为不缓存
+typedef void (*http_cache_build_t)(http_request_t *req, json_writer_t *w);
+
+struct http_cache_stats
+{
+    rt_uint32_t hits;
+    rt_uint32_t misses;
+    rt_uint32_t not_modified;       /* If-None-Match命中，回304 */
+    rt_uint32_t bypass;             /* 键或内容超长，未缓存 */
+};
+
+extern struct http_cache_stats http_cache_stats;
+
+/*
+ * 以路径和查询串为键发送JSON响应。
+ * version为数据版本号，数据变化时由调用方递增，与缓存中的版本不一致即重新生成。
+ * 响应带ETag，客户端带匹配的If-None-Match时只回304。
+ */
+void http_cache_send(http_request_t *req, rt_uint32_t version, http_cache_build_t build);
+
+#endif /* APPLICATIONS_HTTP_CACHE_H_ */
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <fal.h>
+#include <easyflash.h>
+#include "json_writer.h"
+#include "http_server.h"
+#include "http_ota.h"
+#include "metrics.h"
+
+struct http_ota_stats http_ota_stats;
+
+METRIC_EXPORT(ota_ok, "ota_uploads_total", "result=\"ok\"", METRIC_COUNTER,
+              "Firmware uploads", &http_ota_stats.uploads);
+METRIC_EXPORT(ota_fail, "ota_uploads_total", "result=\"failed\"", METRIC_COUNTER,
+              "Firmware uploads", &http_ota_stats.failures);
+METRIC_EXPORT(ota_kbps, "ota_last_throughput_kbytes_per_second", RT_NULL, METRIC_GAUGE,
+              "Throughput of the last firmware upload", &http_ota_stats.last_kbps);
+
+static rt_mutex_t ota_lock;
+
+//收满一个擦除块（最后一块可能不满），超时或连接断开返回-RT_ETIMEOUT
+static rt_err_t ota_fill_block(http_request_t *req, rt_uint8_t *block, rt_uint32_t want)
+{
+    rt_uint32_t fill = 0;
+
+    while (fill < want) {
+        int n = http_read_body(req, (char *)block + fill, want - fill);
+
+        if (n <= 0) {
+            return -RT_ETIMEOUT;
+        }
+        fill += n;
+    }
+    return RT_EOK;
+}
+
+static void ota_reply(http_request_t *req, const struct http_ota_stats *st, rt_uint32_t block_size)
+{
+    char buf[HTTP_CHUNK_SIZE];
+    char crc[12];
+    json_writer_t w;
+
+    rt_snprintf(crc, sizeof(crc), "%08x", (unsigned int)st->last_crc32);
+
+    http_send_header(req->sock, 200, "application/json", -1);
+    json_writer_init(&w, buf, sizeof(buf), http_chunk_flush, &req->sock);
+    json_object_begin(&w);
+    json_key(&w, "size");
+    json_int(&w, st->last_size);
+    json_key(&w, "crc32");
+    json_string(&w, crc);
+    json_key(&w, "ms");
+    json_int(&w, st->last_ms);
+    json_key(&w, "kbps");
+    json_int(&w, st->last_kbps);
+    json_key(&w, "block");
+    json_int(&w, block_size);
+    json_key(&w, "peak_ram");
+    json_int(&w, st->peak_ram);
+    json_key(&w, "heap_max");
+    json_int(&w, st->heap_max);
+    json_object_end(&w);
+    if (json_writer_finish(&w) == RT_EOK) {
+        http_chunk_end(req->sock);
+    }
+}
+
+/*
+ * POST /api/ota，需登录，body为固件镜像，必须带Content-Length。
+ * 可选头部X-Image-CRC32（十六进制），与写入数据的CRC32不一致时不标记镜像有效。
+ * 镜像按擦除块边收边擦边写，RAM中只保留一个块。
+ * 成功后在EasyFlash环境变量中写入ota_size/ota_crc32，供bootloader搬运。
+ */
+static void ota_handler(http_request_t *req)
+{
+    const struct fal_partition *part;
+    const struct fal_flash_dev *flash;
+    struct http_ota_stats st;
+    struct timeval tv;
+    rt_uint32_t total, used, max_used;
+    rt_uint32_t blk_size, offset = 0, crc = 0, expect = 0;
+    rt_bool_t has_expect;
+    rt_uint8_t *block;
+    rt_tick_t start;
+    rt_err_t result = RT_EOK;
+    char value[16];
+
+    part = fal_partition_find(HTTP_OTA_PART_NAME);
+    flash = part ? fal_flash_device_find(part->flash_name) : RT_NULL;
+    if (flash == RT_NULL) {
+        http_send_simple(req->sock, 500, "no download partition");
+        return;
+    }
+    if (req->content_length <= 0) {
+        http_send_simple(req->sock, 411, "Length Required");
+        return;
+    }
+    if (req->content_length > (rt_int32_t)part->len) {
+        http_send_simple(req->sock, 413, "image too large");
+        return;
+    }
+    has_expect = http_header_get(req, "X-Image-CRC32", value, sizeof(value)) == RT_EOK;
+    if (has_expect) {
+        expect = strtoul(value, RT_NULL, 16);
+    }
+
+    //同一时间只允许一个上传，后来的直接拒绝而不是排队等待
+    if (rt_mutex_take(ota_lock, 0) != RT_EOK) {
+        http_send_simple(req->sock, 409, "upload in progress");
+        return;
+    }
+
+    blk_size = flash->blk_size;
+    block = rt_malloc(blk_size);
+    if (block == RT_NULL) {
+        rt_mutex_release(ota_lock);
+        http_send_simple(req->sock, 503, "Busy");
+        return;
+    }
+
+    //旧的有效标记先作废，上传中途失败时分区内容不会被当作镜像
+    ef_del_env("ota_size");
+
+    tv.tv_sec = HTTP_OTA_RECV_TIMEOUT / 1000;
+    tv.tv_usec = (HTTP_OTA_RECV_TIMEOUT % 1000) * 1000;
+    setsockopt(req->sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    start = rt_tick_get();
+    while (offset < (rt_uint32_t)req->content_length) {
+        rt_uint32_t want = req->content_length - offset;
+
+        if (want > blk_size) {
+            want = blk_size;
+        }
+        result = ota_fill_block(req, block, want);
+        if (result != RT_EOK) {
+            break;
+        }
+        //每次只擦写当前这一块，擦除地址和长度始终按块对齐
+        if (fal_partition_erase(part, offset, blk_size) < 0 ||
+            fal_partition_write(part, offset, block, want) < 0) {
+            result = -RT_EIO;
+            break;
+        }
+        crc = ef_calc_crc32(crc, block, want);
+        offset += want;
+    }
+
+    rt_free(block);
+    rt_memory_info(&total, &used, &max_used);
+
+    st = http_ota_stats;
+    st.last_size = offset;
+    st.last_crc32 = crc;
+    st.last_ms = (rt_tick_get() - start) * 1000 / RT_TICK_PER_SECOND;
+    //分区不超过4MB，offset * 1000不会溢出
+    st.last_kbps = st.last_ms ? offset * 1000 / st.last_ms / 1024 : 0;
+    st.peak_ram = blk_size;
+    st.heap_max = max_used;
+    if (result == RT_EOK && has_expect && crc != expect) {
+        result = -RT_ERROR;
+    }
+    if (result == RT_EOK) {
+        rt_snprintf(value, sizeof(value), "%08x", (unsigned int)crc);
+        ef_set_env("ota_crc32", value);
+        rt_snprintf(value, sizeof(value), "%u", (unsigned int)offset);
+        ef_set_env("ota_size", value);
+        st.uploads++;
+    } else {
+        st.failures++;
+    }
+    http_ota_stats = st;
+    rt_mutex_release(ota_lock);
+
+    rt_kprintf("ota: %d/%d bytes crc %08x in %d ms, %d KB/s, buf %d, heap max %d, %s\n",
+               offset, req->content_length, crc, st.last_ms, st.last_kbps,
+               st.peak_ram, st.heap_max, result == RT_EOK ? "ok" : "failed");
+
+    switch (result) {
+    case RT_EOK:
+        ota_reply(req, &st, blk_size);
+        break;
+    case -RT_ETIMEOUT:
+        http_send_simple(req->sock, 408, "upload timeout");
+        break;
+    case -RT_ERROR:
+        http_send_simple(req->sock, 400, "crc mismatch");
+        break;
+    default:
+        http_send_simple(req->sock, 500, "flash write failed");
+        break;
+    }
+}
+HTTP_ROUTE_EXPORT(ota, HTTP_POST, "/api/ota", ota_handler, HTTP_ROUTE_SLOW | HTTP_ROUTE_AUTH);
+
+static int http_ota_init(void)
+{
+    ota_lock = rt_mutex_create("http_ota", RT_IPC_FLAG_FIFO);
+    if (ota_lock == RT_NULL) {
+        rt_kprintf("create http_ota lock failed\n");
+        return -RT_ENOMEM;
+    }
+    return RT_EOK;
+}
+INIT_COMPONENT_EXPORT(http_ota_init);
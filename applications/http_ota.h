@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_HTTP_OTA_H_
+#define APPLICATIONS_HTTP_OTA_H_
+
+#include <rtthread.h>
+
+#define HTTP_OTA_PART_NAME        "download"  /* fal分区表中的下载分区 */
+#define HTTP_OTA_RECV_TIMEOUT     5000        /* 客户端停止发送多久后放弃，ms */
+
+// 最近一次上传的结果，供调试和监控读取
+struct http_ota_stats
+{
+    rt_uint32_t uploads;
+    rt_uint32_t failures;
+    rt_uint32_t last_size;
+    rt_uint32_t last_crc32;
+    rt_uint32_t last_ms;
+    rt_uint32_t last_kbps;          /* KB/s */
+    rt_uint32_t peak_ram;           /* 上传期间占用的缓冲，字节 */
+    rt_uint32_t heap_max;           /* 上传结束时系统堆的历史峰值 */
+};
+
+extern struct http_ota_stats http_ota_stats;
+
+#endif /* APPLICATIONS_HTTP_OTA_H_ */
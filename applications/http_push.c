@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include <sys/socket.h>
+#include "http_push.h"
+
+static const char push_header[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/event-stream\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Connection: keep-alive\r\n\r\n"
+    "retry: 3000\n\n";
+
+static const char push_ping[] = ": ping\n\n";
+
+static int push_clients[HTTP_PUSH_MAX_CLIENTS];
+static rt_mutex_t push_lock;
+static rt_int32_t push_last[SENSOR_CHANNEL_MAX];
+static rt_tick_t push_last_send;
+static char push_chunk[HTTP_PUSH_EVENT_SIZE];
+
+//非阻塞发送，慢客户端或断开的连接直接踢掉，不拖累控制线程
+static rt_bool_t push_send(int sock, const char *buf, int len)
+{
+    return send(sock, buf, len, MSG_DONTWAIT) == len;
+}
+
+static void push_drop(int index)
+{
+    rt_kprintf("SSE订阅者断开: slot %d\n", index);
+    closesocket(push_clients[index]);
+    push_clients[index] = -1;
+}
+
+//编码器输出回调：ctx为空时广播给全部订阅者，否则只发给指定socket
+static rt_err_t push_flush(void *ctx, const char *buf, rt_size_t len)
+{
+    int i;
+
+    if (ctx) {
+        return push_send(*(int *)ctx, buf, len) ? RT_EOK : -RT_EIO;
+    }
+    for (i = 0; i < HTTP_PUSH_MAX_CLIENTS; i++) {
+        if (push_clients[i] >= 0 && !push_send(push_clients[i], buf, len)) {
+            push_drop(i);
+        }
+    }
+    return RT_EOK;
+}
+
+//按输出精度取当前值，publish比较增量和新订阅者的快照都用这份
+static rt_int32_t push_sample(rt_size_t ch)
+{
+    return json_float_to_fixed(*g_sensor_channels[ch].value, g_sensor_channels[ch].decimals);
+}
+
+//输出一条SSE事件，mask中置位的通道才会编码
+static rt_err_t push_encode(void *ctx, const rt_int32_t *values, rt_uint32_t mask)
+{
+    json_writer_t w;
+    rt_size_t i;
+
+    json_writer_init(&w, push_chunk, sizeof(push_chunk), push_flush, ctx);
+    json_raw(&w, "data: ", 6);
+    w.need_comma = 0;       /* SSE前缀不参与JSON的逗号计数 */
+    json_object_begin(&w);
+    for (i = 0; i < g_sensor_channel_num; i++) {
+        if (mask & (1UL << i)) {
+            json_key(&w, g_sensor_channels[i].key);
+            json_fixed(&w, values[i], g_sensor_channels[i].decimals);
+        }
+    }
+    json_object_end(&w);
+    json_raw(&w, "\n\n", 2);
+
+    return json_writer_finish(&w);
+}
+
+rt_err_t http_push_attach(int sock)
+{
+    rt_int32_t values[SENSOR_CHANNEL_MAX];
+    rt_size_t ch;
+    int i;
+
+    rt_mutex_take(push_lock, RT_WAITING_FOREVER);
+    for (i = 0; i < HTTP_PUSH_MAX_CLIENTS; i++) {
+        if (push_clients[i] < 0) {
+            break;
+        }
+    }
+    if (i == HTTP_PUSH_MAX_CLIENTS) {
+        rt_mutex_release(push_lock);
+        return -RT_EFULL;
+    }
+
+    //新订阅者先收到一份全量快照，之后只收增量。快照直接取sensor_data，
+    //push_last在第一次publish之前全是0，而且只能由publish更新，否则别的订阅者会漏掉这次增量
+    for (ch = 0; ch < g_sensor_channel_num; ch++) {
+        values[ch] = push_sample(ch);
+    }
+    if (!push_send(sock, push_header, sizeof(push_header) - 1) ||
+        push_encode(&sock, values, (1UL << g_sensor_channel_num) - 1) != RT_EOK) {
+        rt_mutex_release(push_lock);
+        closesocket(sock);
+        return RT_EOK;
+    }
+    push_clients[i] = sock;
+    rt_mutex_release(push_lock);
+
+    rt_kprintf("SSE订阅者接入: slot %d\n", i);
+    return RT_EOK;
+}
+
+void http_push_publish(void)
+{
+    rt_uint32_t mask = 0;
+    rt_size_t i;
+
+    rt_mutex_take(push_lock, RT_WAITING_FOREVER);
+
+    //按输出精度比较，避免浮点抖动产生无意义的增量
+    for (i = 0; i < g_sensor_channel_num; i++) {
+        rt_int32_t value = push_sample(i);
+
+        if (value != push_last[i]) {
+            push_last[i] = value;
+            mask |= 1UL << i;
+        }
+    }
+
+    if (mask) {
+        //一次编码，扇出到全部订阅者
+        push_encode(RT_NULL, push_last, mask);
+        push_last_send = rt_tick_get();
+    } else if (rt_tick_get() - push_last_send >= rt_tick_from_millisecond(HTTP_PUSH_KEEPALIVE_MS)) {
+        push_flush(RT_NULL, push_ping, sizeof(push_ping) - 1);
+        push_last_send = rt_tick_get();
+    }
+
+    rt_mutex_release(push_lock);
+}
+
+static int http_push_init(void)
+{
+    int i;
+
+    RT_ASSERT(g_sensor_channel_num <= SENSOR_CHANNEL_MAX);
+
+    for (i = 0; i < HTTP_PUSH_MAX_CLIENTS; i++) {
+        push_clients[i] = -1;
+    }
+
+    push_lock = rt_mutex_create("push_lock", RT_IPC_FLAG_FIFO);
+    if (push_lock == RT_NULL) {
+        rt_kprintf("create push_lock failed\n");
+        return -RT_ERROR;
+    }
+    return RT_EOK;
+}
+INIT_COMPONENT_EXPORT(http_push_init);
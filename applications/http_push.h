@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_HTTP_PUSH_H_
+#define APPLICATIONS_HTTP_PUSH_H_
+
+#include <rtthread.h>
+#include "control.h"
+
+#define HTTP_PUSH_MAX_CLIENTS     4       /* 同时在线的SSE订阅者上限 */
+#define HTTP_PUSH_EVENT_SIZE      128     /* 事件编码分块缓冲 */
+#define HTTP_PUSH_KEEPALIVE_MS    15000   /* 无数据变化时的心跳间隔 */
+
+// 接管一个已accept的连接作为SSE订阅者，成功后由本模块负责关闭socket
+rt_err_t http_push_attach(int sock);
+
+// 传感器数据更新后调用：仅编码变化的通道，一次编码广播给所有订阅者
+void http_push_publish(void);
+
+#endif /* APPLICATIONS_HTTP_PUSH_H_ */
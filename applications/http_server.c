@@ -0,0 +1,806 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include <rthw.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <sys/time.h>
+#include "board.h"
+#include "http_server.h"
+#include "http_auth.h"
+#include "metrics.h"
+
+//路由前缀树节点，按'/'分段，":name"段为参数节点
+struct http_trie_node
+{
+    const char *seg;
+    rt_uint8_t len;
+    rt_int8_t child;
+    rt_int8_t next;
+    const struct http_route *route;
+    const struct http_route *wildcard;  /* 本节点之后的任意剩余路径 */
+};
+
+#if defined(__ARMCC_VERSION)
+extern const int HttpRouteTab$$Base;
+extern const int HttpRouteTab$$Limit;
+#define HTTP_ROUTE_BEGIN    ((const struct http_route *)&HttpRouteTab$$Base)
+#define HTTP_ROUTE_END      ((const struct http_route *)&HttpRouteTab$$Limit)
+#elif defined(__GNUC__)
+extern const int __http_route_start;
+extern const int __http_route_end;
+#define HTTP_ROUTE_BEGIN    ((const struct http_route *)&__http_route_start)
+#define HTTP_ROUTE_END      ((const struct http_route *)&__http_route_end)
+#endif
+
+//一个请求从接收到处理完毕所占用的全部内存，包括接收缓冲
+typedef struct http_job_
+{
+    http_request_t req;
+    const struct http_route *route;
+    rt_tick_t enqueued;
+    char buf[HTTP_RECV_BUF_SIZE + 1];
+} http_job_t;
+
+#define HTTP_JOB_NUM    (2 * HTTP_QUEUE_LEN + HTTP_FAST_WORKERS + HTTP_SLOW_WORKERS + 1)
+
+struct http_stage_stats http_stage_stats[HTTP_STAGE_NUM];
+struct http_server_stats http_server_stats;
+
+METRIC_EXPORT(http_req, "http_requests_total", RT_NULL, METRIC_COUNTER,
+              "Accepted HTTP connections", &http_server_stats.requests);
+METRIC_EXPORT(http_bytes, "http_sent_bytes_total", RT_NULL, METRIC_COUNTER,
+              "Bytes sent on HTTP connections, excluding SSE", &http_server_stats.bytes_sent);
+METRIC_EXPORT(http_err4, "http_errors_total", "class=\"4xx\"", METRIC_COUNTER,
+              "HTTP error responses", &http_server_stats.client_errors);
+METRIC_EXPORT(http_err5, "http_errors_total", "class=\"5xx\"", METRIC_COUNTER,
+              "HTTP error responses", &http_server_stats.server_errors);
+METRIC_EXPORT(http_depth_f, "http_queue_depth", "stage=\"fast\"", METRIC_GAUGE,
+              "Requests waiting in a worker queue", &http_stage_stats[HTTP_STAGE_FAST].depth);
+METRIC_EXPORT(http_depth_s, "http_queue_depth", "stage=\"slow\"", METRIC_GAUGE,
+              "Requests waiting in a worker queue", &http_stage_stats[HTTP_STAGE_SLOW].depth);
+METRIC_EXPORT(http_rej_f, "http_rejected_total", "stage=\"fast\"", METRIC_COUNTER,
+              "Requests refused with 503 because the queue was full", &http_stage_stats[HTTP_STAGE_FAST].rejected);
+METRIC_EXPORT(http_rej_s, "http_rejected_total", "stage=\"slow\"", METRIC_COUNTER,
+              "Requests refused with 503 because the queue was full", &http_stage_stats[HTTP_STAGE_SLOW].rejected);
+METRIC_EXPORT(http_jobs_io, "http_stage_jobs_total", "stage=\"io\"", METRIC_COUNTER,
+              "Requests handled by each stage", &http_stage_stats[HTTP_STAGE_IO].jobs);
+METRIC_EXPORT(http_jobs_f, "http_stage_jobs_total", "stage=\"fast\"", METRIC_COUNTER,
+              "Requests handled by each stage", &http_stage_stats[HTTP_STAGE_FAST].jobs);
+METRIC_EXPORT(http_jobs_s, "http_stage_jobs_total", "stage=\"slow\"", METRIC_COUNTER,
+              "Requests handled by each stage", &http_stage_stats[HTTP_STAGE_SLOW].jobs);
+METRIC_EXPORT(http_wait_f, "http_stage_wait_seconds_total", "stage=\"fast\"", METRIC_COUNTER | METRIC_TICKS,
+              "Time requests spent queued", &http_stage_stats[HTTP_STAGE_FAST].wait_total);
+METRIC_EXPORT(http_wait_s, "http_stage_wait_seconds_total", "stage=\"slow\"", METRIC_COUNTER | METRIC_TICKS,
+              "Time requests spent queued", &http_stage_stats[HTTP_STAGE_SLOW].wait_total);
+METRIC_EXPORT(http_svc_io, "http_stage_service_seconds_total", "stage=\"io\"", METRIC_COUNTER | METRIC_TICKS,
+              "Time spent serving requests in each stage", &http_stage_stats[HTTP_STAGE_IO].service_total);
+METRIC_EXPORT(http_svc_f, "http_stage_service_seconds_total", "stage=\"fast\"", METRIC_COUNTER | METRIC_TICKS,
+              "Time spent serving requests in each stage", &http_stage_stats[HTTP_STAGE_FAST].service_total);
+METRIC_EXPORT(http_svc_s, "http_stage_service_seconds_total", "stage=\"slow\"", METRIC_COUNTER | METRIC_TICKS,
+              "Time spent serving requests in each stage", &http_stage_stats[HTTP_STAGE_SLOW].service_total);
+
+static struct http_trie_node http_trie[HTTP_TRIE_NODES];
+static int http_trie_used;
+static rt_mp_t http_job_pool;
+static struct rt_mempool http_job_mp;
+// 请求缓冲只由CPU解析，lwIP从pbuf拷贝进来，不经DMA，放在零等待的DTCM里
+static rt_uint8_t http_job_mem[HTTP_JOB_NUM * (RT_ALIGN(sizeof(http_job_t), RT_ALIGN_SIZE) +
+                                               sizeof(rt_uint8_t *))] BSP_SECTION_DTCM;
+static rt_mq_t http_queue[2];
+
+static const char *http_reason(int code)
+{
+    switch (code) {
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 206: return "Partial Content";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 408: return "Request Timeout";
+    case 409: return "Conflict";
+    case 411: return "Length Required";
+    case 413: return "Payload Too Large";
+    case 416: return "Range Not Satisfiable";
+    case 429: return "Too Many Requests";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default:  return "Unknown";
+    }
+}
+
+//统计计数被I/O线程和多个工作线程同时累加，读改写要在临界区内完成
+static void http_stat_add(rt_uint32_t *counter, rt_uint32_t n)
+{
+    rt_base_t level = rt_hw_interrupt_disable();
+    *counter += n;
+    rt_hw_interrupt_enable(level);
+}
+
+static rt_err_t http_send_all(int sock, const char *buf, rt_size_t len)
+{
+    while (len > 0) {
+        int sent = send(sock, buf, len, 0);
+        if (sent <= 0) {
+            return -RT_EIO;
+        }
+        http_stat_add(&http_server_stats.bytes_sent, sent);
+        buf += sent;
+        len -= sent;
+    }
+    return RT_EOK;
+}
+
+rt_err_t http_sock_flush(void *ctx, const char *buf, rt_size_t len)
+{
+    return http_send_all(*(int *)ctx, buf, len);
+}
+
+rt_err_t http_chunk_flush(void *ctx, const char *buf, rt_size_t len)
+{
+    int sock = *(int *)ctx;
+    char size_line[12];
+    int n;
+
+    if (len == 0) {
+        return RT_EOK;
+    }
+    n = rt_snprintf(size_line, sizeof(size_line), "%x\r\n", (unsigned int)len);
+    if (http_send_all(sock, size_line, n) != RT_EOK ||
+        http_send_all(sock, buf, len) != RT_EOK) {
+        return -RT_EIO;
+    }
+    return http_send_all(sock, "\r\n", 2);
+}
+
+rt_err_t http_chunk_end(int sock)
+{
+    return http_send_all(sock, "0\r\n\r\n", 5);
+}
+
+rt_err_t http_send_header(int sock, int code, const char *content_type, int length)
+{
+    return http_send_header_extra(sock, code, content_type, length, RT_NULL);
+}
+
+rt_err_t http_send_header_extra(int sock, int code, const char *content_type,
+                                int length, const char *extra)
+{
+    char header[256];
+    int n;
+
+    if (code >= 500) {
+        http_stat_add(&http_server_stats.server_errors, 1);
+    } else if (code >= 400) {
+        http_stat_add(&http_server_stats.client_errors, 1);
+    }
+    n = rt_snprintf(header, sizeof(header), "HTTP/1.1 %d %s\r\n", code, http_reason(code));
+    if (content_type) {
+        n += rt_snprintf(header + n, sizeof(header) - n, "Content-Type: %s\r\n", content_type);
+    }
+    if (length >= 0) {
+        n += rt_snprintf(header + n, sizeof(header) - n, "Content-Length: %d\r\n", length);
+    } else {
+        n += rt_snprintf(header + n, sizeof(header) - n, "Transfer-Encoding: chunked\r\n");
+    }
+    if (extra) {
+        n += rt_snprintf(header + n, sizeof(header) - n, "%s", extra);
+    }
+    n += rt_snprintf(header + n, sizeof(header) - n, "Connection: close\r\n\r\n");
+    if (n >= (int)sizeof(header)) {
+        return -RT_EFULL;
+    }
+
+    return http_send_all(sock, header, n);
+}
+
+void http_send_simple(int sock, int code, const char *body)
+{
+    int len = rt_strlen(body);
+
+    if (http_send_header(sock, code, "text/plain", len) == RT_EOK) {
+        http_send_all(sock, body, len);
+    }
+}
+
+rt_err_t http_query_get(const char *query, const char *key, char *buf, rt_size_t size)
+{
+    rt_size_t key_len = rt_strlen(key);
+    const char *p = query;
+
+    while (p && *p) {
+        const char *end = strchr(p, '&');
+
+        if (rt_strncmp(p, key, key_len) == 0 && p[key_len] == '=') {
+            rt_size_t len;
+
+            p += key_len + 1;
+            len = end ? (rt_size_t)(end - p) : rt_strlen(p);
+            if (len >= size) {
+                len = size - 1;
+            }
+            rt_memcpy(buf, p, len);
+            buf[len] = '\0';
+            return RT_EOK;
+        }
+        p = end ? end + 1 : RT_NULL;
+    }
+    return -RT_EEMPTY;
+}
+
+rt_err_t http_query_int(const char *query, const char *key, rt_int32_t *value)
+{
+    char buf[12];
+
+    if (http_query_get(query, key, buf, sizeof(buf)) != RT_EOK) {
+        return -RT_EEMPTY;
+    }
+    *value = atoi(buf);
+    return RT_EOK;
+}
+
+static int http_strncasecmp(const char *a, const char *b, rt_size_t n)
+{
+    while (n--) {
+        char ca = *a++, cb = *b++;
+
+        if (ca >= 'A' && ca <= 'Z') ca += 'a' - 'A';
+        if (cb >= 'A' && cb <= 'Z') cb += 'a' - 'A';
+        if (ca != cb) {
+            return ca - cb;
+        }
+        if (ca == '\0') {
+            break;
+        }
+    }
+    return 0;
+}
+
+rt_err_t http_header_get(const http_request_t *req, const char *name, char *buf, rt_size_t size)
+{
+    rt_size_t name_len = rt_strlen(name);
+    const char *p = req->headers;
+
+    while (p && *p) {
+        const char *end = strstr(p, "\r\n");
+
+        if (http_strncasecmp(p, name, name_len) == 0 && p[name_len] == ':') {
+            rt_size_t len;
+
+            p += name_len + 1;
+            while (*p == ' ') {
+                p++;
+            }
+            len = end ? (rt_size_t)(end - p) : rt_strlen(p);
+            if (len >= size) {
+                len = size - 1;
+            }
+            rt_memcpy(buf, p, len);
+            buf[len] = '\0';
+            return RT_EOK;
+        }
+        p = end ? end + 2 : RT_NULL;
+    }
+    return -RT_EEMPTY;
+}
+
+int http_read_body(http_request_t *req, char *buf, rt_size_t size)
+{
+    //先取出随头部一起收到的部分，再从socket读
+    if (req->body_len > 0) {
+        rt_size_t n = req->body_len < size ? req->body_len : size;
+
+        rt_memcpy(buf, req->body, n);
+        req->body += n;
+        req->body_len -= n;
+        return n;
+    }
+    return recv(req->sock, buf, size, 0);
+}
+
+static rt_size_t http_seg_len(const char *p)
+{
+    rt_size_t len = 0;
+
+    while (p[len] && p[len] != '/') {
+        len++;
+    }
+    return len;
+}
+
+static int http_trie_child(int node, const char *seg, rt_size_t len, rt_bool_t param)
+{
+    int i;
+
+    for (i = http_trie[node].child; i >= 0; i = http_trie[i].next) {
+        if (param) {
+            if (http_trie[i].seg[0] == ':') {
+                return i;
+            }
+        } else if (http_trie[i].len == len && rt_strncmp(http_trie[i].seg, seg, len) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static rt_err_t http_trie_insert(const struct http_route *route)
+{
+    const char *p = route->pattern;
+    int node = 0;
+
+    while (1) {
+        rt_size_t len;
+        int child;
+
+        while (*p == '/') {
+            p++;
+        }
+        if (*p == '\0') {
+            break;
+        }
+        if (*p == '*') {
+            http_trie[node].wildcard = route;
+            return RT_EOK;
+        }
+
+        len = http_seg_len(p);
+        child = http_trie_child(node, p, len, *p == ':');
+        if (child < 0) {
+            if (http_trie_used >= HTTP_TRIE_NODES) {
+                return -RT_EFULL;
+            }
+            child = http_trie_used++;
+            http_trie[child].seg = p;
+            http_trie[child].len = len;
+            http_trie[child].child = -1;
+            http_trie[child].next = http_trie[node].child;
+            http_trie[node].child = child;
+        }
+        node = child;
+        p += len;
+    }
+
+    if (http_trie[node].route) {
+        return -RT_EBUSY;
+    }
+    http_trie[node].route = route;
+    return RT_EOK;
+}
+
+static void http_param_push(http_request_t *req, const char *value, rt_size_t len)
+{
+    char *dst = req->param_buf;
+    rt_size_t used = 0;
+
+    if (req->param_num > 0) {
+        const char *last = req->params[req->param_num - 1];
+        used = last - req->param_buf + rt_strlen(last) + 1;
+    }
+    if (req->param_num >= HTTP_PARAM_MAX || used + len + 1 > sizeof(req->param_buf)) {
+        return;
+    }
+    dst += used;
+    rt_memcpy(dst, value, len);
+    dst[len] = '\0';
+    req->params[req->param_num++] = dst;
+}
+
+//逐段匹配，耗时只与路径长度有关；静态段优先于参数段，不回溯
+static const struct http_route *http_route_lookup(http_request_t *req)
+{
+    const struct http_route *wildcard = RT_NULL;
+    const char *wild_rest = RT_NULL;
+    rt_uint8_t wild_params = 0;
+    const char *p = req->path;
+    int node = 0;
+
+    req->param_num = 0;
+    while (1) {
+        rt_size_t len;
+        int child;
+
+        while (*p == '/') {
+            p++;
+        }
+        if (http_trie[node].wildcard) {
+            wildcard = http_trie[node].wildcard;
+            wild_rest = p;
+            wild_params = req->param_num;
+        }
+        if (*p == '\0') {
+            break;
+        }
+
+        len = http_seg_len(p);
+        child = http_trie_child(node, p, len, RT_FALSE);
+        if (child < 0) {
+            child = http_trie_child(node, p, len, RT_TRUE);
+            if (child >= 0) {
+                http_param_push(req, p, len);
+            }
+        }
+        if (child < 0) {
+            node = -1;
+            break;
+        }
+        node = child;
+        p += len;
+    }
+
+    if (node >= 0 && http_trie[node].route) {
+        return http_trie[node].route;
+    }
+    if (wildcard) {
+        req->param_num = wild_params;
+        http_param_push(req, wild_rest, rt_strlen(wild_rest));
+        return wildcard;
+    }
+    return RT_NULL;
+}
+
+static void http_route_build(void)
+{
+    const struct http_route *route;
+
+    http_trie[0].seg = "";
+    http_trie[0].child = -1;
+    http_trie[0].next = -1;
+    http_trie_used = 1;
+
+    for (route = HTTP_ROUTE_BEGIN; route < HTTP_ROUTE_END; route++) {
+        rt_err_t result = http_trie_insert(route);
+
+        if (result != RT_EOK) {
+            rt_kprintf("http route %s ignored: %d\n", route->pattern, result);
+        }
+    }
+    rt_kprintf("http routes: %d, trie nodes: %d/%d\n",
+               HTTP_ROUTE_END - HTTP_ROUTE_BEGIN, http_trie_used, HTTP_TRIE_NODES);
+}
+
+//解析请求行和头部，就地切分接收缓冲
+static rt_err_t http_parse(http_request_t *req, char *buf, int len)
+{
+    char *line_end = strstr(buf, "\r\n");
+    char *head_end = strstr(buf, "\r\n\r\n");
+    char *sp;
+    char value[12];
+
+    if (line_end == RT_NULL) {
+        return -RT_ERROR;
+    }
+    if (head_end) {
+        req->body = head_end + 4;
+        req->body_len = buf + len - req->body;
+        head_end[2] = '\0';
+    }
+    *line_end = '\0';
+    req->headers = line_end + 2;
+
+    sp = strchr(buf, ' ');
+    if (sp == RT_NULL) {
+        return -RT_ERROR;
+    }
+    *sp = '\0';
+    req->path = sp + 1;
+    sp = strchr(req->path, ' ');
+    if (sp) {
+        *sp = '\0';
+    }
+
+    if (rt_strcmp(buf, "GET") == 0) {
+        req->method = HTTP_GET;
+    } else if (rt_strcmp(buf, "POST") == 0) {
+        req->method = HTTP_POST;
+    }
+
+    //分离查询串，路径匹配只比较'?'之前的部分
+    req->query = strchr(req->path, '?');
+    if (req->query) {
+        *req->query++ = '\0';
+    } else {
+        req->query = "";
+    }
+
+    req->content_length = -1;
+    if (http_header_get(req, "Content-Length", value, sizeof(value)) == RT_EOK) {
+        req->content_length = atoi(value);
+    }
+    return RT_EOK;
+}
+
+static void http_stats_done(struct http_stage_stats *st, rt_tick_t wait, rt_tick_t service)
+{
+    rt_base_t level = rt_hw_interrupt_disable();
+
+    st->jobs++;
+    st->wait_total += wait;
+    st->service_total += service;
+    if (wait > st->wait_max) {
+        st->wait_max = wait;
+    }
+    if (service > st->service_max) {
+        st->service_max = service;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+//执行处理函数并记录路由统计，在工作线程中调用
+static void http_run(http_job_t *job)
+{
+    const struct http_route *route = job->route;
+    rt_tick_t start, elapsed;
+    rt_base_t level;
+
+    start = rt_tick_get();
+    route->handler(&job->req);
+    elapsed = rt_tick_get() - start;
+
+    //同一路由可能在两个slow线程上同时执行
+    level = rt_hw_interrupt_disable();
+    route->stats->hits++;
+    route->stats->ticks_total += elapsed;
+    if (elapsed > route->stats->ticks_max) {
+        route->stats->ticks_max = elapsed;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+//工作线程：fast队列只放短小的处理，slow队列放文件、历史等耗时处理，互不阻塞
+static void http_worker_entry(void *parameter)
+{
+    int stage = (int)(rt_ubase_t)parameter;
+    rt_mq_t queue = http_queue[stage - HTTP_STAGE_FAST];
+    struct http_stage_stats *st = &http_stage_stats[stage];
+    http_job_t *job;
+
+    while (1) {
+        rt_tick_t start, wait;
+        rt_base_t level;
+
+        if (rt_mq_recv(queue, &job, sizeof(job), RT_WAITING_FOREVER) != RT_EOK) {
+            continue;
+        }
+        level = rt_hw_interrupt_disable();
+        st->depth--;
+        rt_hw_interrupt_enable(level);
+
+        start = rt_tick_get();
+        wait = start - job->enqueued;
+        http_run(job);
+        http_stats_done(st, wait, rt_tick_get() - start);
+
+        if (!job->req.detached) {
+            closesocket(job->req.sock);
+        }
+        rt_mp_free(job);
+    }
+}
+
+//解析并按路由标志入队，返回RT_EOK表示作业已交给工作线程
+static rt_err_t http_accept_job(http_job_t *job, int sock)
+{
+    http_request_t *req = &job->req;
+    struct http_stage_stats *st;
+    rt_base_t level;
+    int recv_len;
+    int stage;
+
+    //接收客户端数据
+    recv_len = recv(sock, job->buf, HTTP_RECV_BUF_SIZE, 0);
+    if (recv_len <= 0) {
+        return -RT_EIO;
+    }
+    job->buf[recv_len] = '\0';
+
+    rt_memset(req, 0, sizeof(*req));
+    req->sock = sock;
+    if (http_parse(req, job->buf, recv_len) != RT_EOK) {
+        http_send_simple(sock, 400, "Bad Request");
+        return -RT_EINVAL;
+    }
+
+    job->route = http_route_lookup(req);
+    if (job->route == RT_NULL) {
+        http_send_simple(sock, 404, "Not Found");
+        return -RT_EEMPTY;
+    }
+    if ((job->route->methods & req->method) == 0) {
+        http_send_simple(sock, 405, "Method Not Allowed");
+        return -RT_EINVAL;
+    }
+    //令牌校验只需两次SHA-256块压缩，直接在I/O线程完成，未登录的请求不占用工作线程
+    if ((job->route->flags & HTTP_ROUTE_AUTH) && http_auth_check(req) != RT_EOK) {
+        http_send_simple(sock, 401, "Unauthorized");
+        return -RT_ERROR;
+    }
+
+    stage = (job->route->flags & HTTP_ROUTE_SLOW) ? HTTP_STAGE_SLOW : HTTP_STAGE_FAST;
+    st = &http_stage_stats[stage];
+    job->enqueued = rt_tick_get();
+
+    level = rt_hw_interrupt_disable();
+    st->depth++;
+    if (st->depth > st->depth_max) {
+        st->depth_max = st->depth;
+    }
+    rt_hw_interrupt_enable(level);
+
+    //队列有界，满了直接回503，不让请求在内存里无限堆积
+    if (rt_mq_send(http_queue[stage - HTTP_STAGE_FAST], &job, sizeof(job)) != RT_EOK) {
+        level = rt_hw_interrupt_disable();
+        st->depth--;
+        st->rejected++;
+        rt_hw_interrupt_enable(level);
+        http_send_simple(sock, 503, "Busy");
+        return -RT_EFULL;
+    }
+    return RT_EOK;
+}
+
+//I/O线程：只负责accept、接收和解析请求，处理交给工作线程
+static void http_server_thread(void *parameter)
+{
+    int sock, connected;
+    struct sockaddr_in server_addr, client_addr;
+    socklen_t client_addr_len = sizeof(client_addr);
+    http_job_t *job = RT_NULL;
+    struct timeval tv;
+
+    //创建socket
+    if ((sock = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
+        rt_kprintf("Socket创建失败\n");
+        return;
+    }
+
+    //配置服务器地址
+    server_addr.sin_family = AF_INET;
+    server_addr.sin_port = htons(HTTP_PORT);
+    server_addr.sin_addr.s_addr = INADDR_ANY;
+
+    //绑定socket
+    if (bind(sock, (struct sockaddr *)&server_addr, sizeof(server_addr)) != RT_EOK)
+    {
+        rt_kprintf("绑定端口%d失败\n", HTTP_PORT);
+        closesocket(sock);
+        return;
+    }
+
+    //开始监听
+    listen(sock, 5);
+    rt_kprintf("HTTP服务器已启动，监听端口%d\n", HTTP_PORT);
+
+    while (1) {
+        rt_tick_t start;
+
+        //作业块全部在用时在这里等待，形成对客户端的背压
+        if (job == RT_NULL) {
+            job = rt_mp_alloc(http_job_pool, RT_WAITING_FOREVER);
+        }
+
+        //接受客户端连接
+        if ((connected = accept(sock, (struct sockaddr *)&client_addr, &client_addr_len)) < 0) {
+            rt_kprintf("接受连接失败\n");
+            continue;
+        }
+
+        //收不到完整请求的连接在超时后放弃，工作线程读body时同样受此限制
+        tv.tv_sec = HTTP_RECV_TIMEOUT / 1000;
+        tv.tv_usec = (HTTP_RECV_TIMEOUT % 1000) * 1000;
+        setsockopt(connected, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+        http_stat_add(&http_server_stats.requests, 1);
+        start = rt_tick_get();
+        if (http_accept_job(job, connected) == RT_EOK) {
+            job = RT_NULL;
+        } else {
+            closesocket(connected);
+        }
+        http_stats_done(&http_stage_stats[HTTP_STAGE_IO], 0, rt_tick_get() - start);
+    }
+}
+
+rt_err_t http_server_start(void)
+{
+    static const char *const worker_names[] = {"http_f", "http_s"};
+    static const int worker_num[] = {HTTP_FAST_WORKERS, HTTP_SLOW_WORKERS};
+    rt_thread_t tid;
+    int lane, i;
+
+    http_route_build();
+
+    if (rt_mp_init(&http_job_mp, "http_job", http_job_mem, sizeof(http_job_mem),
+                   sizeof(http_job_t)) != RT_EOK) {
+        rt_kprintf("init http_job pool failed\n");
+        return -RT_ERROR;
+    }
+    http_job_pool = &http_job_mp;
+
+    for (lane = 0; lane < 2; lane++) {
+        http_queue[lane] = rt_mq_create(worker_names[lane], sizeof(http_job_t *),
+                                        HTTP_QUEUE_LEN, RT_IPC_FLAG_FIFO);
+        if (http_queue[lane] == RT_NULL) {
+            rt_kprintf("create %s queue failed\n", worker_names[lane]);
+            return -RT_ENOMEM;
+        }
+        for (i = 0; i < worker_num[lane]; i++) {
+            tid = rt_thread_create(worker_names[lane],
+                                   http_worker_entry,
+                                   (void *)(rt_ubase_t)(HTTP_STAGE_FAST + lane),
+                                   HTTP_WORKER_STACK,
+                                   lane == 0 ? 10 : 12,
+                                   10);
+            if (tid) {
+                rt_thread_startup(tid);
+            }
+        }
+    }
+
+    tid = rt_thread_create("http_server",
+                           http_server_thread,
+                           RT_NULL,
+                           2048,
+                           10,
+                           10);
+    if (tid == RT_NULL) {
+        return -RT_ERROR;
+    }
+    rt_thread_startup(tid);
+    rt_kprintf("HTTP服务器线程已启动\n");
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void http_routes(int argc, char **argv)
+{
+    const struct http_route *route;
+
+    rt_kprintf("%-24s %6s %8s %8s\n", "route", "method", "hits", "max(ms)");
+    for (route = HTTP_ROUTE_BEGIN; route < HTTP_ROUTE_END; route++) {
+        const struct http_route_stats *st = route->stats;
+
+        rt_kprintf("%-24s %6s %8d %8d  avg %d ms\n", route->pattern,
+                   route->methods == HTTP_ANY ? "ANY" :
+                   route->methods == HTTP_POST ? "POST" : "GET",
+                   st->hits, st->ticks_max * 1000 / RT_TICK_PER_SECOND,
+                   st->hits ? st->ticks_total * 1000 / RT_TICK_PER_SECOND / st->hits : 0);
+    }
+}
+MSH_CMD_EXPORT(http_routes, list http routes with hit count and handler time);
+
+static void http_stats(int argc, char **argv)
+{
+    static const char *const stage_names[] = {"io", "fast", "slow"};
+    int i;
+
+    rt_kprintf("%-6s %6s %6s %8s %8s %8s %8s %8s\n", "stage", "depth", "max",
+               "jobs", "reject", "wait(ms)", "svc(ms)", "svcmax");
+    for (i = 0; i < HTTP_STAGE_NUM; i++) {
+        const struct http_stage_stats *st = &http_stage_stats[i];
+
+        rt_kprintf("%-6s %6d %6d %8d %8d %8d %8d %8d\n", stage_names[i],
+                   st->depth, st->depth_max, st->jobs, st->rejected,
+                   st->jobs ? st->wait_total * 1000 / RT_TICK_PER_SECOND / st->jobs : 0,
+                   st->jobs ? st->service_total * 1000 / RT_TICK_PER_SECOND / st->jobs : 0,
+                   st->service_max * 1000 / RT_TICK_PER_SECOND);
+    }
+}
+MSH_CMD_EXPORT(http_stats, show http queue depth and per-stage service time);
+#endif /* RT_USING_FINSH */
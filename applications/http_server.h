@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_HTTP_SERVER_H_
+#define APPLICATIONS_HTTP_SERVER_H_
+
+#include <rtthread.h>
+
+#define HTTP_PORT               80
+#define HTTP_RECV_BUF_SIZE      1024
+#define HTTP_RECV_TIMEOUT       5000    /* 客户端停止发送多久后放弃，ms，防止慢速连接占住线程 */
+#define HTTP_CHUNK_SIZE         256
+#define HTTP_PARAM_MAX          4       /* 单条路由最多的路径参数个数 */
+#define HTTP_PARAM_BUF_SIZE     64
+#define HTTP_TRIE_NODES         48      /* 路由前缀树的节点池大小 */
+
+// 请求方法，路由中可按位组合
+#define HTTP_GET                0x01
+#define HTTP_POST               0x02
+#define HTTP_ANY                0xff
+
+// 路由标志
+#define HTTP_ROUTE_NONE         0x00
+#define HTTP_ROUTE_SLOW         0x01    /* 耗时处理，交给slow工作线程 */
+#define HTTP_ROUTE_AUTH         0x02    /* 需要有效的会话令牌，见http_auth.h */
+
+// 工作线程池：fast处理短小请求，slow处理文件/历史等耗时请求
+#define HTTP_FAST_WORKERS       1
+#define HTTP_SLOW_WORKERS       2
+#define HTTP_QUEUE_LEN          3       /* 每条队列的容量，满了回503 */
+#define HTTP_WORKER_STACK       4096
+
+enum
+{
+    HTTP_STAGE_IO = 0,          /* accept + 接收 + 解析 */
+    HTTP_STAGE_FAST,
+    HTTP_STAGE_SLOW,
+    HTTP_STAGE_NUM,
+};
+
+// 各阶段统计，时间单位为tick
+struct http_stage_stats
+{
+    rt_uint32_t depth;
+    rt_uint32_t depth_max;
+    rt_uint32_t jobs;
+    rt_uint32_t rejected;
+    rt_uint32_t wait_total;
+    rt_uint32_t wait_max;
+    rt_uint32_t service_total;
+    rt_uint32_t service_max;
+};
+
+extern struct http_stage_stats http_stage_stats[HTTP_STAGE_NUM];
+
+// 连接与响应统计
+struct http_server_stats
+{
+    rt_uint32_t requests;           /* 已accept的连接数 */
+    rt_uint32_t bytes_sent;
+    rt_uint32_t client_errors;      /* 4xx响应 */
+    rt_uint32_t server_errors;      /* 5xx响应 */
+};
+
+extern struct http_server_stats http_server_stats;
+
+typedef struct http_request_
+{
+    int sock;
+    rt_uint8_t method;
+    rt_bool_t detached;         /* 处理函数接管了socket，服务器不再关闭 */
+    char *path;
+    char *query;
+    char *headers;              /* 请求行之后的原始头部 */
+    char *body;                 /* 已随头部收到的body部分 */
+    rt_size_t body_len;
+    rt_int32_t content_length;
+    rt_uint8_t param_num;
+    const char *params[HTTP_PARAM_MAX];
+    char param_buf[HTTP_PARAM_BUF_SIZE];
+} http_request_t;
+
+typedef void (*http_handler_t)(http_request_t *req);
+
+struct http_route_stats
+{
+    rt_uint32_t hits;
+    rt_uint32_t ticks_total;
+    rt_uint32_t ticks_max;
+};
+
+struct http_route
+{
+    rt_uint8_t methods;
+    rt_uint8_t flags;
+    const char *pattern;        /* "/api/x"，":name"匹配一段，结尾"*"匹配剩余部分 */
+    http_handler_t handler;
+    struct http_route_stats *stats;
+};
+
+// 与INIT_APP_EXPORT类似，把路由放入HttpRouteTab段，启动时统一建表
+#define HTTP_ROUTE_EXPORT(name, methods, pattern, handler, flags)                   \
+    static struct http_route_stats __http_route_stats_##name;                       \
+    RT_USED static const struct http_route __http_route_##name                      \
+    RT_SECTION("HttpRouteTab") =                                                    \
+    {methods, flags, pattern, handler, &__http_route_stats_##name}
+
+// 启动HTTP服务器线程
+rt_err_t http_server_start(void);
+
+// JSON编码器等流式输出的socket回调，ctx为int *sock
+rt_err_t http_sock_flush(void *ctx, const char *buf, rt_size_t len);
+// 同上，但按Transfer-Encoding: chunked分块封装
+rt_err_t http_chunk_flush(void *ctx, const char *buf, rt_size_t len);
+// 发送结束块
+rt_err_t http_chunk_end(int sock);
+
+// 发送状态行和头部，content_type为空时不带Content-Type，length<0表示分块传输
+rt_err_t http_send_header(int sock, int code, const char *content_type, int length);
+// 同上，extra为附加的头部行，每行以"\r\n"结尾
+rt_err_t http_send_header_extra(int sock, int code, const char *content_type,
+                                int length, const char *extra);
+// 发送一个完整的短响应
+void http_send_simple(int sock, int code, const char *body);
+
+// 解析查询串中的参数，找不到返回-RT_EEMPTY
+rt_err_t http_query_get(const char *query, const char *key, char *buf, rt_size_t size);
+rt_err_t http_query_int(const char *query, const char *key, rt_int32_t *value);
+// 读取请求头，名称不区分大小写
+rt_err_t http_header_get(const http_request_t *req, const char *name, char *buf, rt_size_t size);
+// 读取请求body，先返回已随头部收到的部分，返回值同recv
+int http_read_body(http_request_t *req, char *buf, rt_size_t size);
+
+#endif /* APPLICATIONS_HTTP_SERVER_H_ */
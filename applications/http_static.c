@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dfs_posix.h>
+#include "http_static.h"
+
+static const char *const wday_names[] = {
+    "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat",
+};
+
+static const char *const month_names[] = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+    "Jul", "Aug", "Sep", "Oct", "Nov", "Dec",
+};
+
+static const struct {
+    const char *ext;
+    const char *type;
+} mime_types[] = {
+    {".html", "text/html"},
+    {".htm",  "text/html"},
+    {".css",  "text/css"},
+    {".js",   "application/javascript"},
+    {".json", "application/json"},
+    {".csv",  "text/csv"},
+    {".txt",  "text/plain"},
+    {".jpg",  "image/jpeg"},
+    {".jpeg", "image/jpeg"},
+    {".png",  "image/png"},
+};
+
+static rt_mp_t static_pool;
+
+static const char *static_mime(const char *path)
+{
+    const char *ext = strrchr(path, '.');
+    rt_size_t i;
+
+    for (i = 0; ext && i < sizeof(mime_types) / sizeof(mime_types[0]); i++) {
+        if (rt_strcmp(ext, mime_types[i].ext) == 0) {
+            return mime_types[i].type;
+        }
+    }
+    return "application/octet-stream";
+}
+
+//公历日期到1970-01-01起的天数，避免依赖timegm
+static rt_int32_t days_from_civil(rt_int32_t y, rt_int32_t m, rt_int32_t d)
+{
+    rt_int32_t era, yoe, doy, doe;
+
+    y -= m <= 2;
+    era = (y >= 0 ? y : y - 399) / 400;
+    yoe = y - era * 400;
+    doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
+}
+
+static void http_date_format(time_t t, char *buf, rt_size_t size)
+{
+    struct tm tm;
+
+    gmtime_r(&t, &tm);
+    rt_snprintf(buf, size, "%s, %02d %s %04d %02d:%02d:%02d GMT",
+                wday_names[tm.tm_wday], tm.tm_mday, month_names[tm.tm_mon],
+                tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec);
+}
+
+//只解析RFC 7231推荐的IMF-fixdate格式，其它格式返回0视为无效
+static time_t http_date_parse(const char *s)
+{
+    rt_int32_t day, month, year, hh, mm, ss;
+    const char *p = strchr(s, ',');
+
+    if (p == RT_NULL || rt_strlen(p) < 26) {
+        return 0;
+    }
+    p += 2;
+    day = atoi(p);
+    for (month = 0; month < 12; month++) {
+        if (rt_strncmp(p + 3, month_names[month], 3) == 0) {
+            break;
+        }
+    }
+    if (month == 12) {
+        return 0;
+    }
+    year = atoi(p + 7);
+    hh = atoi(p + 12);
+    mm = atoi(p + 15);
+    ss = atoi(p + 18);
+
+    return (time_t)days_from_civil(year, month + 1, day) * 86400 + hh * 3600 + mm * 60 + ss;
+}
+
+//解析单段Range，多段请求不支持，按整文件返回
+static rt_bool_t static_parse_range(const char *value, rt_int32_t size,
+                                    rt_int32_t *start, rt_int32_t *end)
+{
+    const char *dash;
+
+    if (rt_strncmp(value, "bytes=", 6) != 0 || strchr(value, ',')) {
+        return RT_FALSE;
+    }
+    value += 6;
+    dash = strchr(value, '-');
+    if (dash == RT_NULL) {
+        return RT_FALSE;
+    }
+
+    if (dash == value) {
+        //"bytes=-N" 取最后N字节
+        *start = size - atoi(dash + 1);
+        *end = size - 1;
+        if (*start < 0) {
+            *start = 0;
+        }
+    } else {
+        *start = atoi(value);
+        *end = (dash[1] >= '0' && dash[1] <= '9') ? atoi(dash + 1) : size - 1;
+        if (*end >= size) {
+            *end = size - 1;
+        }
+    }
+    return RT_TRUE;
+}
+
+rt_err_t http_static_send(http_request_t *req, const char *path)
+{
+    char value[40];
+    char date[32];
+    char extra[128];
+    struct stat st;
+    rt_int32_t start = 0, end;
+    rt_int32_t remain;
+    rt_err_t result = RT_EOK;
+    char *block;
+    int code = 200;
+    int fd;
+
+    if (stat(path, &st) != 0 || S_ISDIR(st.st_mode)) {
+        http_send_simple(req->sock, 404, "Not Found");
+        return -RT_EEMPTY;
+    }
+
+    //文件未修改时只回304，不读flash
+    if (http_header_get(req, "If-Modified-Since", value, sizeof(value)) == RT_EOK &&
+        st.st_mtime <= http_date_parse(value)) {
+        http_send_header(req->sock, 304, RT_NULL, 0);
+        return RT_EOK;
+    }
+
+    end = st.st_size - 1;
+    if (http_header_get(req, "Range", value, sizeof(value)) == RT_EOK &&
+        static_parse_range(value, st.st_size, &start, &end)) {
+        if (start > end || start >= st.st_size) {
+            rt_snprintf(extra, sizeof(extra), "Content-Range: bytes */%d\r\n", (int)st.st_size);
+            http_send_header_extra(req->sock, 416, RT_NULL, 0, extra);
+            return -RT_EINVAL;
+        }
+        code = 206;
+    }
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        http_send_simple(req->sock, 500, "open failed");
+        return -RT_EIO;
+    }
+
+    //共享的块缓冲池，大文件也只占一个块
+    block = rt_mp_alloc(static_pool, rt_tick_from_millisecond(1000));
+    if (block == RT_NULL) {
+        close(fd);
+        http_send_simple(req->sock, 503, "Busy");
+        return -RT_EBUSY;
+    }
+
+    http_date_format(st.st_mtime, date, sizeof(date));
+    if (code == 206) {
+        rt_snprintf(extra, sizeof(extra),
+                    "Accept-Ranges: bytes\r\nLast-Modified: %s\r\nContent-Range: bytes %d-%d/%d\r\n",
+                    date, start, end, (int)st.st_size);
+    } else {
+        rt_snprintf(extra, sizeof(extra), "Accept-Ranges: bytes\r\nLast-Modified: %s\r\n", date);
+    }
+
+    remain = end - start + 1;
+    if (http_send_header_extra(req->sock, code, static_mime(path), remain, extra) != RT_EOK) {
+        result = -RT_EIO;
+    }
+    if (start > 0) {
+        lseek(fd, start, SEEK_SET);
+    }
+
+    while (result == RT_EOK && remain > 0) {
+        int n = read(fd, block, remain < HTTP_STATIC_BLOCK_SIZE ? remain : HTTP_STATIC_BLOCK_SIZE);
+
+        if (n <= 0) {
+            result = -RT_EIO;
+            break;
+        }
+        result = http_sock_flush(&req->sock, block, n);
+        remain -= n;
+    }
+
+    rt_mp_free(block);
+    close(fd);
+
+    return result;
+}
+
+//GET /flash/... 与 /sdcard/...，URL路径即DFS路径
+//整个卷都可读，含模型和配置，所以路由要求会话令牌；浏览器登录后带Cookie，<img>也能直接引用
+static void static_handler(http_request_t *req)
+{
+    if (strstr(req->path, "..")) {
+        http_send_simple(req->sock, 403, "Forbidden");
+        return;
+    }
+    http_static_send(req, req->path);
+}
+HTTP_ROUTE_EXPORT(static_flash, HTTP_GET, "/flash/*", static_handler, HTTP_ROUTE_SLOW | HTTP_ROUTE_AUTH);
+HTTP_ROUTE_EXPORT(static_sdcard, HTTP_GET, "/sdcard/*", static_handler, HTTP_ROUTE_SLOW | HTTP_ROUTE_AUTH);
+
+static int http_static_init(void)
+{
+    static_pool = rt_mp_create("http_blk", HTTP_STATIC_BLOCKS, HTTP_STATIC_BLOCK_SIZE);
+    if (static_pool == RT_NULL) {
+        rt_kprintf("create http_blk pool failed\n");
+        return -RT_ENOMEM;
+    }
+    return RT_EOK;
+}
+INIT_COMPONENT_EXPORT(http_static_init);
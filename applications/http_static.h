@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_HTTP_STATIC_H_
+#define APPLICATIONS_HTTP_STATIC_H_
+
+#include <rtthread.h>
+#include "http_server.h"
+
+#define HTTP_STATIC_BLOCK_SIZE    1024    /* 单次读文件、发送的块大小 */
+#define HTTP_STATIC_BLOCKS        2       /* 缓冲池块数，即可同时发送的文件数 */
+
+// 从DFS分块流式发送一个文件，支持Range和If-Modified-Since
+rt_err_t http_static_send(http_request_t *req, const char *path);
+
+#endif /* APPLICATIONS_HTTP_STATIC_H_ */
@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include "json_writer.h"
+
+static const rt_int32_t pow10_table[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+};
+
+#define JSON_MAX_DECIMALS   (sizeof(pow10_table) / sizeof(pow10_table[0]) - 1)
+
+static void json_put(json_writer_t *w, const char *data, rt_size_t len)
+{
+    while (len > 0 && w->error == RT_EOK) {
+        rt_size_t n = w->size - w->len;
+
+        if (n == 0) {
+            w->error = w->flush(w->ctx, w->buf, w->len);
+            w->len = 0;
+            continue;
+        }
+        if (n > len) {
+            n = len;
+        }
+        rt_memcpy(w->buf + w->len, data, n);
+        w->len += n;
+        w->total += n;
+        data += n;
+        len -= n;
+    }
+}
+
+static void json_putc(json_writer_t *w, char c)
+{
+    //单字符走快路径，省掉memcpy的调用开销
+    if (w->len < w->size && w->error == RT_EOK) {
+        w->buf[w->len++] = c;
+        w->total++;
+        return;
+    }
+    json_put(w, &c, 1);
+}
+
+//值前的逗号处理：同一层级第二个及以后的元素需要逗号
+static void json_value_prefix(json_writer_t *w)
+{
+    rt_uint8_t bit = 1 << w->depth;
+
+    if (w->after_key) {
+        w->after_key = RT_FALSE;
+        return;
+    }
+    if (w->need_comma & bit) {
+        json_putc(w, ',');
+    }
+    w->need_comma |= bit;
+}
+
+rt_size_t json_format_fixed(char *buf, rt_int32_t value, rt_uint8_t decimals)
+{
+    char tmp[12];
+    rt_uint32_t u;
+    rt_size_t len = 0;
+    int n = 0;
+
+    if (decimals > JSON_MAX_DECIMALS) {
+        decimals = JSON_MAX_DECIMALS;
+    }
+
+    if (value < 0) {
+        buf[len++] = '-';
+        u = (rt_uint32_t)0 - (rt_uint32_t)value;
+    } else {
+        u = (rt_uint32_t)value;
+    }
+
+    //逆序生成数字，至少保留decimals+1位以便补齐前导0
+    do {
+        tmp[n++] = '0' + (u % 10);
+        u /= 10;
+    } while (u > 0 || n <= decimals);
+
+    while (n > 0) {
+        if (n == decimals) {
+            buf[len++] = '.';
+        }
+        buf[len++] = tmp[--n];
+    }
+
+    return len;
+}
+
+rt_int32_t json_float_to_fixed(float value, rt_uint8_t decimals)
+{
+    float scaled;
+
+    //NaN参与比较恒为假，会落到下面的强制转换上，同样是未定义行为
+    if (value != value) {
+        return 0;
+    }
+    if (decimals > JSON_MAX_DECIMALS) {
+        decimals = JSON_MAX_DECIMALS;
+    }
+    scaled = value * (float)pow10_table[decimals];
+
+    //饱和到int32范围(含±inf)，避免转换溢出是未定义行为
+    if (scaled >= 2147483647.0f) {
+        return 2147483647;
+    }
+    if (scaled <= -2147483647.0f) {
+        return -2147483647;
+    }
+    return (rt_int32_t)(scaled + (scaled < 0 ? -0.5f : 0.5f));
+}
+
+void json_writer_init(json_writer_t *w, char *buf, rt_size_t size,
+                      json_flush_t flush, void *ctx)
+{
+    rt_memset(w, 0, sizeof(*w));
+    w->buf = buf;
+    w->size = size;
+    w->flush = flush;
+    w->ctx = ctx;
+}
+
+rt_err_t json_writer_finish(json_writer_t *w)
+{
+    if (w->error == RT_EOK && w->len > 0) {
+        w->error = w->flush(w->ctx, w->buf, w->len);
+        w->len = 0;
+    }
+    if (w->error == RT_EOK && w->depth != 0) {
+        w->error = -RT_ERROR;
+    }
+    return w->error;
+}
+
+static void json_open(json_writer_t *w, char c)
+{
+    json_value_prefix(w);
+    if (w->depth + 1 >= JSON_MAX_DEPTH) {
+        w->error = -RT_EFULL;
+        return;
+    }
+    json_putc(w, c);
+    w->depth++;
+    w->need_comma &= ~(1 << w->depth);
+}
+
+static void json_close(json_writer_t *w, char c)
+{
+    if (w->depth == 0) {
+        w->error = -RT_ERROR;
+        return;
+    }
+    w->depth--;
+    json_putc(w, c);
+}
+
+void json_object_begin(json_writer_t *w)
+{
+    json_open(w, '{');
+}
+
+void json_object_end(json_writer_t *w)
+{
+    json_close(w, '}');
+}
+
+void json_array_begin(json_writer_t *w)
+{
+    json_open(w, '[');
+}
+
+void json_array_end(json_writer_t *w)
+{
+    json_close(w, ']');
+}
+
+static void json_put_string(json_writer_t *w, const char *str)
+{
+    static const char hex[] = "0123456789abcdef";
+    const char *run = str;
+
+    json_putc(w, '"');
+    while (*str) {
+        unsigned char c = (unsigned char)*str;
+
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            str++;
+            continue;
+        }
+        //整段写入无需转义的部分，只对特殊字符单独处理
+        json_put(w, run, str - run);
+        if (c == '"' || c == '\\') {
+            char esc[2] = {'\\', (char)c};
+            json_put(w, esc, 2);
+        } else {
+            char esc[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf]};
+            json_put(w, esc, 6);
+        }
+        run = ++str;
+    }
+    json_put(w, run, str - run);
+    json_putc(w, '"');
+}
+
+void json_key(json_writer_t *w, const char *key)
+{
+    json_value_prefix(w);
+    json_put_string(w, key);
+    json_putc(w, ':');
+    w->after_key = RT_TRUE;
+}
+
+void json_string(json_writer_t *w, const char *str)
+{
+    json_value_prefix(w);
+    json_put_string(w, str);
+}
+
+void json_fixed(json_writer_t *w, rt_int32_t value, rt_uint8_t decimals)
+{
+    char buf[16];
+
+    json_value_prefix(w);
+    json_put(w, buf, json_format_fixed(buf, value, decimals));
+}
+
+void json_int(json_writer_t *w, rt_int32_t value)
+{
+    json_fixed(w, value, 0);
+}
+
+void json_float(json_writer_t *w, float value, rt_uint8_t decimals)
+{
+    //NaN不是合法的JSON数字
+    if (value != value) {
+        json_null(w);
+        return;
+    }
+    json_fixed(w, json_float_to_fixed(value, decimals), decimals);
+}
+
+void json_bool(json_writer_t *w, rt_bool_t value)
+{
+    json_raw(w, value ? "true" : "false", value ? 4 : 5);
+}
+
+void json_null(json_writer_t *w)
+{
+    json_raw(w, "null", 4);
+}
+
+void json_raw(json_writer_t *w, const char *str, rt_size_t len)
+{
+    json_value_prefix(w);
+    json_put(w, str, len);
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+#include <stdio.h>
+#include <string.h>
+
+#define JSON_BENCH_LOOPS    10000
+
+struct json_bench_out
+{
+    char *buf;
+    rt_size_t size;
+    rt_size_t len;
+};
+
+static rt_err_t json_bench_sink(void *ctx, const char *buf, rt_size_t len)
+{
+    struct json_bench_out *out = ctx;
+
+    if (out->len + len < out->size) {
+        rt_memcpy(out->buf + out->len, buf, len);
+    }
+    out->len += len;
+    return RT_EOK;
+}
+
+static void json_bench_encode(const float *values, char *chunk, rt_size_t size,
+                              struct json_bench_out *out)
+{
+    json_writer_t w;
+
+    json_writer_init(&w, chunk, size, json_bench_sink, out);
+    json_object_begin(&w);
+    json_key(&w, "temp");
+    json_float(&w, values[0], 1);
+    json_key(&w, "humi");
+    json_float(&w, values[1], 1);
+    json_key(&w, "soil");
+    json_float(&w, values[2], 1);
+    json_key(&w, "light");
+    json_float(&w, values[3], 1);
+    json_object_end(&w);
+    json_writer_finish(&w);
+}
+
+//基线是旧/api/sensors的格式串。rt_snprintf不支持%f，旧代码要输出正确的数字
+//只能走libc的snprintf，所以这里用它计时，并先核对两条路径输出完全一致
+static void json_bench(int argc, char **argv)
+{
+    float values[4] = {23.5f, 61.2f, 37.9f, 1234.5f};
+    char ref[128], enc[128];
+    char chunk[64];
+    struct json_bench_out out;
+    rt_tick_t start, snprintf_ticks, writer_ticks;
+    int i;
+
+    snprintf(ref, sizeof(ref),
+        "{\"temp\":%.1f,\"humi\":%.1f,\"soil\":%.1f,\"light\":%.1f}",
+        values[0], values[1], values[2], values[3]);
+    out.buf = enc;
+    out.size = sizeof(enc);
+    out.len = 0;
+    json_bench_encode(values, chunk, sizeof(chunk), &out);
+    enc[out.len < sizeof(enc) ? out.len : sizeof(enc) - 1] = '\0';
+    if (strcmp(ref, enc) != 0) {
+        rt_kprintf("json_bench: output differs\n  snprintf   : %s\n  json_writer: %s\n", ref, enc);
+        return;
+    }
+
+    start = rt_tick_get();
+    for (i = 0; i < JSON_BENCH_LOOPS; i++) {
+        snprintf(ref, sizeof(ref),
+            "{\"temp\":%.1f,\"humi\":%.1f,\"soil\":%.1f,\"light\":%.1f}",
+            values[0], values[1], values[2], values[3]);
+    }
+    snprintf_ticks = rt_tick_get() - start;
+
+    //计时循环只数字节不拷贝，与snprintf一样只产生一份输出
+    out.buf = RT_NULL;
+    out.size = 0;
+    out.len = 0;
+    start = rt_tick_get();
+    for (i = 0; i < JSON_BENCH_LOOPS; i++) {
+        json_bench_encode(values, chunk, sizeof(chunk), &out);
+    }
+    writer_ticks = rt_tick_get() - start;
+
+    rt_kprintf("json_bench: %d loops, %d bytes/loop\n", JSON_BENCH_LOOPS, out.len / JSON_BENCH_LOOPS);
+    rt_kprintf("  snprintf    : %d ms\n", snprintf_ticks * 1000 / RT_TICK_PER_SECOND);
+    rt_kprintf("  json_writer : %d ms\n", writer_ticks * 1000 / RT_TICK_PER_SECOND);
+}
+MSH_CMD_EXPORT(json_bench, benchmark json writer against the old snprintf encoder);
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_JSON_WRITER_H_
+#define APPLICATIONS_JSON_WRITER_H_
+
+#include <rtthread.h>
+
+#define JSON_MAX_DEPTH      8
+
+// 输出回调：缓冲写满或结束时调用，返回非RT_EOK则后续写入全部丢弃
+typedef rt_err_t (*json_flush_t)(void *ctx, const char *buf, rt_size_t len);
+
+typedef struct json_writer_
+{
+    char *buf;
+    rt_size_t size;
+    rt_size_t len;
+    json_flush_t flush;
+    void *ctx;
+    rt_uint8_t depth;
+    rt_uint8_t need_comma;      /* 按层级的位图 */
+    rt_uint8_t after_key;       /* 刚写完键名，下一个值不加逗号 */
+    rt_err_t error;
+    rt_size_t total;            /* 已输出的总字节数 */
+} json_writer_t;
+
+// 使用调用者提供的缓冲，不做任何动态分配
+void json_writer_init(json_writer_t *w, char *buf, rt_size_t size,
+                      json_flush_t flush, void *ctx);
+rt_err_t json_writer_finish(json_writer_t *w);
+
+void json_object_begin(json_writer_t *w);
+void json_object_end(json_writer_t *w);
+void json_array_begin(json_writer_t *w);
+void json_array_end(json_writer_t *w);
+void json_key(json_writer_t *w, const char *key);
+
+void json_string(json_writer_t *w, const char *str);
+void json_int(json_writer_t *w, rt_int32_t value);
+void json_bool(json_writer_t *w, rt_bool_t value);
+void json_null(json_writer_t *w);
+// 定点数输出：value = 实际值 * 10^decimals
+void json_fixed(json_writer_t *w, rt_int32_t value, rt_uint8_t decimals);
+// 浮点数先四舍五入为定点数再输出，不依赖printf的浮点支持
+void json_float(json_writer_t *w, float value, rt_uint8_t decimals);
+// 原样写入，调用者保证是合法的JSON片段
+void json_raw(json_writer_t *w, const char *str, rt_size_t len);
+
+// 不带JSON语义的定点数格式化，返回写入长度，buf至少16字节
+rt_size_t json_format_fixed(char *buf, rt_int32_t value, rt_uint8_t decimals);
+rt_int32_t json_float_to_fixed(float value, rt_uint8_t decimals);
+
+#endif /* APPLICATIONS_JSON_WRITER_H_ */
@@ -62,6 +62,7 @@ void adc_light_entry(void * parameters)
         sensor_msg_t *msg = rt_malloc(sizeof(sensor_msg_t));
         if (!msg) {
             rt_kprintf("malloc for light msg failed\n");
+            sensor_msg_stats.dropped++;
             continue;
         }
 
@@ -77,7 +78,10 @@ void adc_light_entry(void * parameters)
 
         if (result != RT_EOK) {
             rt_kprintf("rt_mq_send light error: %d\n", result);
+            sensor_msg_stats.dropped++;
             rt_free(msg);
+        } else {
+            sensor_msg_stats.sent++;
         }
 
         rt_mutex_release(sensor_msg_mutex);
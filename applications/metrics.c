@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include <rthw.h>
+#include "board.h"
+#include "sensor_msg.h"
+#include "http_server.h"
+#include "metrics.h"
+
+#if defined(__ARMCC_VERSION)
+extern const int MetricTab$$Base;
+extern const int MetricTab$$Limit;
+#define METRIC_BEGIN        ((const struct metric *)&MetricTab$$Base)
+#define METRIC_END          ((const struct metric *)&MetricTab$$Limit)
+#elif defined(__GNUC__)
+extern const int __metric_start;
+extern const int __metric_end;
+#define METRIC_BEGIN        ((const struct metric *)&__metric_start)
+#define METRIC_END          ((const struct metric *)&__metric_end)
+#endif
+
+// board/port/ef_fal_port.c中的擦写计数，NG模式的EasyFlash只在GC和格式化时擦除
+extern volatile rt_uint32_t ef_port_erase_count;
+extern volatile rt_uint32_t ef_port_erase_fail;
+extern volatile rt_uint32_t ef_port_write_bytes;
+
+METRIC_EXPORT(ef_erase, "easyflash_erase_total", RT_NULL, METRIC_COUNTER,
+              "Sector erases in the EasyFlash partition (GC and format)", &ef_port_erase_count);
+METRIC_EXPORT(ef_erase_fail, "easyflash_erase_failures_total", RT_NULL, METRIC_COUNTER,
+              "Failed erase calls in the EasyFlash partition", &ef_port_erase_fail);
+METRIC_EXPORT(ef_write, "easyflash_write_bytes_total", RT_NULL, METRIC_COUNTER,
+              "Bytes written to the EasyFlash partition", &ef_port_write_bytes);
+
+typedef struct metrics_out_
+{
+    int sock;
+    rt_size_t len;
+    rt_err_t error;
+    char buf[HTTP_CHUNK_SIZE];
+} metrics_out_t;
+
+typedef struct metrics_thread_
+{
+    char name[RT_NAME_MAX + 1];
+    rt_uint32_t stack_size;
+    rt_uint32_t stack_used;
+    rt_uint64_t cycles;
+} metrics_thread_t;
+
+// 线程快照较大，放在静态区，由锁保证同一时刻只有一个抓取者使用
+static metrics_thread_t snap[METRICS_THREAD_MAX];
+static rt_mutex_t snap_lock;
+
+#ifdef RT_USING_HOOK
+/*
+ * 每个线程的运行周期数。线程第一次被切出时从空闲栈取一个槽位，槽位号带标记记在
+ * thread->user_data里，调度钩子据此O(1)定位，不扫描。本模块的表反向记录槽位属于哪个线程，
+ * 两边核对一致才计数：应用自己用了user_data的线程不计时，也不会被算到别的线程头上。
+ * 线程删除或脱离时槽位放回空闲栈。
+ */
+#define METRICS_SLOT_TAG        0x4d540000u     /* "MT"，低16位为槽位号 */
+#define METRICS_SLOT_MASK       0x0000ffffu
+
+static struct rt_thread *metrics_thread_ptr[METRICS_THREAD_MAX];
+static rt_uint64_t metrics_thread_cycles[METRICS_THREAD_MAX];
+static rt_uint8_t metrics_free_slot[METRICS_THREAD_MAX];
+static int metrics_free_num;
+static rt_uint32_t metrics_switch_cycles;
+
+//取线程的槽位，没有分配过返回-1，调用者关中断
+static int metrics_thread_slot(struct rt_thread *thread)
+{
+    rt_ubase_t tag = thread->user_data;
+    rt_uint32_t slot = tag & METRICS_SLOT_MASK;
+
+    if ((tag & ~METRICS_SLOT_MASK) == METRICS_SLOT_TAG && slot < METRICS_THREAD_MAX &&
+        metrics_thread_ptr[slot] == thread) {
+        return slot;
+    }
+    return -1;
+}
+
+//调度钩子在关中断下运行；已退出的线程和占用了user_data的线程不分配槽位
+static void metrics_scheduler_hook(struct rt_thread *from, struct rt_thread *to)
+{
+    rt_uint32_t now = DWT->CYCCNT;
+    int slot = metrics_thread_slot(from);
+
+    if (slot < 0 && from->user_data == 0 && metrics_free_num > 0 &&
+        (from->stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE) {
+        slot = metrics_free_slot[--metrics_free_num];
+        metrics_thread_ptr[slot] = from;
+        metrics_thread_cycles[slot] = 0;
+        from->user_data = METRICS_SLOT_TAG | slot;
+    }
+    if (slot >= 0) {
+        metrics_thread_cycles[slot] += now - metrics_switch_cycles;
+    }
+    metrics_switch_cycles = now;
+}
+
+static void metrics_detach_hook(struct rt_object *object)
+{
+    struct rt_thread *thread = (struct rt_thread *)object;
+    rt_base_t level;
+    int slot;
+
+    if (rt_object_get_type(object) != RT_Object_Class_Thread) {
+        return;
+    }
+    level = rt_hw_interrupt_disable();
+    slot = metrics_thread_slot(thread);
+    if (slot >= 0) {
+        metrics_thread_ptr[slot] = RT_NULL;
+        metrics_free_slot[metrics_free_num++] = slot;
+        thread->user_data = 0;
+    }
+    rt_hw_interrupt_enable(level);
+}
+#endif /* RT_USING_HOOK */
+
+static void metrics_put(metrics_out_t *o, const char *data, rt_size_t len)
+{
+    while (len > 0 && o->error == RT_EOK) {
+        rt_size_t n = sizeof(o->buf) - o->len;
+
+        if (n == 0) {
+            o->error = http_chunk_flush(&o->sock, o->buf, o->len);
+            o->len = 0;
+            continue;
+        }
+        if (n > len) {
+            n = len;
+        }
+        rt_memcpy(o->buf + o->len, data, n);
+        o->len += n;
+        data += n;
+        len -= n;
+    }
+}
+
+static void metrics_header(metrics_out_t *o, const char *name, const char *help, rt_uint8_t type)
+{
+    char line[128];
+    int n;
+
+    n = rt_snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s %s\n", name, help, name,
+                    (type & METRIC_COUNTER) ? "counter" : "gauge");
+    metrics_put(o, line, n < (int)sizeof(line) ? n : (int)sizeof(line) - 1);
+}
+
+//输出一行样本，秒值以毫秒传入并按三位小数输出
+static void metrics_sample(metrics_out_t *o, const char *name, const char *labels,
+                           rt_uint32_t value, rt_bool_t millis)
+{
+    char line[96];
+    int n;
+
+    n = rt_snprintf(line, sizeof(line), "%s%s%s%s ", name,
+                    labels ? "{" : "", labels ? labels : "", labels ? "}" : "");
+    if (n >= (int)sizeof(line)) {
+        return;
+    }
+    if (millis) {
+        n += rt_snprintf(line + n, sizeof(line) - n, "%u.%03u\n", value / 1000, value % 1000);
+    } else {
+        n += rt_snprintf(line + n, sizeof(line) - n, "%u\n", value);
+    }
+    if (n < (int)sizeof(line)) {
+        metrics_put(o, line, n);
+    }
+}
+
+static void metrics_registry(metrics_out_t *o)
+{
+    const struct metric *m;
+    const char *last = RT_NULL;
+
+    for (m = METRIC_BEGIN; m < METRIC_END && o->error == RT_EOK; m++) {
+        rt_uint32_t value = *m->value;
+
+        if (last == RT_NULL || rt_strcmp(last, m->name) != 0) {
+            metrics_header(o, m->name, m->help, m->type);
+            last = m->name;
+        }
+        if (m->type & METRIC_TICKS) {
+            metrics_sample(o, m->name, m->labels,
+                           (rt_uint32_t)((rt_uint64_t)value * 1000 / RT_TICK_PER_SECOND), RT_TRUE);
+        } else {
+            metrics_sample(o, m->name, m->labels, value, RT_FALSE);
+        }
+    }
+}
+
+static void metrics_system(metrics_out_t *o)
+{
+    rt_uint32_t total = 0, used = 0, max_used = 0;
+
+    metrics_header(o, "uptime_seconds", "Time since boot", METRIC_COUNTER);
+    metrics_sample(o, "uptime_seconds", RT_NULL,
+                   (rt_uint32_t)((rt_uint64_t)rt_tick_get() * 1000 / RT_TICK_PER_SECOND), RT_TRUE);
+
+    rt_memory_info(&total, &used, &max_used);
+    metrics_header(o, "heap_size_bytes", "System heap size", METRIC_GAUGE);
+    metrics_sample(o, "heap_size_bytes", RT_NULL, total, RT_FALSE);
+    metrics_header(o, "heap_used_bytes", "System heap in use", METRIC_GAUGE);
+    metrics_sample(o, "heap_used_bytes", RT_NULL, used, RT_FALSE);
+    metrics_header(o, "heap_max_used_bytes", "System heap high-water mark", METRIC_GAUGE);
+    metrics_sample(o, "heap_max_used_bytes", RT_NULL, max_used, RT_FALSE);
+
+    metrics_header(o, "sensor_queue_depth", "Sensor messages waiting for the control thread", METRIC_GAUGE);
+    metrics_sample(o, "sensor_queue_depth", RT_NULL, sensor_msg_mq ? sensor_msg_mq->entry : 0, RT_FALSE);
+}
+
+//栈初始化时填充'#'，从栈底找到第一个被改写的字节即历史最大用量
+static rt_uint32_t metrics_stack_used(struct rt_thread *thread)
+{
+    rt_uint8_t *p = (rt_uint8_t *)thread->stack_addr;
+    rt_uint8_t *end = p + thread->stack_size;
+
+    while (p < end && *p == '#') {
+        p++;
+    }
+    return end - p;
+}
+
+static void metrics_threads(metrics_out_t *o)
+{
+    struct rt_object_information *info;
+    struct rt_list_node *node;
+    char labels[RT_NAME_MAX + 12];
+    int num = 0, i;
+#ifdef RT_USING_HOOK
+    int slot;
+#endif
+
+    rt_mutex_take(snap_lock, RT_WAITING_FOREVER);
+
+    //遍历线程链表时禁止调度，只拷贝数据，格式化放到临界区外
+    info = rt_object_get_information(RT_Object_Class_Thread);
+    rt_enter_critical();
+    for (node = info->object_list.next; node != &info->object_list && num < METRICS_THREAD_MAX;
+         node = node->next) {
+        struct rt_thread *thread = rt_list_entry(node, struct rt_thread, list);
+        metrics_thread_t *t = &snap[num++];
+
+        rt_strncpy(t->name, thread->name, RT_NAME_MAX);
+        t->name[RT_NAME_MAX] = '\0';
+        t->stack_size = thread->stack_size;
+        t->stack_used = metrics_stack_used(thread);
+#ifdef RT_USING_HOOK
+        slot = metrics_thread_slot(thread);
+        t->cycles = slot >= 0 ? metrics_thread_cycles[slot] : 0;
+#else
+        t->cycles = 0;
+#endif
+    }
+    rt_exit_critical();
+
+    metrics_header(o, "thread_stack_size_bytes", "Thread stack size", METRIC_GAUGE);
+    for (i = 0; i < num; i++) {
+        rt_snprintf(labels, sizeof(labels), "thread=\"%s\"", snap[i].name);
+        metrics_sample(o, "thread_stack_size_bytes", labels, snap[i].stack_size, RT_FALSE);
+    }
+    metrics_header(o, "thread_stack_used_bytes", "Thread stack high-water mark", METRIC_GAUGE);
+    for (i = 0; i < num; i++) {
+        rt_snprintf(labels, sizeof(labels), "thread=\"%s\"", snap[i].name);
+        metrics_sample(o, "thread_stack_used_bytes", labels, snap[i].stack_used, RT_FALSE);
+    }
+#ifdef RT_USING_HOOK
+    metrics_header(o, "thread_cpu_seconds_total", "CPU time spent in each thread", METRIC_COUNTER);
+    for (i = 0; i < num; i++) {
+        rt_snprintf(labels, sizeof(labels), "thread=\"%s\"", snap[i].name);
+        metrics_sample(o, "thread_cpu_seconds_total", labels,
+                       (rt_uint32_t)(snap[i].cycles / (SystemCoreClock / 1000)), RT_TRUE);
+    }
+#endif
+
+    rt_mutex_release(snap_lock);
+}
+
+//GET /metrics，Prometheus文本格式，边生成边分块发送
+static void metrics_handler(http_request_t *req)
+{
+    metrics_out_t out;
+
+    if (http_send_header(req->sock, 200, "text/plain; version=0.0.4", -1) != RT_EOK) {
+        return;
+    }
+    out.sock = req->sock;
+    out.len = 0;
+    out.error = RT_EOK;
+
+    metrics_system(&out);
+    metrics_registry(&out);
+    metrics_threads(&out);
+
+    if (out.error == RT_EOK && out.len > 0) {
+        out.error = http_chunk_flush(&out.sock, out.buf, out.len);
+    }
+    if (out.error == RT_EOK) {
+        http_chunk_end(req->sock);
+    }
+}
+HTTP_ROUTE_EXPORT(metrics, HTTP_GET, "/metrics", metrics_handler, HTTP_ROUTE_SLOW);
+
+static int metrics_init(void)
+{
+    snap_lock = rt_mutex_create("metrics", RT_IPC_FLAG_FIFO);
+    if (snap_lock == RT_NULL) {
+        rt_kprintf("create metrics lock failed\n");
+        return -RT_ENOMEM;
+    }
+#ifdef RT_USING_HOOK
+    //DWT周期计数器用于线程CPU时间统计
+    rt_hw_cycle_counter_enable();
+    for (metrics_free_num = 0; metrics_free_num < METRICS_THREAD_MAX; metrics_free_num++) {
+        metrics_free_slot[metrics_free_num] = METRICS_THREAD_MAX - 1 - metrics_free_num;
+    }
+    metrics_switch_cycles = DWT->CYCCNT;
+    rt_object_detach_sethook(metrics_detach_hook);
+    rt_scheduler_sethook(metrics_scheduler_hook);
+#endif
+    return RT_EOK;
+}
+INIT_COMPONENT_EXPORT(metrics_init);
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_METRICS_H_
+#define APPLICATIONS_METRICS_H_
+
+#include <rtthread.h>
+
+#define METRICS_THREAD_MAX        32      /* 统计CPU时间的线程数上限 */
+
+// 指标类型，METRIC_TICKS表示值为tick数，输出时换算成秒
+#define METRIC_COUNTER            0x01
+#define METRIC_GAUGE              0x02
+#define METRIC_TICKS              0x80
+
+struct metric
+{
+    const char *name;
+    const char *labels;         /* 形如 stage="fast"，无标签为RT_NULL */
+    const char *help;
+    rt_uint8_t type;
+    const volatile rt_uint32_t *value;
+};
+
+/*
+ * 把已有的32位计数器登记到MetricTab段，/metrics抓取时直接读取，不加锁。
+ * 计数器仍由原模块按原方式更新，热路径上没有额外开销。
+ * 同名指标应在同一文件中连续登记，HELP/TYPE只输出一次。
+ */
+#define METRIC_EXPORT(id, name, labels, type, help, ptr)                            \
+    RT_USED static const struct metric __metric_##id                                \
+    RT_SECTION("MetricTab") =                                                       \
+    {name, labels, help, type, (const volatile rt_uint32_t *)(ptr)}
+
+#endif /* APPLICATIONS_METRICS_H_ */
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include "board.h"
+#include "metrics.h"
+#include "mqtt_push.h"
+
+#ifdef PKG_USING_PAHOMQTT
+#include "paho_mqtt.h"
+
+static MQTTClient client;
+static char client_id[24];
+static rt_uint16_t packet_id;
+
+static volatile rt_uint32_t mqtt_connects;
+static volatile rt_uint32_t mqtt_disconnects;
+static volatile rt_uint32_t mqtt_published;
+static volatile rt_uint32_t mqtt_publish_fail;
+
+METRIC_EXPORT(mqtt_conn, "mqtt_connects_total", RT_NULL, METRIC_COUNTER,
+              "Successful connections to the MQTT broker", &mqtt_connects);
+METRIC_EXPORT(mqtt_disc, "mqtt_disconnects_total", RT_NULL, METRIC_COUNTER,
+              "Lost connections to the MQTT broker", &mqtt_disconnects);
+METRIC_EXPORT(mqtt_pub_ok, "mqtt_publish_total", "result=\"ok\"", METRIC_COUNTER,
+              "MQTT publish calls", &mqtt_published);
+METRIC_EXPORT(mqtt_pub_fail, "mqtt_publish_total", "result=\"fail\"", METRIC_COUNTER,
+              "MQTT publish calls", &mqtt_publish_fail);
+
+/*
+ * 客户端ID取自芯片96位UID，每块板不同且重启后不变，同一代理上的
+ * 多块板不会互相踢掉会话。MQTT 3.1要求不超过23个字符：
+ * "nursery-"后接UID的32位FNV-1a散列和UID第0字（晶圆坐标）的低28位。
+ */
+static void mqtt_push_client_id(char *buf, rt_size_t size)
+{
+    rt_uint32_t uid[3] = {HAL_GetUIDw0(), HAL_GetUIDw1(), HAL_GetUIDw2()};
+    const rt_uint8_t *p = (const rt_uint8_t *)uid;
+    rt_uint32_t h = 2166136261u;
+    rt_size_t i;
+
+    for (i = 0; i < sizeof(uid); i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    rt_snprintf(buf, size, "nursery-%08x%07x", (unsigned int)h, (unsigned int)(uid[0] & 0xfffffff));
+}
+
+static void mqtt_push_online(MQTTClient *c)
+{
+    mqtt_connects++;
+    rt_kprintf("MQTT已连接: %s\n", c->uri);
+}
+
+static void mqtt_push_offline(MQTTClient *c)
+{
+    mqtt_disconnects++;
+    rt_kprintf("MQTT断开，稍后重连\n");
+}
+
+rt_err_t mqtt_push_publish(const char *topic, const char *payload)
+{
+    char full[64];
+    MQTTMessage message = {0};
+
+    if (!client.isconnected) {
+        mqtt_publish_fail++;
+        return -RT_ERROR;
+    }
+    rt_snprintf(full, sizeof(full), MQTT_PUSH_TOPIC_PREFIX "%s", topic);
+
+    // 报文id为0在QoS1下非法，回绕时跳过
+    if (++packet_id == 0) {
+        packet_id = 1;
+    }
+    message.qos = QOS1;
+    message.retained = 1;
+    message.id = packet_id;
+    message.payload = (void *)payload;
+    message.payloadlen = rt_strlen(payload);
+
+    // pipe模式下只是写入管道，由MQTT线程发送
+    if (MQTTPublish(&client, full, &message) != PAHO_SUCCESS) {
+        mqtt_publish_fail++;
+        return -RT_ERROR;
+    }
+    mqtt_published++;
+    return RT_EOK;
+}
+
+static int mqtt_push_init(void)
+{
+    MQTTPacket_connectData condata = MQTTPacket_connectData_initializer;
+
+    client.isconnected = 0;
+    client.uri = MQTT_PUSH_URI;
+    mqtt_push_client_id(client_id, sizeof(client_id));
+    rt_memcpy(&client.condata, &condata, sizeof(condata));
+    client.condata.clientID.cstring = client_id;
+    client.condata.keepAliveInterval = 30;
+    client.condata.cleansession = 1;
+
+    client.buf_size = client.readbuf_size = MQTT_PUSH_BUF_SIZE;
+    client.buf = rt_calloc(1, client.buf_size);
+    client.readbuf = rt_calloc(1, client.readbuf_size);
+    if (client.buf == RT_NULL || client.readbuf == RT_NULL) {
+        rt_free(client.buf);
+        rt_free(client.readbuf);
+        return -RT_ENOMEM;
+    }
+    client.online_callback = mqtt_push_online;
+    client.offline_callback = mqtt_push_offline;
+
+    // 连接和断线重连都在paho的线程里完成
+    return paho_mqtt_start(&client) == PAHO_SUCCESS ? 0 : -RT_ERROR;
+}
+INIT_APP_EXPORT(mqtt_push_init);
+
+#else
+
+rt_err_t mqtt_push_publish(const char *topic, const char *payload)
+{
+    return -RT_ENOSYS;
+}
+
+#endif /* PKG_USING_PAHOMQTT */
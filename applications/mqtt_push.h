@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_MQTT_PUSH_H_
+#define APPLICATIONS_MQTT_PUSH_H_
+
+#include <rtthread.h>
+
+#ifndef MQTT_PUSH_URI
+#define MQTT_PUSH_URI           "tcp://192.168.169.2:1883"  /* 接入本机热点的上位机 */
+#endif
+#define MQTT_PUSH_TOPIC_PREFIX  "nursery/"
+#define MQTT_PUSH_BUF_SIZE      512
+
+/*
+ * 向MQTT代理发布一条事件，topic会加上MQTT_PUSH_TOPIC_PREFIX前缀。
+ * 以QoS1、retained发布，后连上的订阅者也能拿到最新状态。
+ * 未连接或没有启用paho-mqtt时返回错误，不阻塞调用者。
+ */
+rt_err_t mqtt_push_publish(const char *topic, const char *payload);
+
+#endif /* APPLICATIONS_MQTT_PUSH_H_ */
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include "control.h"
+#include "http_server.h"
+#include "sensor_history.h"
+
+#define EXPORT_BATCH        32      /* 每批读取的记录数 */
+#define EXPORT_PACE_MS      5       /* 批间让出CPU和flash的时间 */
+#define EXPORT_MAGIC        "NHX2"
+
+typedef struct export_out_
+{
+    int sock;
+    rt_size_t len;
+    rt_err_t error;
+    char buf[HTTP_CHUNK_SIZE];
+} export_out_t;
+
+static void export_put(export_out_t *o, const void *data, rt_size_t len)
+{
+    const char *p = data;
+
+    while (len > 0 && o->error == RT_EOK) {
+        rt_size_t n = sizeof(o->buf) - o->len;
+
+        if (n == 0) {
+            o->error = http_chunk_flush(&o->sock, o->buf, o->len);
+            o->len = 0;
+            continue;
+        }
+        if (n > len) {
+            n = len;
+        }
+        rt_memcpy(o->buf + o->len, p, n);
+        o->len += n;
+        p += n;
+        len -= n;
+    }
+}
+
+//zigzag + LEB128变长编码，小的正负差值都只占1字节
+static rt_size_t export_varint(rt_uint8_t *buf, rt_int32_t value)
+{
+    rt_uint32_t u = ((rt_uint32_t)value << 1) ^ (rt_uint32_t)(value >> 31);
+    rt_size_t n = 0;
+
+    while (u >= 0x80) {
+        buf[n++] = (rt_uint8_t)(u | 0x80);
+        u >>= 7;
+    }
+    buf[n++] = (rt_uint8_t)u;
+
+    return n;
+}
+
+static void export_csv(export_out_t *o, const history_record_t *rec, rt_uint8_t decimals)
+{
+    char line[32];
+    rt_size_t n;
+
+    n = json_format_fixed(line, rec->time, 0);
+    line[n++] = ',';
+    n += json_format_fixed(line + n, rec->value, decimals);
+    line[n++] = '\n';
+    export_put(o, line, n);
+}
+
+/*
+ * 二分查找第一条时间晚于since的记录序号。记录按时间追加，.old在前；
+ * 查找期间发生轮转时序号整体平移，重新查找。
+ */
+static rt_uint32_t export_seek(int ch, rt_uint32_t since, rt_uint32_t *gen)
+{
+    history_record_t rec;
+    rt_uint32_t lo, hi, mid, g;
+
+    do {
+        lo = 0;
+        hi = 2 * HISTORY_FILE_RECORDS;
+        sensor_history_read(ch, 0, &rec, 0, gen);
+        while (lo < hi) {
+            mid = lo + (hi - lo) / 2;
+            if (sensor_history_read(ch, mid, &rec, 1, &g) == 1 && rec.time <= since) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        sensor_history_read(ch, 0, &rec, 0, &g);
+    } while (g != *gen);
+
+    return lo;
+}
+
+/*
+ * GET /api/export?ch=soil&fmt=csv|bin&since=T
+ * 只导出时间晚于since的记录，断点续传时传入已收到的最后一条的时间。
+ * 按时间而不是序号续传，两次请求之间文件轮转也不会漏传或重传。
+ * bin格式：魔数"NHX2"、小数位(1字节)、since(4字节小端)，
+ * 之后每条记录为时间差、数值差两个zigzag变长整数，第一条相对0编码。
+ */
+static void export_handler(http_request_t *req)
+{
+    export_out_t out;
+    history_record_t recs[EXPORT_BATCH];
+    history_record_t prev = {0, 0};
+    char key[16], fmt[4], extra[96];
+    rt_int32_t since = 0;
+    rt_uint32_t index, gen, gen_start;
+    rt_bool_t binary;
+    rt_uint8_t decimals;
+    int ch, n, i;
+
+    if (http_query_get(req->query, "ch", key, sizeof(key)) != RT_EOK ||
+        (ch = sensor_history_channel(key)) < 0) {
+        http_send_simple(req->sock, 400, "unknown channel");
+        return;
+    }
+    if (http_query_get(req->query, "fmt", fmt, sizeof(fmt)) != RT_EOK) {
+        rt_strncpy(fmt, "csv", sizeof(fmt));
+    }
+    http_query_int(req->query, "since", &since);
+    if (since < 0) {
+        since = 0;
+    }
+    binary = rt_strcmp(fmt, "bin") == 0;
+    decimals = g_sensor_channels[ch].decimals;
+
+    rt_snprintf(extra, sizeof(extra),
+                "Content-Disposition: attachment; filename=\"%s.%s\"\r\n",
+                key, binary ? "bin" : "csv");
+    if (http_send_header_extra(req->sock, 200, binary ? "application/octet-stream" : "text/csv",
+                               -1, extra) != RT_EOK) {
+        return;
+    }
+
+    out.sock = req->sock;
+    out.len = 0;
+    out.error = RT_EOK;
+    if (binary) {
+        rt_uint8_t head[9];
+
+        rt_memcpy(head, EXPORT_MAGIC, 4);
+        head[4] = decimals;
+        head[5] = since & 0xff;
+        head[6] = (since >> 8) & 0xff;
+        head[7] = (since >> 16) & 0xff;
+        head[8] = (since >> 24) & 0xff;
+        export_put(&out, head, sizeof(head));
+    } else if (since == 0) {
+        export_put(&out, "time,value\n", 11);
+    }
+
+    index = export_seek(ch, since, &gen_start);
+    n = sensor_history_read(ch, index, recs, EXPORT_BATCH, &gen);
+    while (n > 0 && out.error == RT_EOK) {
+        if (gen != gen_start) {
+            //文件轮转导致序号平移，直接断开，让客户端按最后一条的时间续传
+            rt_kprintf("export %s aborted at %d: history rotated\n", key, index);
+            return;
+        }
+        for (i = 0; i < n; i++) {
+            if (binary) {
+                rt_uint8_t buf[10];
+                rt_size_t len;
+
+                len = export_varint(buf, (rt_int32_t)(recs[i].time - prev.time));
+                len += export_varint(buf + len, recs[i].value - prev.value);
+                export_put(&out, buf, len);
+                prev = recs[i];
+            } else {
+                export_csv(&out, &recs[i], decimals);
+            }
+        }
+        index += n;
+
+        //分批读取、批间休眠，不长期占用flash和history锁
+        rt_thread_mdelay(EXPORT_PACE_MS);
+        n = sensor_history_read(ch, index, recs, EXPORT_BATCH, &gen);
+    }
+
+    if (out.error == RT_EOK && out.len > 0) {
+        out.error = http_chunk_flush(&out.sock, out.buf, out.len);
+    }
+    if (out.error == RT_EOK) {
+        http_chunk_end(req->sock);
+    }
+}
+HTTP_ROUTE_EXPORT(export, HTTP_GET, "/api/export", export_handler, HTTP_ROUTE_SLOW);
@@ -0,0 +1,544 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include <dfs_posix.h>
+#include <time.h>
+#include "control.h"
+#include "http_server.h"
+#include "sensor_history.h"
+
+#define HISTORY_READ_BATCH      32
+#define HISTORY_STEP_MAX        86400
+#define HISTORY_SCAN_STOP       1       /* 扫描到to之后的记录，正常结束 */
+
+typedef struct history_bucket_
+{
+    rt_uint32_t time;
+    rt_int64_t sum;                 /* 一天步长最多1440条定点值，int32会溢出 */
+    rt_uint32_t count;
+} history_bucket_t;
+
+// (通道, 步长)结果缓存：环形保存最近的桶，记录当前文件已扫描到的位置以便增量更新
+typedef struct history_cache_
+{
+    rt_int8_t ch;
+    rt_bool_t complete;             /* 没有淘汰过桶，覆盖文件中的全部数据 */
+    rt_uint32_t step;
+    rt_uint32_t gen;
+    off_t offset;
+    rt_uint16_t head;
+    rt_uint16_t num;
+    rt_tick_t used;
+    history_bucket_t buckets[HISTORY_CACHE_POINTS];
+} history_cache_t;
+
+static struct {
+    rt_int64_t sum;                 /* 一分钟内最多65535个采样，int32会溢出 */
+    rt_uint16_t count;
+} history_acc[SENSOR_CHANNEL_MAX];
+
+static rt_uint32_t history_period;
+static rt_uint32_t history_gen[SENSOR_CHANNEL_MAX];
+static rt_bool_t history_dir_ready;
+static rt_mutex_t history_lock;
+static history_cache_t history_cache[HISTORY_CACHE_SLOTS];
+
+static rt_int32_t history_mean(rt_int64_t sum, rt_uint32_t count)
+{
+    rt_int64_t half = count / 2;
+
+    return (rt_int32_t)((sum >= 0 ? sum + half : sum - half) / (rt_int64_t)count);
+}
+
+static void history_path(char *buf, rt_size_t size, rt_size_t ch, rt_bool_t old)
+{
+    rt_snprintf(buf, size, "%s/%s.%s", HISTORY_DIR, g_sensor_channels[ch].key,
+                old ? "old" : "dat");
+}
+
+int sensor_history_channel(const char *key)
+{
+    rt_size_t i;
+
+    for (i = 0; i < g_sensor_channel_num; i++) {
+        if (rt_strcmp(g_sensor_channels[i].key, key) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//把上一分钟的均值追加到各通道文件，文件满后轮转为.old，调用者持有history_lock
+static void history_flush(rt_uint32_t period)
+{
+    history_record_t rec;
+    char path[48];
+    char old_path[48];
+    rt_size_t i;
+
+    if (!history_dir_ready) {
+        mkdir(HISTORY_DIR, 0);
+        history_dir_ready = RT_TRUE;
+    }
+
+    rec.time = period * HISTORY_PERIOD_S;
+    for (i = 0; i < g_sensor_channel_num; i++) {
+        off_t size;
+        int fd, ret;
+
+        if (history_acc[i].count == 0) {
+            continue;
+        }
+        rec.value = history_mean(history_acc[i].sum, history_acc[i].count);
+        history_acc[i].sum = 0;
+        history_acc[i].count = 0;
+
+        history_path(path, sizeof(path), i, RT_FALSE);
+        fd = open(path, O_WRONLY | O_CREAT | O_APPEND);
+        if (fd < 0) {
+            rt_kprintf("open %s failed\n", path);
+            continue;
+        }
+        //记录定长，半条记录会让之后追加的记录全部错位：掉电留下的残尾先截掉，
+        //本次写入不完整时截回写入前的长度
+        size = lseek(fd, 0, SEEK_END);
+        if (size < 0) {
+            close(fd);
+            continue;
+        }
+        if (size % sizeof(rec) != 0) {
+            size -= size % sizeof(rec);
+            ftruncate(fd, size);
+        }
+        ret = write(fd, &rec, sizeof(rec));
+        if (ret != sizeof(rec)) {
+            if (ret > 0) {
+                ftruncate(fd, size);
+            }
+            close(fd);
+            rt_kprintf("write %s failed\n", path);
+            continue;
+        }
+        size += sizeof(rec);
+        close(fd);
+
+        if (size >= (off_t)(HISTORY_FILE_RECORDS * sizeof(rec))) {
+            history_path(old_path, sizeof(old_path), i, RT_TRUE);
+            unlink(old_path);
+            rename(path, old_path);
+            history_gen[i]++;
+        }
+    }
+}
+
+void sensor_history_sample(void)
+{
+    rt_uint32_t period = time(RT_NULL) / HISTORY_PERIOD_S;
+    rt_size_t i;
+
+    //跨分钟时落盘；锁被查询占用就先不落盘，继续累计到旧的分钟里
+    if (period != history_period) {
+        if (history_period == 0) {
+            history_period = period;
+        } else if (rt_mutex_take(history_lock, 0) == RT_EOK) {
+            history_flush(history_period);
+            rt_mutex_release(history_lock);
+            history_period = period;
+        }
+    }
+
+    for (i = 0; i < g_sensor_channel_num; i++) {
+        if (history_acc[i].count == 0xffff) {
+            continue;
+        }
+        history_acc[i].sum += json_float_to_fixed(*g_sensor_channels[i].value,
+                                                  g_sensor_channels[i].decimals);
+        history_acc[i].count++;
+    }
+}
+
+//顺序读取一个记录文件，offset返回已处理到的位置，便于下次增量扫描
+static rt_err_t history_scan_file(const char *path, off_t *offset,
+                                  rt_uint32_t from, rt_uint32_t to,
+                                  history_visit_t visit, void *ctx)
+{
+    history_record_t recs[HISTORY_READ_BATCH];
+    rt_err_t result = RT_EOK;
+    int fd, n, i;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return RT_EOK;
+    }
+    if (*offset > 0) {
+        lseek(fd, *offset, SEEK_SET);
+    }
+
+    while (result == RT_EOK && (n = read(fd, recs, sizeof(recs))) >= (int)sizeof(recs[0])) {
+        rt_bool_t partial = (n % sizeof(recs[0])) != 0;
+
+        n /= sizeof(recs[0]);
+        for (i = 0; i < n && result == RT_EOK; i++) {
+            if (recs[i].time >= to) {
+                result = HISTORY_SCAN_STOP;
+            } else if (recs[i].time >= from) {
+                result = visit(ctx, &recs[i]);
+            }
+        }
+        *offset += i * sizeof(recs[0]);
+        //尾部记录正在被写入，留到下次再读
+        if (partial) {
+            break;
+        }
+    }
+    close(fd);
+
+    return result;
+}
+
+//依次扫描.old和当前文件，调用者持有history_lock
+static rt_err_t history_scan_locked(rt_size_t ch, rt_uint32_t from, rt_uint32_t to,
+                                    history_visit_t visit, void *ctx)
+{
+    char path[48];
+    off_t offset = 0;
+    rt_err_t result;
+
+    history_path(path, sizeof(path), ch, RT_TRUE);
+    result = history_scan_file(path, &offset, from, to, visit, ctx);
+    if (result == RT_EOK) {
+        offset = 0;
+        history_path(path, sizeof(path), ch, RT_FALSE);
+        result = history_scan_file(path, &offset, from, to, visit, ctx);
+    }
+    return result == HISTORY_SCAN_STOP ? RT_EOK : result;
+}
+
+rt_err_t sensor_history_scan(rt_size_t ch, rt_uint32_t from, rt_uint32_t to,
+                             history_visit_t visit, void *ctx)
+{
+    rt_err_t result;
+
+    if (ch >= g_sensor_channel_num) {
+        return -RT_EINVAL;
+    }
+    rt_mutex_take(history_lock, RT_WAITING_FOREVER);
+    result = history_scan_locked(ch, from, to, visit, ctx);
+    rt_mutex_release(history_lock);
+
+    return result;
+}
+
+int sensor_history_read(rt_size_t ch, rt_uint32_t index, history_record_t *recs,
+                        rt_size_t max, rt_uint32_t *gen)
+{
+    char path[48];
+    struct stat st;
+    rt_uint32_t old_num = 0;
+    int fd, n = 0;
+
+    if (ch >= g_sensor_channel_num) {
+        return -RT_EINVAL;
+    }
+
+    rt_mutex_take(history_lock, RT_WAITING_FOREVER);
+    *gen = history_gen[ch];
+
+    history_path(path, sizeof(path), ch, RT_TRUE);
+    if (stat(path, &st) == 0) {
+        old_num = st.st_size / sizeof(history_record_t);
+    }
+    //一次只读一个文件，跨文件边界时返回较少的条数
+    if (index >= old_num) {
+        index -= old_num;
+        history_path(path, sizeof(path), ch, RT_FALSE);
+    } else if (max > old_num - index) {
+        max = old_num - index;
+    }
+
+    fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        lseek(fd, index * sizeof(history_record_t), SEEK_SET);
+        n = read(fd, recs, max * sizeof(history_record_t));
+        n = n > 0 ? n / (int)sizeof(history_record_t) : 0;
+        close(fd);
+    }
+    rt_mutex_release(history_lock);
+
+    return n;
+}
+
+static rt_err_t history_cache_visit(void *ctx, const history_record_t *rec)
+{
+    history_cache_t *c = ctx;
+    rt_uint32_t t = rec->time - rec->time % c->step;
+    history_bucket_t *b;
+
+    if (c->num > 0) {
+        b = &c->buckets[(c->head + c->num - 1) % HISTORY_CACHE_POINTS];
+        if (t == b->time) {
+            b->sum += rec->value;
+            b->count++;
+            return RT_EOK;
+        }
+        //时钟回拨产生的乱序记录直接丢弃
+        if (t < b->time) {
+            return RT_EOK;
+        }
+    }
+    if (c->num == HISTORY_CACHE_POINTS) {
+        c->head = (c->head + 1) % HISTORY_CACHE_POINTS;
+        c->num--;
+        c->complete = RT_FALSE;
+    }
+    b = &c->buckets[(c->head + c->num) % HISTORY_CACHE_POINTS];
+    b->time = t;
+    b->sum = rec->value;
+    b->count = 1;
+    c->num++;
+
+    return RT_EOK;
+}
+
+//取(通道, 步长)对应的缓存并增量扫描新追加的记录，文件轮转后整体重建
+static history_cache_t *history_cache_get(rt_size_t ch, rt_uint32_t step)
+{
+    history_cache_t *c = RT_NULL;
+    char path[48];
+    int i;
+
+    for (i = 0; i < HISTORY_CACHE_SLOTS; i++) {
+        if (history_cache[i].step == step && history_cache[i].ch == (rt_int8_t)ch) {
+            c = &history_cache[i];
+            break;
+        }
+    }
+    //未命中时优先用空闲条目，否则淘汰最久未用的
+    for (i = 0; c == RT_NULL && i < HISTORY_CACHE_SLOTS; i++) {
+        if (history_cache[i].ch < 0) {
+            c = &history_cache[i];
+        }
+    }
+    if (c == RT_NULL) {
+        c = &history_cache[0];
+        for (i = 1; i < HISTORY_CACHE_SLOTS; i++) {
+            if ((rt_int32_t)(history_cache[i].used - c->used) < 0) {
+                c = &history_cache[i];
+            }
+        }
+    }
+
+    if (c->step != step || c->ch != (rt_int8_t)ch || c->gen != history_gen[ch]) {
+        off_t offset = 0;
+
+        c->ch = ch;
+        c->step = step;
+        c->gen = history_gen[ch];
+        c->head = 0;
+        c->num = 0;
+        c->offset = 0;
+        c->complete = RT_TRUE;
+        history_path(path, sizeof(path), ch, RT_TRUE);
+        history_scan_file(path, &offset, 0, 0xffffffff, history_cache_visit, c);
+    }
+
+    history_path(path, sizeof(path), ch, RT_FALSE);
+    history_scan_file(path, &c->offset, 0, 0xffffffff, history_cache_visit, c);
+    c->used = rt_tick_get();
+
+    return c;
+}
+
+static void history_emit(json_writer_t *w, rt_uint32_t time, rt_int32_t value, rt_uint8_t decimals)
+{
+    json_array_begin(w);
+    json_int(w, time);
+    json_fixed(w, value, decimals);
+    json_array_end(w);
+}
+
+//在锁内从缓存复制[next, to)内最多max个桶的均值，缓存已淘汰next所在的桶时返回-1
+static int history_cache_copy(rt_size_t ch, rt_uint32_t step, rt_uint32_t next, rt_uint32_t to,
+                              history_record_t *out, int max)
+{
+    history_cache_t *c;
+    int i, n = 0;
+
+    rt_mutex_take(history_lock, RT_WAITING_FOREVER);
+    c = history_cache_get(ch, step);
+    if (c->num > 0 && !c->complete && next < c->buckets[c->head].time) {
+        n = -1;
+    }
+    for (i = 0; n >= 0 && n < max && i < c->num; i++) {
+        const history_bucket_t *b = &c->buckets[(c->head + i) % HISTORY_CACHE_POINTS];
+
+        if (b->time >= next && b->time < to) {
+            out[n].time = b->time;
+            out[n].value = history_mean(b->sum, b->count);
+            n++;
+        }
+    }
+    rt_mutex_release(history_lock);
+
+    return n;
+}
+
+//超出缓存范围的长时段查询：每批记录只在读取时持锁，聚合和发送都在锁外进行
+static void history_stream(json_writer_t *w, rt_size_t ch, rt_uint32_t step,
+                           rt_uint32_t from, rt_uint32_t to)
+{
+    history_record_t recs[HISTORY_READ_BATCH];
+    history_bucket_t cur;
+    rt_uint8_t decimals = g_sensor_channels[ch].decimals;
+    rt_uint32_t index = 0, gen, last_gen = 0;
+    rt_uint32_t after = from;
+    int n, i;
+
+    cur.count = 0;
+    //客户端断开后没必要继续读flash
+    while (w->error == RT_EOK) {
+        n = sensor_history_read(ch, index, recs, HISTORY_READ_BATCH, &gen);
+        //文件轮转后序号整体平移，从头重扫，after之前的记录已经处理过
+        if (index > 0 && gen != last_gen) {
+            index = 0;
+            last_gen = gen;
+            continue;
+        }
+        last_gen = gen;
+        if (n <= 0) {
+            break;
+        }
+        index += n;
+
+        for (i = 0; i < n; i++) {
+            rt_uint32_t t;
+
+            //时钟回拨产生的乱序记录直接丢弃，与缓存的处理一致
+            if (recs[i].time < after) {
+                continue;
+            }
+            if (recs[i].time >= to) {
+                break;
+            }
+            after = recs[i].time + 1;
+
+            t = recs[i].time - recs[i].time % step;
+            if (cur.count > 0 && t != cur.time) {
+                history_emit(w, cur.time, history_mean(cur.sum, cur.count), decimals);
+                cur.count = 0;
+            }
+            if (cur.count == 0) {
+                cur.time = t;
+                cur.sum = 0;
+            }
+            cur.sum += recs[i].value;
+            cur.count++;
+        }
+        if (i < n) {
+            break;
+        }
+    }
+    if (cur.count > 0) {
+        history_emit(w, cur.time, history_mean(cur.sum, cur.count), decimals);
+    }
+}
+
+//GET /api/history?ch=soil&from=..&to=..&step=..
+static void history_handler(http_request_t *req)
+{
+    const char *query = req->query;
+    int sock = req->sock;
+    history_record_t points[HISTORY_READ_BATCH];
+    char chunk[HTTP_CHUNK_SIZE];
+    json_writer_t w;
+    char key[16];
+    rt_int32_t from, to, step;
+    rt_uint32_t now = time(RT_NULL);
+    rt_uint32_t next;
+    int ch, n, i;
+
+    if (http_query_get(query, "ch", key, sizeof(key)) != RT_EOK ||
+        (ch = sensor_history_channel(key)) < 0) {
+        http_send_simple(sock, 400, "unknown channel");
+        return;
+    }
+    if (http_query_int(query, "to", &to) != RT_EOK) {
+        to = now;
+    }
+    if (http_query_int(query, "from", &from) != RT_EOK) {
+        from = to - 86400;
+    }
+    if (http_query_int(query, "step", &step) != RT_EOK) {
+        step = 300;
+    }
+    //步长对齐到落盘周期
+    step = step - step % HISTORY_PERIOD_S;
+    if (step < HISTORY_PERIOD_S) {
+        step = HISTORY_PERIOD_S;
+    } else if (step > HISTORY_STEP_MAX) {
+        step = HISTORY_STEP_MAX;
+    }
+    if (from < 0 || from >= to) {
+        http_send_simple(sock, 400, "bad range");
+        return;
+    }
+
+    //发送可能被慢速客户端阻塞，只在复制数据时持锁，不能让落盘和其他查询等着socket
+    http_send_header(sock, 200, "application/json", -1);
+    json_writer_init(&w, chunk, sizeof(chunk), http_chunk_flush, &sock);
+    json_object_begin(&w);
+    json_key(&w, "ch");
+    json_string(&w, key);
+    json_key(&w, "step");
+    json_int(&w, step);
+    json_key(&w, "points");
+    json_array_begin(&w);
+
+    //缓存命中时分批复制桶均值，不再扫描flash；缓存覆盖不到的部分改为扫描文件
+    next = from - from % step;
+    while (w.error == RT_EOK) {
+        n = history_cache_copy(ch, step, next, to, points, HISTORY_READ_BATCH);
+        if (n < 0) {
+            history_stream(&w, ch, step, next, to);
+            break;
+        }
+        for (i = 0; i < n; i++) {
+            history_emit(&w, points[i].time, points[i].value, g_sensor_channels[ch].decimals);
+        }
+        if (n < HISTORY_READ_BATCH) {
+            break;
+        }
+        next = points[n - 1].time + step;
+    }
+
+    json_array_end(&w);
+    json_object_end(&w);
+    if (json_writer_finish(&w) == RT_EOK) {
+        http_chunk_end(sock);
+    }
+}
+HTTP_ROUTE_EXPORT(history, HTTP_GET, "/api/history", history_handler, HTTP_ROUTE_SLOW);
+
+static int sensor_history_init(void)
+{
+    int i;
+
+    for (i = 0; i < HISTORY_CACHE_SLOTS; i++) {
+        history_cache[i].ch = -1;
+    }
+
+    history_lock = rt_mutex_create("hist_lock", RT_IPC_FLAG_FIFO);
+    if (history_lock == RT_NULL) {
+        rt_kprintf("create hist_lock failed\n");
+        return -RT_ERROR;
+    }
+    return RT_EOK;
+}
+INIT_COMPONENT_EXPORT(sensor_history_init);
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_SENSOR_HISTORY_H_
+#define APPLICATIONS_SENSOR_HISTORY_H_
+
+#include <rtthread.h>
+
+#define HISTORY_DIR             "/flash/history"
+#define HISTORY_PERIOD_S        60                      /* 每分钟落盘一条均值 */
+#define HISTORY_FILE_RECORDS    (7 * 24 * 60)           /* 单文件保存7天，满后轮转为.old */
+#define HISTORY_CACHE_SLOTS     4                       /* (通道, 步长)缓存条目数 */
+#define HISTORY_CACHE_POINTS    288                     /* 每条缓存最多保存的桶数 */
+
+// 落盘记录：分钟起始时间 + 按通道精度放大后的定点均值
+typedef struct history_record_
+{
+    rt_uint32_t time;
+    rt_int32_t value;
+} history_record_t;
+
+// 扫描回调，返回非RT_EOK时中止扫描
+typedef rt_err_t (*history_visit_t)(void *ctx, const history_record_t *rec);
+
+// 控制线程每次更新sensor_data后调用，跨分钟时把均值追加到文件
+void sensor_history_sample(void);
+
+// 按时间顺序遍历[from, to)内的记录
+rt_err_t sensor_history_scan(rt_size_t ch, rt_uint32_t from, rt_uint32_t to,
+                             history_visit_t visit, void *ctx);
+
+// 按全局序号读取记录（.old在前，当前文件在后），只在读取期间持锁
+// gen返回文件轮转计数，两次调用间变化说明序号已整体平移
+int sensor_history_read(rt_size_t ch, rt_uint32_t index, history_record_t *recs,
+                        rt_size_t max, rt_uint32_t *gen);
+
+// 按键名查找通道下标，找不到返回-1
+int sensor_history_channel(const char *key);
+
+#endif /* APPLICATIONS_SENSOR_HISTORY_H_ */
@@ -14,11 +14,24 @@
 #include "board.h"
 #include "sensor.h"
 #include "sensor_msg.h"
+#include "metrics.h"
 
 rt_mq_t sensor_msg_mq;
 rt_mutex_t sensor_msg_mutex;
 rt_sem_t sensor_msg_sem_empty;
 rt_mailbox_t sensor_msg_mb;
+struct sensor_msg_stats sensor_msg_stats;
+
+METRIC_EXPORT(sensor_sent, "sensor_messages_sent_total", RT_NULL, METRIC_COUNTER,
+              "Sensor samples queued to the control thread", &sensor_msg_stats.sent);
+METRIC_EXPORT(sensor_drop, "sensor_messages_dropped_total", RT_NULL, METRIC_COUNTER,
+              "Sensor samples lost to allocation or queue failures", &sensor_msg_stats.dropped);
+METRIC_EXPORT(sensor_recv, "sensor_messages_processed_total", RT_NULL, METRIC_COUNTER,
+              "Sensor samples applied by the control thread", &sensor_msg_stats.received);
+METRIC_EXPORT(sensor_lat, "sensor_latency_seconds_total", RT_NULL, METRIC_COUNTER | METRIC_TICKS,
+              "Accumulated time from sampling to processing", &sensor_msg_stats.latency_total);
+METRIC_EXPORT(sensor_lat_max, "sensor_latency_max_seconds", RT_NULL, METRIC_GAUGE | METRIC_TICKS,
+              "Longest time from sampling to processing", &sensor_msg_stats.latency_max);
 
 char *const g_sensor_name_str[] = {
     "light_outside",
@@ -27,6 +40,10 @@ char *const g_sensor_name_str[] = {
     "humi_earth",
     "fan_top",
     "water_pump",
+    "manual_ctrl",
+    "growth_stage",
+    "growth_conf",
+    "pest_detect",
 };
 
 rt_err_t sensor_msg_mq_creat(void)
@@ -81,6 +98,63 @@ __exit:
 }
 INIT_COMPONENT_EXPORT(sensor_msg_mq_creat);
 
+rt_err_t sensor_msg_publish(sensor_id_t id, float value, rt_int32_t timeout)
+{
+    return sensor_msg_publish_batch(&id, &value, 1, timeout);
+}
+
+rt_err_t sensor_msg_publish_batch(const sensor_id_t *ids, const float *values, int n,
+                                  rt_int32_t timeout)
+{
+    sensor_msg_t *msg[SENSOR_MSG_BATCH_MAX];
+    rt_err_t result = RT_EOK;
+    int taken, i;
+
+    if (n <= 0 || n > SENSOR_MSG_BATCH_MAX) {
+        return -RT_EINVAL;
+    }
+    // 先占够空位和内存，中途失败时全部退回
+    for (taken = 0; taken < n; taken++) {
+        if (rt_sem_take(sensor_msg_sem_empty, timeout) != RT_EOK) {
+            result = -RT_ETIMEOUT;
+            break;
+        }
+        msg[taken] = rt_malloc(sizeof(sensor_msg_t));
+        if (msg[taken] == RT_NULL) {
+            rt_sem_release(sensor_msg_sem_empty);
+            result = -RT_ENOMEM;
+            break;
+        }
+    }
+    if (result != RT_EOK) {
+        for (i = 0; i < taken; i++) {
+            rt_free(msg[i]);
+            rt_sem_release(sensor_msg_sem_empty);
+        }
+        sensor_msg_stats.dropped += n;
+        return result;
+    }
+
+    // 队列长度大于信号量计数，占到空位后入队不会失败
+    rt_mutex_take(sensor_msg_mutex, RT_WAITING_FOREVER);
+    for (i = 0; i < n; i++) {
+        msg[i]->timestamp = rt_tick_get();
+        msg[i]->sensor_id = ids[i];
+        msg[i]->value = values[i];
+        if (rt_mq_send(sensor_msg_mq, &msg[i], sizeof(sensor_msg_t *)) != RT_EOK) {
+            sensor_msg_stats.dropped++;
+            rt_sem_release(sensor_msg_sem_empty);
+            rt_free(msg[i]);
+            result = -RT_EFULL;
+            continue;
+        }
+        sensor_msg_stats.sent++;
+    }
+    rt_mutex_release(sensor_msg_mutex);
+
+    return result;
+}
+
 //
 //#include <rtthread.h>第一版本
 //#include <rtdevice.h>
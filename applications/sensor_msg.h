@@ -33,6 +33,9 @@ typedef enum sensor_id_
    FNA_TOP,
    WATER_PUMP,
    MANUAL_CTRL,
+   GROWTH_STAGE,        /* 视觉模型输出的生长阶段编号 */
+   GROWTH_CONF,         /* 生长阶段的置信度 0~1 */
+   PEST_DETECT,         /* 视觉跟踪确认的虫害目标数，0为已消失 */
 }sensor_id_t;
 
 typedef enum control_id_
@@ -49,6 +52,18 @@ typedef struct sensor_msg_
 }sensor_msg_t;
 
 
+// 传感器消息管道统计，生产者在发送成功/失败时计数，控制线程统计处理延迟
+struct sensor_msg_stats
+{
+    rt_uint32_t sent;
+    rt_uint32_t dropped;            /* 分配失败或入队失败 */
+    rt_uint32_t received;
+    rt_uint32_t latency_total;      /* 采样到处理的累计tick */
+    rt_uint32_t latency_max;
+};
+
+extern struct sensor_msg_stats sensor_msg_stats;
+
 extern rt_mq_t sensor_msg_mq;
 
 extern rt_mutex_t sensor_msg_mutex;
@@ -62,6 +77,13 @@ extern uint8_t g_manual_ctrl;
 extern rt_mailbox_t sensor_msg_mb;
 
 rt_err_t sensor_msg_mq_creat(void);
+#define SENSOR_MSG_BATCH_MAX 4
+
+// 发送一条传感器消息，队列满时最多等待timeout个tick，供不能长期阻塞的生产者使用
+rt_err_t sensor_msg_publish(sensor_id_t id, float value, rt_int32_t timeout);
+// 同上，一次发送n条，先占够空位再一起入队：要么全部发出，要么一条都不发
+rt_err_t sensor_msg_publish_batch(const sensor_id_t *ids, const float *values, int n,
+                                  rt_int32_t timeout);
 
 
 #endif /* APPLICATIONS_SENSOR_MSG_H_ */
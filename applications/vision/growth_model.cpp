@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include "vision_task.h"
+#include "vision_model.h"
+
+#ifdef VISION_TASK_GROWTH
+
+#include "growth_model_ops.h"
+
+/*
+ * 模型数据可以编进固件（tools/tflite_ops.py从models/growth.tflite生成growth_model.h），
+ * 也可以不编进来，由vision_store从XIP槽、fal分区或SD卡载入。
+ */
+#if __has_include("growth_model.h")
+#include "growth_model.h"
+VISION_MODEL_DEFINE(growth_model, "growth", g_growth_tflite, g_growth_tflite_len, GROWTH_MODEL_OPS);
+#else
+VISION_MODEL_DEFINE(growth_model, "growth", nullptr, 0, GROWTH_MODEL_OPS);
+#endif
+
+#endif
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_GROWTH_MODEL_OPS_H_
+#define APPLICATIONS_VISION_GROWTH_MODEL_OPS_H_
+
+// models/growth.tflite存在时由tools/tflite_ops.py按模型重新生成
+// 生长阶段分类模型（MobileNet风格int8小网络）图中出现的算子
+#define GROWTH_MODEL_OPS(OP)                                                        \
+    OP(AveragePool2D)                                                               \
+    OP(Conv2D)                                                                      \
+    OP(DepthwiseConv2D)                                                             \
+    OP(FullyConnected)                                                              \
+    OP(Reshape)                                                                     \
+    OP(Softmax)
+
+#endif /* APPLICATIONS_VISION_GROWTH_MODEL_OPS_H_ */
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include "vision_task.h"
+#include "vision_track.h"
+#include "vision_event.h"
+
+#ifdef VISION_TASK_GROWTH
+
+#define GROWTH_STAGE_NUM        3
+#define GROWTH_PERIOD_MS        1000
+
+static const char *const growth_stage_name[GROWTH_STAGE_NUM] =
+{
+    "seedling",
+    "vegetative",
+    "flowering",
+};
+
+// 阶段变化以天计，平滑可以很重：约10帧的平均，连续5帧领先才切换
+static const vision_track_cfg_t growth_track_cfg = {
+    .classes       = GROWTH_STAGE_NUM,
+    .alpha         = 0.1f,
+    .on_threshold  = 0.5f,
+    .debounce      = 5,
+};
+
+static struct
+{
+    int stage;                      /* 已发布的阶段 */
+    float confidence;
+    rt_uint32_t count[GROWTH_STAGE_NUM];
+    vision_track_t track;
+} growth = {-1};
+
+static float growth_prob(const vision_tensor_t *output, int i)
+{
+    switch (output->type) {
+    case VISION_TYPE_INT8:
+        return (((const int8_t *)output->data)[i] - output->zero_point) * output->scale;
+    case VISION_TYPE_UINT8:
+        return (((const uint8_t *)output->data)[i] - output->zero_point) * output->scale;
+    default:
+        return ((const float *)output->data)[i];
+    }
+}
+
+static int growth_setup(const vision_tensor_t *input, const vision_tensor_t *output)
+{
+    int n = output->ndims > 0 ? output->dims[output->ndims - 1] : 0;
+
+    // 前三个输出为各阶段的softmax概率，后面可以跟病害等附加标志
+    if (input->ndims != 4 || input->dims[3] != 3 || n < GROWTH_STAGE_NUM ||
+        output->type == VISION_TYPE_OTHER) {
+        return -1;
+    }
+    vision_track_init(&growth.track, &growth_track_cfg);
+    return 0;
+}
+
+static void growth_process(const vision_tensor_t *output)
+{
+    float prob[GROWTH_STAGE_NUM];
+    int raw = 0, stage, i;
+
+    for (i = 0; i < GROWTH_STAGE_NUM; i++) {
+        prob[i] = growth_prob(output, i);
+        if (prob[i] > prob[raw]) {
+            raw = i;
+        }
+    }
+    growth.count[raw]++;
+
+    // 只在平滑后的阶段切换时发布；队列满没发出去时，下一帧和已发布的状态比较会重发
+    vision_track_top(&growth.track, prob);
+    stage = growth.track.top;
+    if (stage < 0 || stage == growth.stage) {
+        return;
+    }
+    if (vision_event_stage(stage, growth_stage_name[stage], growth.track.ema[stage]) != RT_EOK) {
+        return;
+    }
+    rt_kprintf("growth stage: %s (%d%%)\n", growth_stage_name[stage],
+               (int)(growth.track.ema[stage] * 100));
+    growth.stage = stage;
+    growth.confidence = growth.track.ema[stage];
+}
+
+static void growth_report(void)
+{
+    int i;
+
+    rt_kprintf("stage      : %s, confidence %d%%\n",
+               growth.stage >= 0 ? growth_stage_name[growth.stage] : "-",
+               (int)(growth.confidence * 100));
+    for (i = 0; i < GROWTH_STAGE_NUM; i++) {
+        rt_kprintf("  %-10s %u frames, average %d%%\n", growth_stage_name[i], growth.count[i],
+                   (int)(growth.track.ema[i] * 100));
+    }
+    rt_kprintf("switches   : %u\n", growth.track.transitions);
+}
+
+const vision_task_t growth_task =
+{
+    "growth",
+    &growth_model,
+    GROWTH_PERIOD_MS,
+    growth_setup,
+    growth_process,
+    growth_report,
+};
+
+#endif /* VISION_TASK_GROWTH */
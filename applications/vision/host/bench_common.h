@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+
+/*
+ * 主机基准共用的计时、伪随机数和合成输出帧。只在主机上编译，各基准
+ * 直接包含，不单独编译。
+ */
+#ifndef __BENCH_COMMON_H__
+#define __BENCH_COMMON_H__
+
+#include <stdint.h>
+#include <math.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define bench_cycles()      __rdtsc()
+#else
+#define bench_cycles()      0ull
+#endif
+
+#define BENCH_CLASSES       80
+#define BENCH_STRIDE        (BENCH_CLASSES + 5)
+#define BENCH_OBJECTS       6           /* 合成的目标个数，每个目标周围有一簇重叠的框 */
+
+// 线性同余发生器，各基准的输入都由固定种子生成，结果可重复
+static inline uint32_t bench_rand(uint32_t *seed)
+{
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed;
+}
+
+static inline int8_t bench_quant(float v, float scale, int32_t zero_point)
+{
+    int q = (int)lroundf(v / scale) + zero_point;
+
+    return q < -128 ? -128 : (q > 127 ? 127 : q);
+}
+
+// 每个元素填入[lo, lo + span)之间的随机值
+static inline void bench_synth_noise(int8_t *data, int rows, float lo, float span, float scale, int32_t zero_point)
+{
+    uint32_t seed = 5;
+    int r, c;
+
+    for (r = 0; r < rows; r++) {
+        int8_t *p = data + r * BENCH_STRIDE;
+
+        for (c = 0; c < BENCH_STRIDE; c++) {
+            p[c] = bench_quant(lo + (bench_rand(&seed) >> 16 & 0xff) / 255.0f * span, scale, zero_point);
+        }
+    }
+}
+
+/*
+ * 合成一帧已解码的输出：各列是sigmoid后的概率和归一化坐标，背景为低分噪声，
+ * BENCH_OBJECTS个目标各有cluster个重叠的框，分散在不同的行上。spread为0时
+ * 一簇框只差置信度，NMS后每个目标剩一个框；为1时框的位置和大小逐个错开。
+ */
+static inline void bench_synth_decoded(int8_t *data, int rows, int cluster, float spread, float scale,
+                                       int32_t zero_point)
+{
+    int c, k;
+
+    bench_synth_noise(data, rows, 0, 0.05f, scale, zero_point);
+    for (k = 0; k < BENCH_OBJECTS; k++) {
+        for (c = 0; c < cluster; c++) {
+            int8_t *p = data + ((k * 997 + c * 3) % rows) * BENCH_STRIDE;
+
+            p[0] = bench_quant(0.15f + 0.14f * k + 0.002f * c, scale, zero_point);
+            p[1] = bench_quant(0.5f - 0.01f * spread * c, scale, zero_point);
+            p[2] = bench_quant(0.1f + 0.004f * spread * c, scale, zero_point);
+            p[3] = bench_quant(0.2f, scale, zero_point);
+            p[4] = bench_quant(0.95f - 0.01f * c, scale, zero_point);
+            p[5 + (k * 13) % BENCH_CLASSES] = bench_quant(0.9f - 0.03f * spread * k, scale, zero_point);
+        }
+    }
+}
+
+#endif /* __BENCH_COMMON_H__ */
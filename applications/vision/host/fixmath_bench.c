@@ -0,0 +1,418 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+
+/*
+ * vision_fix和定点yolo_post对浮点参考的误差验证与耗时基准：
+ * sigmoid/exp插值、int8查表、IoU逐个比较最大误差（单位为Q15的LSB），
+ * yolo_post_decode在已解码输出和原始输出（带锚框）两种形式上与浮点
+ * 参考解码逐框比较。误差超出下限时返回1。
+ * 浮点参考是逐行处理的朴素算法，和定点解码不是同一种算法，只用来比较
+ * 结果，不比较耗时；同一运算的浮点与定点耗时见最后几行。
+ *
+ * 编译：gcc -O2 -DVISION_HOST -I.. fixmath_bench.c ../vision_fix.c ../yolo_post.c -lm -o fixmath_bench
+ * 用法：fixmath_bench [轮数，默认200]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "yolo_post.h"
+#include "bench_common.h"
+
+#define LSB(v)              ((v) * VISION_FIX_ONE)
+#define PAIRS               4096
+#define CLASSES             BENCH_CLASSES
+#define STRIDE              BENCH_STRIDE
+#define INPUT               160
+#define BOX_MAX             16
+
+// 各项允许的最大误差，单位为Q15的LSB
+#define SIGMOID_TOL         2.5
+#define EXP_TOL             2.0
+#define LUT_TOL             0.6         /* 表在float下生成，比取整多一点 */
+#define IOU_TOL             1.0
+
+static const yolo_post_head_t head = {
+    3, {8, 16, 32},
+    {{{10, 13}, {16, 30}, {33, 23}}, {{30, 61}, {62, 45}, {59, 119}}, {{116, 90}, {156, 198}, {373, 326}}},
+};
+
+static volatile int32_t sink;
+static volatile float sink_f;
+static int failed;
+
+static void report(const char *what, double err, double tol)
+{
+    printf("%-22s max error %6.3f LSB %s\n", what, err, err <= tol ? "ok" : "FAIL");
+    if (err > tol) {
+        failed = 1;
+    }
+}
+
+static void check_sigmoid_exp(void)
+{
+    double err_sig = 0, err_exp = 0;
+    int32_t x;
+
+    for (x = -20 * 4096; x <= 20 * 4096; x++) {
+        double ref = LSB(1.0 / (1.0 + exp(-x / 4096.0)));
+        double e = fabs(vision_fix_sigmoid(x) - ref);
+
+        err_sig = e > err_sig ? e : err_sig;
+        if (x <= 0) {
+            e = fabs(vision_fix_exp(x) - LSB(exp(x / 4096.0)));
+            err_exp = e > err_exp ? e : err_exp;
+        }
+    }
+    report("sigmoid (Q12 interp)", err_sig, SIGMOID_TOL);
+    report("exp (Q12 interp)", err_exp, EXP_TOL);
+}
+
+static void check_lut(void)
+{
+    static const float scales[] = {1.0f / 255, 0.02f, 0.08f, 0.2f};
+    static const int32_t zero_points[] = {-128, -20, 0, 37};
+    vision_fix_lut_t lut = {0};
+    double err[3] = {0};
+    int f, s, z, q;
+
+    for (f = VISION_FIX_LINEAR; f <= VISION_FIX_EXP; f++) {
+        for (s = 0; s < 4; s++) {
+            for (z = 0; z < 4; z++) {
+                vision_fix_lut_update(&lut, scales[s], zero_points[z], f);
+                for (q = -128; q <= 127; q++) {
+                    double x = (q - zero_points[z]) * (double)scales[s];
+                    double ref = f == VISION_FIX_SIGMOID ? 1.0 / (1.0 + exp(-x)) :
+                                 f == VISION_FIX_EXP ? exp(x) : x;
+                    double e;
+
+                    if (fabs(ref) > 32.0) {
+                        continue;       /* 超出LUT的饱和范围 */
+                    }
+                    e = fabs(vision_fix_lut_s8(&lut, q) - LSB(ref));
+                    err[f] = e > err[f] ? e : err[f];
+                }
+            }
+        }
+    }
+    report("int8 lut linear", err[VISION_FIX_LINEAR], LUT_TOL);
+    report("int8 lut sigmoid", err[VISION_FIX_SIGMOID], LUT_TOL);
+    report("int8 lut exp", err[VISION_FIX_EXP], LUT_TOL);
+}
+
+static float iou_float(const yolo_box_t *a, const yolo_box_t *b)
+{
+    float w = fminf(a->x1, b->x1) - fmaxf(a->x0, b->x0);
+    float h = fminf(a->y1, b->y1) - fmaxf(a->y0, b->y0);
+    float inter;
+
+    if (w <= 0 || h <= 0) {
+        return 0;
+    }
+    inter = w * h;
+    return inter / ((float)(a->x1 - a->x0) * (a->y1 - a->y0) + (float)(b->x1 - b->x0) * (b->y1 - b->y0) - inter);
+}
+
+static yolo_box_t pairs[PAIRS][2];
+
+static void make_pairs(void)
+{
+    uint32_t seed = 11;
+    int i, k;
+
+    for (i = 0; i < PAIRS; i++) {
+        for (k = 0; k < 2; k++) {
+            yolo_box_t *b = &pairs[i][k];
+
+            bench_rand(&seed);
+            b->x0 = (seed >> 8) % 600;
+            b->y0 = (seed >> 18) % 440;
+            bench_rand(&seed);
+            // 一半的框接近，保证有大量重叠的对
+            if (k == 1 && (i & 1)) {
+                b->x0 = pairs[i][0].x0 + (int)((seed >> 4) % 21) - 10;
+                b->y0 = pairs[i][0].y0 + (int)((seed >> 12) % 21) - 10;
+                b->x0 = b->x0 < 0 ? 0 : b->x0;
+                b->y0 = b->y0 < 0 ? 0 : b->y0;
+            }
+            b->x1 = b->x0 + 1 + (seed >> 8) % 640;
+            b->y1 = b->y0 + 1 + (seed >> 20) % 480;
+        }
+    }
+}
+
+static void check_iou(void)
+{
+    double err = 0;
+    int i;
+
+    for (i = 0; i < PAIRS; i++) {
+        double e = fabs(yolo_post_iou(&pairs[i][0], &pairs[i][1]) - LSB((double)iou_float(&pairs[i][0], &pairs[i][1])));
+
+        err = e > err ? e : err;
+    }
+    report("iou", err, IOU_TOL);
+}
+
+/*
+ * 合成一帧输出。decoded为1时用共用的已解码帧；否则为原始值，行数由head决定，
+ * 每簇框落在同一个格子的相邻锚框上。
+ */
+static int synth_frame(int8_t *data, int rows, int decoded, float scale, int32_t zero_point)
+{
+    int c, k;
+
+    if (decoded) {
+        bench_synth_decoded(data, rows, 8, 1, scale, zero_point);
+        return rows;
+    }
+    bench_synth_noise(data, rows, -6.0f, 3.0f, scale, zero_point);
+    for (k = 0; k < BENCH_OBJECTS; k++) {
+        for (c = 0; c < 8; c++) {
+            // 第1层20x20的格子，锚框c % 3，格子沿x方向错开
+            int cell = (k * 3 + 2) * 20 + 4 + k + c / 3;
+            int8_t *p = data + ((c % 3) * 400 + cell) * STRIDE;
+
+            p[0] = bench_quant(0.2f * c - 0.5f, scale, zero_point);
+            p[1] = bench_quant(0.3f, scale, zero_point);
+            p[2] = bench_quant(0.5f, scale, zero_point);
+            p[3] = bench_quant(0.4f, scale, zero_point);
+            p[4] = bench_quant(4.0f - 0.3f * c, scale, zero_point);
+            p[5 + (k * 13) % CLASSES] = bench_quant(3.0f - 0.25f * k, scale, zero_point);
+        }
+    }
+    return rows;
+}
+
+typedef struct
+{
+    float score;
+    int row;
+    int cls;
+} ref_cand_t;
+
+static int ref_cand_cmp(const void *a, const void *b)
+{
+    float d = ((const ref_cand_t *)b)->score - ((const ref_cand_t *)a)->score;
+
+    return d > 0 ? 1 : (d < 0 ? -1 : 0);
+}
+
+static int16_t ref_clamp(float v, int limit)
+{
+    v = floorf(v + 0.5f);
+    return v < 0 ? 0 : (v > limit ? limit : (int16_t)v);
+}
+
+// 浮点参考：逐行反量化（和sigmoid），排序，浮点解码和浮点IoU的NMS
+static int ref_decode(const vision_tensor_t *t, const yolo_post_cfg_t *cfg, yolo_box_t *boxes, int max)
+{
+    static ref_cand_t cand[8192];
+    const int8_t *data = t->data;
+    int rows = (int)(t->bytes / STRIDE), num = 0, kept = 0, r, c, i, j;
+
+#define DEQ(q)  (cfg->head ? 1.0f / (1.0f + expf(-((q) - t->zero_point) * t->scale)) : \
+                 ((q) - t->zero_point) * t->scale)
+    for (r = 0; r < rows; r++) {
+        const int8_t *p = data + r * STRIDE;
+        float best = -1;
+        int cls = 0;
+
+        for (c = 0; c < CLASSES; c++) {
+            if (DEQ(p[5 + c]) > best) {
+                best = DEQ(p[5 + c]);
+                cls = c;
+            }
+        }
+        if (DEQ(p[4]) * best >= cfg->conf_threshold && num < (int)(sizeof(cand) / sizeof(cand[0]))) {
+            cand[num].score = DEQ(p[4]) * best;
+            cand[num].row = r;
+            cand[num].cls = cls;
+            num++;
+        }
+    }
+    qsort(cand, num, sizeof(cand[0]), ref_cand_cmp);
+    if (num > YOLO_POST_CAND_MAX) {
+        num = YOLO_POST_CAND_MAX;
+    }
+
+    for (i = 0; i < num && kept < max; i++) {
+        const int8_t *p = data + cand[i].row * STRIDE;
+        yolo_box_t *box = &boxes[kept];
+        float cx, cy, w, h;
+
+        if (cfg->head == NULL) {
+            cx = DEQ(p[0]) * cfg->width;
+            cy = DEQ(p[1]) * cfg->height;
+            w = DEQ(p[2]) * cfg->width;
+            h = DEQ(p[3]) * cfg->height;
+        } else {
+            int row = cand[i].row, l = 0, gw, cells;
+
+            for (;;) {
+                gw = cfg->width / head.stride[l];
+                cells = gw * (cfg->height / head.stride[l]);
+                if (row < YOLO_POST_ANCHORS * cells) {
+                    break;
+                }
+                row -= YOLO_POST_ANCHORS * cells;
+                l++;
+            }
+            cx = (2 * DEQ(p[0]) - 0.5f + (row % cells) % gw) * head.stride[l];
+            cy = (2 * DEQ(p[1]) - 0.5f + (row % cells) / gw) * head.stride[l];
+            w = 4 * DEQ(p[2]) * DEQ(p[2]) * head.anchors[l][row / cells][0];
+            h = 4 * DEQ(p[3]) * DEQ(p[3]) * head.anchors[l][row / cells][1];
+        }
+        box->x0 = ref_clamp(cx - w / 2, cfg->width);
+        box->y0 = ref_clamp(cy - h / 2, cfg->height);
+        box->x1 = ref_clamp(cx + w / 2, cfg->width);
+        box->y1 = ref_clamp(cy + h / 2, cfg->height);
+        box->cls = cand[i].cls;
+        box->score = cand[i].score;
+        for (j = 0; j < kept; j++) {
+            if (boxes[j].cls == box->cls && iou_float(&boxes[j], box) > cfg->iou_threshold) {
+                break;
+            }
+        }
+        if (j == kept) {
+            kept++;
+        }
+    }
+#undef DEQ
+    return kept;
+}
+
+// 分数相同的框在堆和qsort里的先后不定，比较前按分数、类别、坐标排好
+static int box_cmp(const void *a, const void *b)
+{
+    const yolo_box_t *x = a, *y = b;
+
+    if (x->score != y->score) {
+        return x->score < y->score ? 1 : -1;
+    }
+    if (x->cls != y->cls) {
+        return x->cls - y->cls;
+    }
+    return x->x0 != y->x0 ? x->x0 - y->x0 : x->y0 - y->y0;
+}
+
+static void check_decode(const char *what, int rows, const yolo_post_head_t *h, float scale,
+                         int32_t zero_point, int frames)
+{
+    yolo_post_cfg_t cfg = {CLASSES, 0.5f, 0.45f, INPUT, INPUT, h};
+    yolo_box_t ref[BOX_MAX], fix[BOX_MAX];
+    vision_tensor_t t;
+    unsigned long long c0, c1;
+    double err_px = 0, err_score = 0;
+    int n_ref, n_fix = 0, i;
+
+    memset(&t, 0, sizeof(t));
+    t.data = malloc((size_t)rows * STRIDE);
+    t.bytes = (size_t)rows * STRIDE;
+    t.type = VISION_TYPE_INT8;
+    t.scale = scale;
+    t.zero_point = zero_point;
+    synth_frame(t.data, rows, h == NULL, scale, zero_point);
+
+    n_ref = ref_decode(&t, &cfg, ref, BOX_MAX);
+    c0 = bench_cycles();
+    for (i = 0; i < frames; i++) {
+        n_fix = yolo_post_decode(&t, &cfg, fix, BOX_MAX);
+    }
+    c1 = bench_cycles();
+
+    qsort(ref, n_ref, sizeof(ref[0]), box_cmp);
+    qsort(fix, n_fix, sizeof(fix[0]), box_cmp);
+    for (i = 0; i < n_ref && i < n_fix; i++) {
+        double e = fabs((double)fix[i].x0 - ref[i].x0);
+
+        e = fmax(e, fabs((double)fix[i].y0 - ref[i].y0));
+        e = fmax(e, fabs((double)fix[i].x1 - ref[i].x1));
+        e = fmax(e, fabs((double)fix[i].y1 - ref[i].y1));
+        err_px = fmax(err_px, e);
+        err_score = fmax(err_score, fabs(LSB((double)fix[i].score) - LSB((double)ref[i].score)));
+        if (fix[i].cls != ref[i].cls) {
+            err_px = 1e9;
+        }
+    }
+    printf("%-22s fixed %8llu cycles/frame, %d vs %d boxes, "
+           "max %.0f px, score %.1f LSB %s\n", what, (c1 - c0) / frames, n_ref, n_fix, err_px, err_score, n_ref == n_fix && err_px <= 1 && err_score <= 4 ? "ok" : "FAIL");
+    if (n_ref != n_fix || err_px > 1 || err_score > 4) {
+        failed = 1;
+    }
+    free(t.data);
+}
+
+static void bench_ops(int rounds)
+{
+    static int32_t x[PAIRS];
+    unsigned long long c0, c1, c2;
+    int32_t acc = 0;
+    float acc_f = 0;
+    int r, i;
+
+    for (i = 0; i < PAIRS; i++) {
+        x[i] = (int32_t)((i * 2654435761u) >> 16 & 0xffff) - 0x8000;
+    }
+
+    c0 = bench_cycles();
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < PAIRS; i++) {
+            acc_f += 1.0f / (1.0f + expf(-x[i] / 4096.0f));
+        }
+    }
+    c1 = bench_cycles();
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < PAIRS; i++) {
+            acc += vision_fix_sigmoid(x[i]);
+        }
+    }
+    c2 = bench_cycles();
+    printf("%-22s float %6.1f, fixed %6.1f cycles/elem\n", "sigmoid",
+           (double)(c1 - c0) / rounds / PAIRS, (double)(c2 - c1) / rounds / PAIRS);
+
+    c0 = bench_cycles();
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < PAIRS; i++) {
+            acc_f += iou_float(&pairs[i][0], &pairs[i][1]);
+        }
+    }
+    c1 = bench_cycles();
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < PAIRS; i++) {
+            acc += yolo_post_iou(&pairs[i][0], &pairs[i][1]);
+        }
+    }
+    c2 = bench_cycles();
+    printf("%-22s float %6.1f, fixed %6.1f cycles/pair\n", "iou",
+           (double)(c1 - c0) / rounds / PAIRS, (double)(c2 - c1) / rounds / PAIRS);
+
+    sink = acc;
+    sink_f = acc_f;
+}
+
+int main(int argc, char **argv)
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 200;
+
+    if (rounds <= 0) {
+        return 1;
+    }
+    vision_fix_init();
+    make_pairs();
+
+    check_sigmoid_exp();
+    check_lut();
+    check_iou();
+    check_decode("decode (decoded out)", 1575, NULL, 1.0f / 255, -128, rounds);
+    check_decode("decode (raw + anchors)", 1575, &head, 0.08f, 0, rounds);
+    bench_ops(rounds);
+
+    return failed;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+
+/*
+ * vision_preproc_image与分步做法（整帧转RGB888 -> 浮点双线性缩放 -> 量化）
+ * 的结果对比和耗时基准，同时估算两者的内存读写量。
+ *
+ * 编译：gcc -O2 -DVISION_HOST -I.. preproc_bench.c ../vision_preproc.c ../vision_camera.c -lm -o preproc_bench
+ * 用法：preproc_bench [帧数，默认200]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vision_preproc.h"
+#include "bench_common.h"
+
+#define SRC_W       320
+#define SRC_H       240
+#define DST_W       160
+#define DST_H       160
+
+static uint8_t src[SRC_W * SRC_H * 2];
+static uint8_t rgb[SRC_W * SRC_H * 3];
+static uint8_t resized[DST_W * DST_H * 3];
+static int8_t tensor_ref[DST_W * DST_H * 3];
+static int8_t tensor_fused[DST_W * DST_H * 3];
+
+static uint8_t clamp(float v)
+{
+    return v < 0 ? 0 : (v > 255 ? 255 : (uint8_t)lroundf(v));
+}
+
+static void ref_convert(vision_pixfmt_t format)
+{
+    int i;
+
+    for (i = 0; i < SRC_W * SRC_H; i++) {
+        uint8_t *o = rgb + i * 3;
+
+        if (format == VISION_PIXFMT_RGB565) {
+            uint32_t v = src[2 * i] | (src[2 * i + 1] << 8);
+
+            o[0] = ((v >> 11) & 0x1f) * 255 / 31;
+            o[1] = ((v >> 5) & 0x3f) * 255 / 63;
+            o[2] = (v & 0x1f) * 255 / 31;
+        } else {
+            const uint8_t *p = src + (i & ~1) * 2;
+            float y = p[(i & 1) * 2], u = p[1] - 128.0f, v = p[3] - 128.0f;
+
+            o[0] = clamp(y + 1.402f * v);
+            o[1] = clamp(y - 0.344f * u - 0.714f * v);
+            o[2] = clamp(y + 1.772f * u);
+        }
+    }
+}
+
+static void ref_resize(void)
+{
+    int x, y, c;
+
+    for (y = 0; y < DST_H; y++) {
+        float sy = (y + 0.5f) * SRC_H / DST_H - 0.5f;
+        int y0 = sy < 0 ? 0 : (int)sy;
+        float fy = sy < 0 ? 0 : sy - y0;
+
+        if (y0 >= SRC_H - 1) {
+            y0 = SRC_H - 2;
+            fy = 1;
+        }
+        for (x = 0; x < DST_W; x++) {
+            float sx = (x + 0.5f) * SRC_W / DST_W - 0.5f;
+            int x0 = sx < 0 ? 0 : (int)sx;
+            float fx = sx < 0 ? 0 : sx - x0;
+
+            if (x0 >= SRC_W - 1) {
+                x0 = SRC_W - 2;
+                fx = 1;
+            }
+            for (c = 0; c < 3; c++) {
+                const uint8_t *p = rgb + (y0 * SRC_W + x0) * 3 + c;
+                float top = p[0] * (1 - fx) + p[3] * fx;
+                float bottom = p[SRC_W * 3] * (1 - fx) + p[SRC_W * 3 + 3] * fx;
+
+                resized[(y * DST_W + x) * 3 + c] = clamp(top * (1 - fy) + bottom * fy);
+            }
+        }
+    }
+}
+
+static void ref_quantize(const vision_tensor_t *t)
+{
+    int i;
+
+    for (i = 0; i < DST_W * DST_H * 3; i++) {
+        int q = (int)lroundf(resized[i] / 255.0f / t->scale) + t->zero_point;
+
+        tensor_ref[i] = q < -128 ? -128 : (q > 127 ? 127 : q);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static const vision_pixfmt_t formats[] = {VISION_PIXFMT_RGB565, VISION_PIXFMT_YUV422};
+    static const char *names[] = {"rgb565", "yuv422"};
+    int frames = argc > 1 ? atoi(argv[1]) : 200;
+    vision_tensor_t t = {tensor_fused, sizeof(tensor_fused), VISION_TYPE_INT8,
+                         {1, DST_H, DST_W, 3}, 4, 1.0f / 255, -128};
+    uint32_t seed = 5, t0, t1;
+    double ref_us, fused_us;
+    int f, i, k, diff;
+
+    if (frames <= 0) {
+        return 1;
+    }
+    // 平滑渐变加少量噪声，接近真实画面
+    for (i = 0; i < SRC_W * SRC_H; i++) {
+        int x = i % SRC_W, y = i / SRC_W;
+
+        bench_rand(&seed);
+        src[2 * i] = (uint8_t)(x + y + (seed >> 28));
+        src[2 * i + 1] = (uint8_t)(x * 3 / 4 + (seed >> 29));
+    }
+
+    for (f = 0; f < 2; f++) {
+        t.data = tensor_ref;
+        t0 = vision_ticks();
+        for (k = 0; k < frames; k++) {
+            ref_convert(formats[f]);
+            ref_resize();
+            ref_quantize(&t);
+        }
+        t1 = vision_ticks();
+        ref_us = (t1 - t0) / 1000.0 / frames;
+
+        t.data = tensor_fused;
+        t0 = vision_ticks();
+        for (k = 0; k < frames; k++) {
+            vision_preproc_image(src, SRC_W, SRC_H, formats[f], &t);
+        }
+        t1 = vision_ticks();
+        fused_us = (t1 - t0) / 1000.0 / frames;
+
+        diff = 0;
+        for (i = 0; i < DST_W * DST_H * 3; i++) {
+            int d = abs(tensor_ref[i] - tensor_fused[i]);
+
+            diff = d > diff ? d : diff;
+        }
+        printf("%s: 3-pass %7.1f us, fused %7.1f us, max diff %d LSB\n",
+               names[f], ref_us, fused_us, diff);
+    }
+
+    // 分步：读源帧、写/读RGB888整帧、写/读缩放结果、写张量；融合：读源帧、写张量
+    printf("memory traffic per frame: 3-pass %d bytes, fused %d bytes\n",
+           (int)(sizeof(src) + 2 * sizeof(rgb) + 2 * sizeof(resized) + sizeof(tensor_ref)),
+           (int)(sizeof(src) + sizeof(tensor_fused)));
+    return 0;
+}
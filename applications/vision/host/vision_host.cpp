@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+
+/*
+ * 在Linux上用与固件相同的vision_runtime跑同一个.tflite模型，
+ * 对比arena用量、耗时分布、按算子类型和逐层的耗时以及输出校验和，
+ * 报告格式与固件的vision_info相同。不参与固件编译。
+ *
+ * 编译（TFLM_DIR为tflite-micro源码树，先在其中执行
+ *   make -f tensorflow/lite/micro/tools/make/Makefile microlite）：
+ *   g++ -O2 -std=c++17 -DVISION_HOST -DTF_LITE_STATIC_MEMORY \
+ *       -I.. -I$TFLM_DIR -I$TFLM_DIR/tensorflow/lite/micro/tools/make/downloads/flatbuffers/include \
+ *       -I$TFLM_DIR/tensorflow/lite/micro/tools/make/downloads/gemmlowp \
+ *       vision_host.cpp ../vision_runtime.cpp \
+ *       -x c ../vision_port.c ../vision_camera.c ../vision_camera_file.c ../vision_preproc.c \
+ *            ../vision_batch.c ../yolo_post.c -x none \
+ *       $TFLM_DIR/gen/linux_x86_64_default/lib/libtensorflow-microlite.a -o vision_host
+ *
+ * 算子表取自模型槽中选中任务的*_model_ops.h，加-DVISION_TASK_YOLOV5换成YOLOv5。
+ *
+ * 用法：vision_host model.tflite [次数] [帧文件.rgb]
+ * 帧文件为连续的RGB888原始帧，尺寸与模型输入相同，经回放摄像头和
+ * 与固件相同的预处理送入模型，每次推理取下一帧；缺省时用固定种子的伪随机输入。
+ * 第一次推理作为预热，不计入统计。
+ *
+ *       vision_host model.tflite --batch 图片目录 [结果.csv]
+ * 与板上vision_batch相同：目录下每张.ppm/.pgm推理一次，结果写入CSV（缺省batch.csv），
+ * 再给出这批图片的逐层耗时。同一目录在板上和主机上的CSV可直接比对。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "vision_runtime.h"
+#include "vision_task.h"
+#include "vision_camera.h"
+#include "vision_preproc.h"
+#include "vision_batch.h"
+
+static void *load_file(const char *path, size_t *size)
+{
+    FILE *fp = fopen(path, "rb");
+    void *buf = NULL;
+    long len;
+
+    if (fp == NULL) {
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    // flatbuffer要求16字节对齐
+    if (len > 0 && (buf = aligned_alloc(16, (len + 15) & ~15L)) != NULL) {
+        if (fread(buf, 1, len, fp) != (size_t)len) {
+            free(buf);
+            buf = NULL;
+        }
+    }
+    fclose(fp);
+    *size = len;
+    return buf;
+}
+
+#ifdef VISION_TASK_GROWTH
+#include "growth_model_ops.h"
+VISION_MODEL_DEFINE(host_model, "growth", nullptr, 0, GROWTH_MODEL_OPS);
+#else
+#include "yolov5_model_ops.h"
+VISION_MODEL_DEFINE(host_model, "yolov5", nullptr, 0, YOLOV5_MODEL_OPS);
+#endif
+
+static struct vision_camera camera;
+
+static void fill_random(const vision_tensor_t *input)
+{
+    uint8_t *p = (uint8_t *)input->data;
+    uint32_t seed = 1;
+    size_t i;
+
+    for (i = 0; i < input->bytes; i++) {
+        seed = seed * 1103515245u + 12345u;
+        p[i] = seed >> 24;
+    }
+}
+
+static int next_frame(const vision_tensor_t *input)
+{
+    const uint8_t *frame = vision_camera_get(&camera, 0);
+    int ret;
+
+    if (frame == NULL) {
+        return -1;
+    }
+    ret = vision_preproc_frame(&camera, frame, input);
+    vision_camera_release(&camera);
+    return ret;
+}
+
+// FNV-1a，用于和固件端的输出做比对
+static uint32_t checksum(const vision_tensor_t *t)
+{
+    const uint8_t *p = (const uint8_t *)t->data;
+    uint32_t hash = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < t->bytes; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+int main(int argc, char **argv)
+{
+    vision_tensor_t input, output;
+    vision_model_t desc = host_model;
+    size_t size;
+    void *model;
+    int loops, i;
+
+    if (argc < 2 || (argc > 2 && strcmp(argv[2], "--batch") == 0 && argc < 4)) {
+        printf("usage: %s model.tflite [iterations] [frames.rgb]\n"
+               "       %s model.tflite --batch dir [out.csv]\n", argv[0], argv[0]);
+        return 1;
+    }
+    model = load_file(argv[1], &size);
+    if (model == NULL) {
+        printf("cannot read %s\n", argv[1]);
+        return 1;
+    }
+    printf("model %s, %d bytes\n", argv[1], (int)size);
+    desc.data = (const uint8_t *)model;
+    desc.size = size;
+    if (vision_runtime_load(&desc) != 0 ||
+        vision_runtime_input(0, &input) != 0 || vision_runtime_output(0, &output) != 0) {
+        return 1;
+    }
+
+    if (argc > 2 && strcmp(argv[2], "--batch") == 0) {
+        vision_batch_stats_t stats;
+
+        if (vision_batch_run(argv[3], argc > 4 ? argv[4] : "batch.csv", &stats) != 0) {
+            return 1;
+        }
+        vision_batch_report(&stats);
+        vision_runtime_report();
+        free(model);
+        return 0;
+    }
+
+    loops = argc > 2 ? atoi(argv[2]) : 10;
+    if (loops < 1) {
+        loops = 1;
+    }
+    if (argc > 3) {
+        if (vision_camera_file_init(&camera, argv[3], input.dims[2], input.dims[1],
+                                    VISION_PIXFMT_RGB888) != 0 ||
+            vision_camera_start(&camera) != 0) {
+            return 1;
+        }
+    } else {
+        fill_random(&input);
+    }
+
+    for (i = 0; i < loops; i++) {
+        if (argc > 3 && next_frame(&input) != 0) {
+            printf("frame %d unusable for the model input\n", i);
+            return 1;
+        }
+        if (vision_runtime_invoke() != 0) {
+            printf("invoke %d failed\n", i);
+            return 1;
+        }
+        if (i == 0 && loops > 1) {
+            vision_runtime_profile_reset();
+        }
+    }
+    vision_runtime_report();
+    printf("output    : %d bytes, scale %g, zero point %d, fnv1a %08x\n", (int)output.bytes,
+           output.scale, (int)output.zero_point, checksum(&output));
+
+    free(model);
+    return 0;
+}
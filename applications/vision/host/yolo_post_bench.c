@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+
+/*
+ * yolo_post在主机上的基准：合成一帧int8输出，对比逐行反量化的原始解码
+ * 和yolo_post_decode的每帧耗时。x86上同时给出rdtsc周期数。
+ *
+ * 编译：gcc -O2 -DVISION_HOST -I.. yolo_post_bench.c ../yolo_post.c ../vision_fix.c -lm -o yolo_post_bench
+ * 用法：yolo_post_bench [行数，默认25200] [帧数，默认200]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "yolo_post.h"
+#include "bench_common.h"
+
+#define CLASSES     BENCH_CLASSES
+#define STRIDE      BENCH_STRIDE
+#define CLUSTER     12
+
+static const float scale = 1.0f / 255;
+static const int32_t zero_point = -128;
+
+static volatile int last_class;
+
+// 改造前的做法：每行都反量化objectness，逐个浮点比较找最大类别，没有NMS
+static int naive_decode(const vision_tensor_t *t, int rows)
+{
+    const int8_t *p = t->data;
+    int r, c, found = 0;
+
+    for (r = 0; r < rows; r++, p += STRIDE) {
+        float obj = (p[4] - t->zero_point) * t->scale;
+        float best = -1;
+        int cls = 0;
+
+        for (c = 0; c < CLASSES; c++) {
+            float v = (p[5 + c] - t->zero_point) * t->scale;
+
+            if (v > best) {
+                best = v;
+                cls = c;
+            }
+        }
+        if (obj * best > 0.5f) {
+            last_class = cls;
+            found++;
+        }
+    }
+    return found;
+}
+
+static int check_argmax(void)
+{
+    int8_t data[CLASSES], v;
+    uint32_t seed = 3;
+    int n, i, k, ref;
+
+    for (k = 0; k < 1000; k++) {
+        n = 1 + k % CLASSES;
+        for (i = 0; i < n; i++) {
+            data[i] = (int8_t)(bench_rand(&seed) >> 24);
+        }
+        ref = 0;
+        for (i = 1; i < n; i++) {
+            if (data[i] > data[ref]) {
+                ref = i;
+            }
+        }
+        if (yolo_post_argmax_s8(data, n, &v) != ref || v != data[ref]) {
+            printf("argmax mismatch at n=%d\n", n);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int rows = argc > 1 ? atoi(argv[1]) : 25200;
+    int frames = argc > 2 ? atoi(argv[2]) : 200;
+    yolo_post_cfg_t cfg = {CLASSES, 0.5f, 0.45f, 160, 160, NULL};
+    yolo_box_t boxes[16];
+    vision_tensor_t t;
+    unsigned long long c0, c1;
+    uint32_t t0, t1;
+    int i, n = 0, found = 0;
+
+    if (rows <= 0 || frames <= 0 || check_argmax() != 0) {
+        return 1;
+    }
+    memset(&t, 0, sizeof(t));
+    t.data = malloc((size_t)rows * STRIDE);
+    t.bytes = (size_t)rows * STRIDE;
+    t.type = VISION_TYPE_INT8;
+    t.scale = scale;
+    t.zero_point = zero_point;
+    bench_synth_decoded(t.data, rows, CLUSTER, 0, scale, zero_point);
+
+    t0 = vision_ticks();
+    c0 = bench_cycles();
+    for (i = 0; i < frames; i++) {
+        found = naive_decode(&t, rows);
+    }
+    c1 = bench_cycles();
+    t1 = vision_ticks();
+    printf("naive     : %8.1f us/frame %12llu cycles/frame, %d rows over threshold\n",
+           (t1 - t0) / 1000.0 / frames, (c1 - c0) / frames, found);
+
+    t0 = vision_ticks();
+    c0 = bench_cycles();
+    for (i = 0; i < frames; i++) {
+        n = yolo_post_decode(&t, &cfg, boxes, 16);
+    }
+    c1 = bench_cycles();
+    t1 = vision_ticks();
+    printf("yolo_post : %8.1f us/frame %12llu cycles/frame, %u candidates, %d boxes after NMS\n",
+           (t1 - t0) / 1000.0 / frames, (c1 - c0) / frames,
+           (unsigned)(yolo_post_stats.candidates / yolo_post_stats.frames), n);
+    for (i = 0; i < n; i++) {
+        printf("  cls %2d %.2f (%d,%d)-(%d,%d)\n", boxes[i].cls, boxes[i].score,
+               boxes[i].x0, boxes[i].y0, boxes[i].x1, boxes[i].y1);
+    }
+
+    free(t.data);
+    return 0;
+}
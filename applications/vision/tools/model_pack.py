@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2006-2021, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-19     HUAWEI       the first version
+#
+"""
+Wrap a .tflite model into a model image for vision_store.c.
+
+The image is a 64-byte header followed by the flatbuffer, so the
+flatbuffer stays 16-byte aligned in the XIP window and in SDRAM:
+
+  magic 'VMDL', header size, version, flatbuffer size, flatbuffer CRC32,
+  task name (24 bytes), 16 reserved bytes, CRC32 of the first 60 bytes
+
+Where the image goes:
+  sd_a / sd_b    copy to /sdcard/model_a.vmdl or /sdcard/model_b.vmdl
+  fal_a / fal_b  copy to the SD card, then `vision_model install <file> fal_a`
+  xip_a / xip_b  program with the external loader at 0x90400000 / 0x90600000
+
+Then `vision_model use` switches to the newest version without a reboot.
+
+Usage:
+  model_pack.py yolov5.tflite --name yolov5 --version 3 -o model_a.vmdl
+  model_pack.py --info model_a.vmdl
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = 0x4C444D56
+HDR_SIZE = 64
+NAME_MAX = 24
+SLOT_SIZE = 2 * 1024 * 1024
+HDR_FMT = '<5I%ds16s' % NAME_MAX
+
+
+def pack(data, name, version):
+    if data[4:8] != b'TFL3':
+        raise ValueError('not a TFLite flatbuffer')
+    if len(data) > SLOT_SIZE - HDR_SIZE:
+        raise ValueError('%d bytes do not fit a %d KB slot' % (len(data), SLOT_SIZE // 1024))
+    if len(name.encode()) >= NAME_MAX:
+        raise ValueError('name longer than %d bytes' % (NAME_MAX - 1))
+    body = struct.pack(HDR_FMT, MAGIC, HDR_SIZE, version, len(data),
+                       zlib.crc32(data) & 0xffffffff, name.encode(), b'\0' * 16)
+    return body + struct.pack('<I', zlib.crc32(body) & 0xffffffff) + data
+
+
+def info(image):
+    magic, size_hdr, version, size, crc, name, _ = struct.unpack_from(HDR_FMT, image)
+    hdr_crc = struct.unpack_from('<I', image, HDR_SIZE - 4)[0]
+    data = image[HDR_SIZE:HDR_SIZE + size]
+    ok = (magic == MAGIC and size_hdr == HDR_SIZE and
+          hdr_crc == zlib.crc32(image[:HDR_SIZE - 4]) & 0xffffffff and
+          len(data) == size and crc == zlib.crc32(data) & 0xffffffff)
+    return '%s v%d, %d bytes, crc32 %08x, %s' % (name.rstrip(b'\0').decode(errors='replace'),
+                                                version, size, crc, 'ok' if ok else 'CORRUPT'), ok
+
+
+def main():
+    parser = argparse.ArgumentParser(description='wrap a .tflite model for vision_store')
+    parser.add_argument('model', nargs='?')
+    parser.add_argument('--name', help='task name, e.g. yolov5 or growth')
+    parser.add_argument('--version', type=int, default=1)
+    parser.add_argument('-o', '--output')
+    parser.add_argument('--info', help='print the header of an existing image')
+    args = parser.parse_args()
+
+    if args.info:
+        with open(args.info, 'rb') as f:
+            text, ok = info(f.read())
+        print(text)
+        return 0 if ok else 1
+    if not (args.model and args.name and args.output):
+        parser.error('model, --name and -o are required')
+
+    with open(args.model, 'rb') as f:
+        data = f.read()
+    try:
+        image = pack(data, args.name, args.version)
+    except ValueError as e:
+        print('model_pack: %s: %s' % (args.model, e))
+        return 1
+    with open(args.output, 'wb') as f:
+        f.write(image)
+    print(info(image)[0])
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,379 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2006-2021, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-19     HUAWEI       the first version
+#
+"""
+Generate the op list of a .tflite model for the vision model slot.
+
+Reads the flatbuffer directly (no tensorflow/flatbuffers package needed),
+collects the builtin operators used by every subgraph and writes
+
+  <name>_model_ops.h   OP(...) list consumed by VISION_MODEL_DEFINE
+  <name>_model.h       optional, the model as a 16-byte aligned C array
+
+and exits with an error when the model uses an op the runtime cannot
+provide (unknown/custom op or more ops than VISION_OP_MAX).
+
+The kernel output is a report only. The TFLM package still compiles all of
+its kernels; the ops header keeps the resolver from referencing the others,
+so they are left out only when the linker garbage-collects them. Given the
+map of a previous build, the report shows the kernel code the image really
+links and any kernel the model does not need.
+
+Usage:
+  tflite_ops.py model.tflite --name growth [--out DIR] [--max-ops 16]
+                [--data-header growth_model.h --symbol g_growth_tflite]
+                [--map rtthread.map]
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+# BuiltinOperator value -> (MicroMutableOpResolver Add* name, kernel sources,
+# approximate flash in bytes for Cortex-M7 -Os with CMSIS-NN where it applies).
+# The flash numbers are only used when no linker map is given.
+BUILTIN_OPS = {
+    0:   ('Add',                    ['add', 'add_common'],                      3200),
+    1:   ('AveragePool2D',          ['pooling', 'pooling_common'],              3400),
+    2:   ('Concatenation',          ['concatenation'],                          1800),
+    3:   ('Conv2D',                 ['conv', 'conv_common'],                    9600),
+    4:   ('DepthwiseConv2D',        ['depthwise_conv', 'depthwise_conv_common'], 8200),
+    5:   ('DepthToSpace',           ['depth_to_space'],                         1100),
+    6:   ('Dequantize',             ['dequantize', 'dequantize_common'],        1500),
+    8:   ('Floor',                  ['floor'],                                   500),
+    9:   ('FullyConnected',         ['fully_connected', 'fully_connected_common'], 4300),
+    11:  ('L2Normalization',        ['l2norm'],                                 1300),
+    12:  ('L2Pool2D',               ['l2_pool_2d'],                             1200),
+    14:  ('Logistic',               ['logistic', 'logistic_common'],            2100),
+    17:  ('MaxPool2D',              ['pooling', 'pooling_common'],              3400),
+    18:  ('Mul',                    ['mul', 'mul_common'],                      2600),
+    19:  ('Relu',                   ['activations', 'activations_common'],      1400),
+    21:  ('Relu6',                  ['activations', 'activations_common'],      1400),
+    22:  ('Reshape',                ['reshape', 'reshape_common'],               700),
+    23:  ('ResizeBilinear',         ['resize_bilinear'],                        1700),
+    25:  ('Softmax',                ['softmax', 'softmax_common'],              3100),
+    26:  ('SpaceToDepth',           ['space_to_depth'],                         1100),
+    27:  ('Svdf',                   ['svdf', 'svdf_common'],                    4800),
+    28:  ('Tanh',                   ['tanh'],                                   2000),
+    34:  ('Pad',                    ['pad'],                                    1600),
+    36:  ('Gather',                 ['gather'],                                 1300),
+    37:  ('BatchToSpaceNd',         ['batch_to_space_nd'],                      1300),
+    38:  ('SpaceToBatchNd',         ['space_to_batch_nd'],                      1400),
+    39:  ('Transpose',              ['transpose'],                              1700),
+    40:  ('Mean',                   ['reduce', 'reduce_common'],                4100),
+    41:  ('Sub',                    ['sub', 'sub_common'],                      2900),
+    42:  ('Div',                    ['div'],                                    1800),
+    43:  ('Squeeze',                ['squeeze'],                                 600),
+    44:  ('UnidirectionalSequenceLSTM', ['unidirectional_sequence_lstm', 'lstm_eval', 'lstm_eval_common'], 14000),
+    45:  ('StridedSlice',           ['strided_slice', 'strided_slice_common'],  1900),
+    47:  ('Exp',                    ['exp'],                                     900),
+    49:  ('Split',                  ['split'],                                  1000),
+    50:  ('LogSoftmax',             ['log_softmax'],                            1600),
+    53:  ('Cast',                   ['cast'],                                   1100),
+    54:  ('Prelu',                  ['prelu', 'prelu_common'],                  1500),
+    55:  ('Maximum',                ['maximum_minimum'],                        1600),
+    56:  ('ArgMax',                 ['arg_min_max'],                            1400),
+    57:  ('Minimum',                ['maximum_minimum'],                        1600),
+    58:  ('Less',                   ['comparisons'],                            3000),
+    59:  ('Neg',                    ['neg'],                                     500),
+    60:  ('PadV2',                  ['pad'],                                    1600),
+    61:  ('Greater',                ['comparisons'],                            3000),
+    62:  ('GreaterEqual',           ['comparisons'],                            3000),
+    63:  ('LessEqual',              ['comparisons'],                            3000),
+    65:  ('Slice',                  ['slice'],                                  1300),
+    66:  ('Sin',                    ['elementwise'],                            2400),
+    67:  ('TransposeConv',          ['transpose_conv'],                         4400),
+    70:  ('ExpandDims',             ['expand_dims'],                             700),
+    71:  ('Equal',                  ['comparisons'],                            3000),
+    72:  ('NotEqual',               ['comparisons'],                            3000),
+    73:  ('Log',                    ['elementwise'],                            2400),
+    74:  ('Sum',                    ['reduce', 'reduce_common'],                4100),
+    75:  ('Sqrt',                   ['elementwise'],                            2400),
+    76:  ('Rsqrt',                  ['elementwise'],                            2400),
+    77:  ('Shape',                  ['shape'],                                   500),
+    79:  ('ArgMin',                 ['arg_min_max'],                            1400),
+    82:  ('ReduceMax',              ['reduce', 'reduce_common'],                4100),
+    83:  ('Pack',                   ['pack'],                                    900),
+    84:  ('LogicalOr',              ['logical', 'logical_common'],               700),
+    86:  ('LogicalAnd',             ['logical', 'logical_common'],               700),
+    87:  ('LogicalNot',             ['elementwise'],                            2400),
+    88:  ('Unpack',                 ['unpack'],                                  900),
+    90:  ('FloorDiv',               ['floor_div'],                               900),
+    92:  ('Square',                 ['elementwise'],                            2400),
+    93:  ('ZerosLike',              ['zeros_like'],                              600),
+    94:  ('Fill',                   ['fill'],                                    700),
+    95:  ('FloorMod',               ['floor_mod'],                               900),
+    97:  ('ResizeNearestNeighbor',  ['resize_nearest_neighbor'],                1300),
+    98:  ('LeakyRelu',              ['leaky_relu', 'leaky_relu_common'],        1200),
+    99:  ('SquaredDifference',      ['squared_difference'],                     1700),
+    100: ('MirrorPad',              ['mirror_pad'],                             1200),
+    101: ('Abs',                    ['elementwise'],                            2400),
+    102: ('SplitV',                 ['split_v'],                                1100),
+    104: ('Ceil',                   ['ceil'],                                    500),
+    106: ('AddN',                   ['add_n'],                                   900),
+    107: ('GatherNd',               ['gather_nd'],                              1200),
+    108: ('Cos',                    ['elementwise'],                            2400),
+    111: ('Elu',                    ['elu'],                                    1300),
+    114: ('Quantize',               ['quantize', 'quantize_common'],            2500),
+    116: ('Round',                  ['round'],                                   600),
+    117: ('HardSwish',              ['hard_swish', 'hard_swish_common'],        1700),
+    118: ('If',                     ['if'],                                      900),
+    119: ('While',                   ['while'],                                  900),
+    123: ('SelectV2',               ['select'],                                 1500),
+    126: ('BatchMatMul',            ['batch_matmul'],                           3600),
+    128: ('CumSum',                 ['cumsum'],                                 1200),
+    129: ('CallOnce',               ['call_once'],                               500),
+    130: ('BroadcastTo',            ['broadcast_to'],                            900),
+    142: ('VarHandle',              ['var_handle'],                              500),
+    143: ('ReadVariable',           ['read_variable'],                           400),
+    144: ('AssignVariable',         ['assign_variable'],                         600),
+    145: ('BroadcastArgs',          ['broadcast_args'],                          600),
+}
+
+
+class FlatBuffer(object):
+    """Just enough of the flatbuffer wire format to walk a TFLite model."""
+
+    def __init__(self, data):
+        self.data = data
+
+    def u16(self, pos):
+        return struct.unpack_from('<H', self.data, pos)[0]
+
+    def i32(self, pos):
+        return struct.unpack_from('<i', self.data, pos)[0]
+
+    def u32(self, pos):
+        return struct.unpack_from('<I', self.data, pos)[0]
+
+    def root(self):
+        return self.u32(0)
+
+    def field(self, table, index):
+        """Absolute position of a field, or None when it holds the default."""
+        vtable = table - self.i32(table)
+        offset = 4 + 2 * index
+        if offset >= self.u16(vtable):
+            return None
+        rel = self.u16(vtable + offset)
+        return table + rel if rel else None
+
+    def scalar(self, table, index, fmt, default=0):
+        pos = self.field(table, index)
+        if pos is None:
+            return default
+        return struct.unpack_from('<' + fmt, self.data, pos)[0]
+
+    def indirect(self, pos):
+        return pos + self.u32(pos)
+
+    def tables(self, table, index):
+        pos = self.field(table, index)
+        if pos is None:
+            return []
+        vec = self.indirect(pos)
+        return [self.indirect(vec + 4 + 4 * i) for i in range(self.u32(vec))]
+
+    def string(self, table, index):
+        pos = self.field(table, index)
+        if pos is None:
+            return None
+        s = self.indirect(pos)
+        return self.data[s + 4:s + 4 + self.u32(s)].decode('utf-8', 'replace')
+
+
+def parse_ops(data):
+    """Return {builtin code: number of operators} and the list of custom op names."""
+    if len(data) < 8 or data[4:8] != b'TFL3':
+        raise ValueError('not a TFLite flatbuffer (missing TFL3 identifier)')
+
+    fb = FlatBuffer(data)
+    model = fb.root()
+    codes = []
+    for oc in fb.tables(model, 1):                  # Model.operator_codes
+        deprecated = fb.scalar(oc, 0, 'b')          # OperatorCode.deprecated_builtin_code
+        builtin = fb.scalar(oc, 3, 'i')             # OperatorCode.builtin_code
+        codes.append((max(deprecated, builtin), fb.string(oc, 1)))
+
+    used = {}
+    custom = set()
+    for subgraph in fb.tables(model, 2):            # Model.subgraphs
+        for op in fb.tables(subgraph, 3):           # SubGraph.operators
+            index = fb.scalar(op, 0, 'I')           # Operator.opcode_index
+            if index >= len(codes):
+                raise ValueError('operator uses opcode index %d of %d' % (index, len(codes)))
+            code, custom_name = codes[index]
+            if code == 32:                          # BuiltinOperator.CUSTOM
+                custom.add(custom_name or '?')
+            else:
+                used[code] = used.get(code, 0) + 1
+    return used, sorted(custom)
+
+
+def map_kernel_sizes(path):
+    """Sum .text/.rodata sizes per kernel object from a GNU ld map file."""
+    sizes = {}
+    pending = None
+    line_re = re.compile(r'^\s*(\.(?:text|rodata)\S*)?\s+0x[0-9a-fA-F]+\s+0x([0-9a-fA-F]+)\s+(\S+\.o)\b')
+    with open(path, 'r', errors='replace') as f:
+        for line in f:
+            if re.match(r'^\s*\.(text|rodata)\S*\s*$', line):
+                pending = True              # long section name, numbers follow on the next line
+                continue
+            m = line_re.match(line)
+            if m and (m.group(1) or pending):
+                obj = m.group(3).replace('\\', '/')
+                if '/kernels/' in obj:
+                    name = os.path.splitext(os.path.basename(obj))[0]
+                    sizes[name] = sizes.get(name, 0) + int(m.group(2), 16)
+            pending = None
+    return sizes
+
+
+def kernel_set(codes):
+    kernels = set()
+    for code in codes:
+        kernels.update(BUILTIN_OPS[code][1])
+    return kernels
+
+
+def kernel_estimates():
+    """Split each op's estimated flash over its sources, shared sources count once."""
+    est = {}
+    for _, srcs, size in BUILTIN_OPS.values():
+        for k in srcs:
+            est.setdefault(k, size // len(srcs))
+    return est
+
+
+def flash_of(kernels, sizes):
+    # kernels missing from the map (not linked last time) fall back to the estimate
+    est = kernel_estimates()
+    sizes = sizes or {}
+    return sum(sizes.get(k, est[k]) for k in kernels)
+
+
+def write_if_changed(path, text):
+    """Keep the timestamp when nothing changed so SCons does not rebuild."""
+    if os.path.isfile(path):
+        with open(path, 'r', newline='') as f:
+            if f.read() == text:
+                return False
+    with open(path, 'w', newline='') as f:
+        f.write(text)
+    return True
+
+
+def header_banner(source):
+    return ('/*\r\n'
+            ' * Generated by tools/tflite_ops.py from %s, do not edit.\r\n'
+            ' */\r\n' % os.path.basename(source))
+
+
+def ops_header(name, source, used):
+    guard = 'APPLICATIONS_VISION_%s_MODEL_OPS_H_' % name.upper()
+    lines = [header_banner(source),
+             '#ifndef %s\r\n#define %s\r\n\r\n' % (guard, guard),
+             '// %d ops, %d operators in the graph\r\n' % (len(used), sum(used.values()))]
+    items = ['#define %s_MODEL_OPS(OP)' % name.upper()]
+    items += ['    OP(%s)' % BUILTIN_OPS[c][0] for c in sorted(used, key=lambda c: BUILTIN_OPS[c][0])]
+    # backslashes aligned at column 85 like the hand-written lists
+    lines.append(''.join('%-84s\\\r\n' % item for item in items[:-1]))
+    lines.append(items[-1] + '\r\n')
+    lines.append('\r\n#endif /* %s */\r\n' % guard)
+    return ''.join(lines)
+
+
+def data_header(filename, symbol, source, data):
+    guard = 'APPLICATIONS_VISION_%s_' % re.sub(r'\W', '_', os.path.basename(filename)).upper()
+    out = [header_banner(source),
+           '#ifndef %s\r\n#define %s\r\n\r\n' % (guard, guard),
+           '#include <stdint.h>\r\n\r\n',
+           '// flatbuffer要求16字节对齐\r\n',
+           'static const uint8_t %s[] __attribute__((aligned(16))) =\r\n{\r\n' % symbol]
+    for i in range(0, len(data), 16):
+        out.append('    ' + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',\r\n')
+    out.append('};\r\nstatic const unsigned int %s_len = %d;\r\n\r\n' % (symbol, len(data)))
+    out.append('#endif /* %s */\r\n' % guard)
+    return ''.join(out)
+
+
+def build(model_path, name, out_dir, max_ops=16, data_header_name=None, symbol=None,
+          map_path=None, log=print):
+    """Generate the headers, report kernel flash and return the kernel sources the model needs.
+
+    Raises SystemExit when the model needs an op the runtime cannot provide.
+    """
+    with open(model_path, 'rb') as f:
+        data = f.read()
+    used, custom = parse_ops(data)
+
+    errors = []
+    if custom:
+        errors.append('custom ops not supported: %s' % ', '.join(custom))
+    unknown = sorted(c for c in used if c not in BUILTIN_OPS)
+    if unknown:
+        errors.append('builtin ops without a TFLM kernel here: %s' % ', '.join(map(str, unknown)))
+    if len(used) > max_ops:
+        errors.append('%d ops exceed VISION_OP_MAX (%d)' % (len(used), max_ops))
+    if errors:
+        for e in errors:
+            log('tflite_ops: %s: %s' % (os.path.basename(model_path), e))
+        raise SystemExit(1)
+
+    changed = write_if_changed(os.path.join(out_dir, '%s_model_ops.h' % name),
+                               ops_header(name, model_path, used))
+    if data_header_name:
+        changed |= write_if_changed(os.path.join(out_dir, data_header_name),
+                                    data_header(data_header_name, symbol or 'g_%s_tflite' % name,
+                                                model_path, data))
+
+    sizes = map_kernel_sizes(map_path) if map_path and os.path.isfile(map_path) else None
+    kernels = kernel_set(used)
+
+    log('tflite_ops: %s: %d ops (%s)%s' % (name, len(used),
+        ', '.join(sorted(BUILTIN_OPS[c][0] for c in used)), '' if changed else ', unchanged'))
+    if sizes is None:
+        log('tflite_ops: %s: needs %d kernel sources, about %.1f KB (estimate, no linker map)'
+            % (name, len(kernels), flash_of(kernels, None) / 1024.0))
+    else:
+        # only op kernels count as unneeded, helpers such as kernel_util are always linked
+        extra = sorted(k for k in sizes if k in kernel_estimates() and k not in kernels)
+        log('tflite_ops: %s: needs %d kernel sources; %s links %.1f KB of kernel code%s'
+            % (name, len(kernels), os.path.basename(map_path), sum(sizes.values()) / 1024.0,
+               ', unneeded: ' + ', '.join(extra) if extra else ''))
+    return sorted(kernels)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='generate the op list of a .tflite model')
+    parser.add_argument('model')
+    parser.add_argument('--name', required=True, help='model name, e.g. growth')
+    parser.add_argument('--out', default='.', help='output directory')
+    parser.add_argument('--max-ops', type=int, default=16, help='VISION_OP_MAX')
+    parser.add_argument('--data-header', help='also write the model as a C array to this file')
+    parser.add_argument('--symbol', help='array name in the data header')
+    parser.add_argument('--map', help='linker map of a previous build for exact kernel sizes')
+    args = parser.parse_args()
+
+    try:
+        kernels = build(args.model, args.name, args.out, args.max_ops,
+                        args.data_header, args.symbol, args.map)
+    except (IOError, ValueError, struct.error) as e:
+        print('tflite_ops: %s: %s' % (args.model, e))
+        return 1
+    print('kernels: ' + ' '.join(kernels))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
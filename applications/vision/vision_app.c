@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include "vision_task.h"
+#include "vision_camera.h"
+#include "vision_preproc.h"
+#include "vision_sched.h"
+#include "vision_store.h"
+#include "vision_batch.h"
+#include "vision_rec.h"
+#include "control.h"
+
+#define VISION_STACK_SIZE   8192    // 解释器的Invoke调用链较深
+#define VISION_PRIORITY     20
+#define CAMERA_WIDTH        320     // QVGA RGB565，由vision_preproc缩放到模型输入尺寸
+#define CAMERA_HEIGHT       240
+#define CAMERA_FORMAT       VISION_PIXFMT_RGB565
+#define CAMERA_FILE         "/sdcard/frames.565"    // 没有DCMI摄像头时回放的原始帧
+#define CAMERA_PAUSE_MS     500     // 等待超过此时长就停掉采集，省下传感器和DMA的功耗
+#define VISION_RETRY_MS     100     // 预处理或推理出错后的首次退避，连续出错时翻倍
+#define VISION_RETRY_MAX_MS 10000
+#define VISION_RELOAD_FAILS 5       // 连续推理失败这么多次后重新加载模型
+
+#ifdef VISION_TASK_GROWTH
+static const vision_task_t *const task = &growth_task;
+#else
+static const vision_task_t *const task = &yolov5_task;
+#endif
+
+static struct vision_camera camera;
+static vision_sched_t sched;
+static vision_tensor_t input, output;
+
+static struct
+{
+    uint32_t preproc;               /* 帧格式与模型输入不匹配等预处理错误 */
+    uint32_t invoke;
+    uint32_t reloads;               /* 连续推理失败后重新加载模型的次数 */
+} vision_errors;
+
+/*
+ * 有变化时按任务周期推理（YOLOv5为10Hz），平静时每秒只做一次帧差检测，
+ * 最长10分钟强制推理一次；光照低于5Lux且画面全黑时不推理。
+ */
+static const vision_sched_cfg_t sched_cfg = {
+    .active_ms      = 0,                /* 取task->period_ms */
+    .probe_ms       = 1000,
+    .idle_ms        = 10 * 60 * 1000,
+    .hold_ms        = 5000,
+    .diff_threshold = 12,
+    .hist_threshold = 150,
+    .dark_luma      = 24,
+    .dark_lux       = 5.0f,
+};
+
+static uint32_t vision_now_ms(void)
+{
+    return (uint32_t)((uint64_t)rt_tick_get() * 1000 / RT_TICK_PER_SECOND);
+}
+
+static int vision_camera_open(void)
+{
+#ifdef BSP_USING_DCMI
+    if (vision_camera_dcmi_init(&camera, CAMERA_WIDTH, CAMERA_HEIGHT, CAMERA_FORMAT) == 0) {
+        return vision_camera_start(&camera);
+    }
+#endif
+    if (vision_camera_file_init(&camera, CAMERA_FILE, CAMERA_WIDTH, CAMERA_HEIGHT,
+                                CAMERA_FORMAT) == 0) {
+        return vision_camera_start(&camera);
+    }
+    return -1;
+}
+
+// 睡眠较长时停掉采集，醒来后重新开始，第一帧就是最新画面
+static void vision_sleep(uint32_t ms)
+{
+    if (ms < CAMERA_PAUSE_MS) {
+        rt_thread_mdelay(ms);
+        return;
+    }
+    vision_camera_stop(&camera);
+    rt_thread_mdelay(ms);
+    vision_camera_start(&camera);
+}
+
+/*
+ * 加载模型并检查张量，data为空时用编进固件的模型。
+ * 用全黑帧预热一次，报告arena用量和逐层耗时，之后的统计不含预热。
+ */
+static int vision_model_open(const uint8_t *data, size_t size)
+{
+    int ret = data ? vision_runtime_load_image(task->model, data, size) :
+                     vision_runtime_load(task->model);
+
+    if (ret != 0) {
+        return -1;
+    }
+    if (vision_runtime_input(0, &input) != 0 || vision_runtime_output(0, &output) != 0 ||
+        task->setup(&input, &output) != 0) {
+        rt_kprintf("vision: %s: unexpected model input/output\n", task->name);
+        return -1;
+    }
+    rt_memset(input.data, (int8_t)input.zero_point, input.bytes);
+    if (vision_runtime_invoke() != 0) {
+        rt_kprintf("vision: %s: invoke failed\n", task->name);
+        return -1;
+    }
+    vision_runtime_report();
+    vision_runtime_profile_reset();
+    return 0;
+}
+
+/*
+ * 从存储槽换模型，slot为空时取最新版本。新模型不可用时换回正在用的，
+ * 启动时则退回编进固件的模型。返回负数表示没有任何可用的模型。
+ */
+static int vision_model_switch(const char *slot)
+{
+    const vision_runtime_info_t *info = vision_runtime_info();
+    const uint8_t *old_data = info->model_data;
+    size_t old_size = info->model_size, size;
+    const uint8_t *data;
+
+    data = vision_store_open(task->name, slot, &size, RT_NULL);
+    if (data != RT_NULL && vision_model_open(data, size) == 0) {
+        vision_store_commit(data);
+        return 0;
+    }
+    if (vision_model_open(old_data, old_size) != 0) {
+        return -1;
+    }
+    vision_store_commit(old_data);
+    return 0;
+}
+
+// 加载模型，没有任何可用的模型时提示并等待安装，直到加载成功
+static void vision_model_wait(const char *slot)
+{
+    while (vision_model_switch(slot) != 0) {
+        rt_kprintf("vision: ERROR: %s: no usable model, vision is disabled\n"
+                   "vision: install one with \"vision_model install <file> <fal_a|fal_b>\", "
+                   "then \"vision_model use\"\n", task->name);
+        do {
+            rt_thread_mdelay(1000);
+        } while (!vision_store_take_request(&slot));
+    }
+}
+
+// 单帧出错不结束视觉线程，退避后处理下一帧，连续出错时间隔翻倍
+static void vision_backoff(uint32_t fails)
+{
+    uint32_t ms = VISION_RETRY_MS << (fails < 8 ? fails - 1 : 7);
+
+    vision_sleep(ms < VISION_RETRY_MAX_MS ? ms : VISION_RETRY_MAX_MS);
+}
+
+static void vision_thread_entry(void *param)
+{
+    vision_sched_cfg_t cfg = sched_cfg;
+    vision_batch_stats_t stats;
+    const char *slot, *dir, *csv;
+    uint32_t start, fails = 0;
+    int ret;
+
+    /* 1. 加载模型：存储槽中的最新版本，没有则用编进固件的；都没有时等待安装 */
+    vision_model_wait(RT_NULL);
+
+    if (vision_camera_open() != 0) {
+        rt_kprintf("vision: no camera\n");
+        return;
+    }
+    cfg.active_ms = task->period_ms;
+    vision_sched_init(&sched, &cfg, vision_now_ms());
+
+    while (1) {
+        const uint8_t *frame;
+
+        /* 2. 两帧之间执行热切换请求（vision_model use），失败时仍跑原模型 */
+        if (vision_store_take_request(&slot)) {
+            vision_model_switch(slot);
+        }
+        // 批量推理（vision_batch）期间停掉采集，跑完接着处理实时画面
+        if (vision_batch_take_request(&dir, &csv)) {
+            vision_camera_stop(&camera);
+            if (vision_batch_run(dir, csv, &stats) == 0) {
+                vision_batch_report(&stats);
+            }
+            vision_camera_start(&camera);
+        }
+
+        /* 3. 取最新一帧，画面没变化时不推理 */
+        frame = vision_camera_get(&camera, 1000);
+
+        if (frame == RT_NULL) {
+            rt_kprintf("vision: camera timeout\n");
+            continue;
+        }
+        // 到了定时抓拍或有事件时拷走一帧，编码在录制线程里做
+        vision_rec_frame(&camera, frame);
+        if (!vision_sched_check(&sched, frame, camera.width, camera.height, camera.format,
+                                sensor_data.light_intensity, vision_now_ms())) {
+            vision_camera_release(&camera);
+            vision_sleep(vision_sched_delay(&sched, vision_now_ms()));
+            continue;
+        }
+
+        /* 4. 缩放、转换、量化一趟写入输入张量后立即归还，DMA接着采下一帧 */
+        start = vision_ticks();
+        ret = vision_preproc_frame(&camera, frame, &input);
+        vision_camera_release(&camera);
+        if (ret != 0) {
+            // 换一个输入匹配的模型（vision_model use）即可恢复
+            vision_errors.preproc++;
+            rt_kprintf("vision: camera format not supported by the model input (%u in a row)\n",
+                       ++fails);
+            vision_backoff(fails);
+            continue;
+        }
+
+        /* 5. 执行推理，连续失败时重新加载模型，加载不了就等待安装新模型 */
+        if (vision_runtime_invoke() != 0) {
+            vision_errors.invoke++;
+            rt_kprintf("vision: %s: invoke failed (%u in a row)\n", task->name, ++fails);
+            if (fails % VISION_RELOAD_FAILS == 0) {
+                const vision_runtime_info_t *info = vision_runtime_info();
+
+                vision_errors.reloads++;
+                vision_camera_stop(&camera);
+                if (vision_model_open(info->model_data, info->model_size) != 0) {
+                    vision_model_wait(RT_NULL);
+                }
+                vision_camera_start(&camera);
+            }
+            vision_backoff(fails);
+            continue;
+        }
+        fails = 0;
+
+        /* 6. 交给任务处理输出 */
+        task->process(&output);
+        vision_sched_account(&sched, vision_ticks() - start);
+        vision_sleep(vision_sched_delay(&sched, vision_now_ms()));
+    }
+}
+
+static int vision_app_init(void)
+{
+    rt_thread_t tid;
+
+    // 没有编进模型的固件只能靠存储槽工作，启动时就提示
+    if (!vision_runtime_has_builtin(task->model)) {
+        rt_kprintf("vision: WARNING: %s: no built-in model, a model must be installed in a store slot\n",
+                   task->name);
+    }
+    tid = rt_thread_create("vision", vision_thread_entry, RT_NULL,
+                           VISION_STACK_SIZE, VISION_PRIORITY, 10);
+    if (tid == RT_NULL) {
+        return -RT_ENOMEM;
+    }
+    rt_thread_startup(tid);
+    return 0;
+}
+INIT_APP_EXPORT(vision_app_init);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void vision_task_info(void)
+{
+    rt_kprintf("task       : %s, period %u ms\n", task->name, task->period_ms);
+    rt_kprintf("camera     : %u frames, %u dropped, %u stalls, wait %u ms\n",
+               camera.stats.frames, camera.stats.dropped, camera.stats.stalls,
+               camera.stats.wait_ticks / (VISION_TICKS_PER_US * 1000));
+    rt_kprintf("errors     : %u preproc, %u invoke, %u model reloads\n",
+               vision_errors.preproc, vision_errors.invoke, vision_errors.reloads);
+    vision_sched_report(&sched, vision_now_ms());
+    if (task->report != RT_NULL) {
+        task->report();
+    }
+}
+MSH_CMD_EXPORT(vision_task_info, show vision task and camera statistics);
+#endif
@@ -0,0 +1,494 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include "vision_batch.h"
+#include "vision_preproc.h"
+#include "yolo_post.h"
+
+#ifdef VISION_HOST
+#include <dirent.h>
+#endif
+
+#define BATCH_LINE_MAX      1024    /* 文件名128 + 数值列 + 16个框或32个类别的分数，放得下 */
+#define BATCH_CLASS_MAX     32      /* 分类模型在detail里列出的类别数上限 */
+#define BATCH_READER_STACK  2048
+#define BATCH_READER_PRIO   19      /* 比视觉线程高一级，推理时能及时补上下一张 */
+
+typedef struct batch_image_
+{
+    char name[VISION_BATCH_PATH_MAX];
+    uint8_t *data;
+    int width;
+    int height;
+    vision_pixfmt_t format;
+    uint32_t read_ticks;
+    const char *error;              /* 非NULL时本张不可用 */
+    int end;                        /* 目录已读完，不再有图片 */
+} batch_image_t;
+
+/*
+ * 两块图片缓冲轮流使用：读图侧填next，推理侧处理cur。
+ * 板上free/full两个信号量在读图线程和视觉线程之间传递缓冲。
+ */
+typedef struct batch_
+{
+    DIR *dir;
+    const char *path;
+    batch_image_t image[2];
+    int next;
+    int cur;
+    volatile int abort;
+#ifndef VISION_HOST
+    struct rt_semaphore free;
+    struct rt_semaphore full;
+#endif
+} batch_t;
+
+static uint8_t image_pool[2][VISION_BATCH_IMAGE_MAX] VISION_SECTION_SDRAM;
+static batch_t batch;
+static char line[BATCH_LINE_MAX];
+static char detail[BATCH_LINE_MAX - VISION_BATCH_PATH_MAX - 64];
+
+static char req_dir[VISION_BATCH_PATH_MAX];
+static char req_csv[VISION_BATCH_PATH_MAX];
+static volatile int batch_req;
+
+static int batch_is_image(const char *name)
+{
+    size_t len = strlen(name);
+    const char *ext = name + len - 4;
+
+    // FAT上的短文件名是大写的
+    return len > 4 && ext[0] == '.' && (ext[1] | 0x20) == 'p' &&
+           ((ext[2] | 0x20) == 'p' || (ext[2] | 0x20) == 'g') && (ext[3] | 0x20) == 'm';
+}
+
+// 解析P6/P5头，返回像素数据的偏移，不支持的格式返回-1
+static int batch_pnm_header(const char *head, int len, int *width, int *height,
+                            vision_pixfmt_t *format)
+{
+    int val[3], n, pos = 2;
+
+    if (len < 2 || head[0] != 'P' || (head[1] != '6' && head[1] != '5')) {
+        return -1;
+    }
+    for (n = 0; n < 3; n++) {
+        // 跳过空白和#注释
+        while (pos < len && (head[pos] == ' ' || head[pos] == '\t' || head[pos] == '\r' ||
+                             head[pos] == '\n' || head[pos] == '#')) {
+            if (head[pos] == '#') {
+                while (pos < len && head[pos] != '\n') {
+                    pos++;
+                }
+            } else {
+                pos++;
+            }
+        }
+        if (pos >= len || head[pos] < '0' || head[pos] > '9') {
+            return -1;
+        }
+        val[n] = 0;
+        while (pos < len && head[pos] >= '0' && head[pos] <= '9' && val[n] < 100000) {
+            val[n] = val[n] * 10 + head[pos++] - '0';
+        }
+    }
+    // 最大值之后恰好一个空白字符，只支持8位
+    if (pos >= len || val[2] != 255) {
+        return -1;
+    }
+    *width = val[0];
+    *height = val[1];
+    *format = head[1] == '6' ? VISION_PIXFMT_RGB888 : VISION_PIXFMT_GRAY;
+    return pos + 1;
+}
+
+static int batch_read(int fd, uint8_t *buf, size_t size)
+{
+    size_t done = 0;
+
+    while (done < size) {
+        int n = read(fd, buf + done, size - done);
+
+        if (n <= 0) {
+            return -1;
+        }
+        done += n;
+    }
+    return 0;
+}
+
+// 读目录中的下一张图片到img，目录读完或已中止时置end
+static void batch_fill(batch_t *b, batch_image_t *img)
+{
+    char path[VISION_BATCH_PATH_MAX * 2];
+    char head[64];
+    struct dirent *ent;
+    uint32_t start;
+    size_t size;
+    int fd, n, offset;
+
+    img->error = NULL;
+    img->end = 0;
+    do {
+        ent = b->abort ? NULL : readdir(b->dir);
+    } while (ent != NULL && !batch_is_image(ent->d_name));
+    if (ent == NULL) {
+        img->end = 1;
+        return;
+    }
+    vision_snprintf(img->name, sizeof(img->name), "%s", ent->d_name);
+    vision_snprintf(path, sizeof(path), "%s/%s", b->path, ent->d_name);
+
+    start = vision_ticks();
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        img->error = "open failed";
+        img->read_ticks = 0;
+        return;
+    }
+    n = read(fd, head, sizeof(head));
+    offset = batch_pnm_header(head, n, &img->width, &img->height, &img->format);
+    if (offset < 0) {
+        img->error = "not an 8-bit P6/P5 image";
+    } else if ((size = vision_pixfmt_size(img->format, img->width, img->height)) == 0 ||
+               size > VISION_BATCH_IMAGE_MAX) {
+        img->error = "image too large";
+    } else if (lseek(fd, offset, SEEK_SET) != offset || batch_read(fd, img->data, size) != 0) {
+        img->error = "truncated";
+    }
+    close(fd);
+    img->read_ticks = vision_ticks() - start;
+}
+
+#ifndef VISION_HOST
+static void batch_reader_entry(void *param)
+{
+    batch_t *b = param;
+    batch_image_t *img;
+
+    do {
+        rt_sem_take(&b->free, RT_WAITING_FOREVER);
+        img = &b->image[b->next];
+        batch_fill(b, img);
+        b->next ^= 1;
+        rt_sem_release(&b->full);
+    } while (!img->end);
+}
+#endif
+
+static int batch_start(batch_t *b)
+{
+#ifndef VISION_HOST
+    rt_thread_t tid;
+
+    rt_sem_init(&b->free, "vbfree", 2, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&b->full, "vbfull", 0, RT_IPC_FLAG_FIFO);
+    tid = rt_thread_create("vbatch", batch_reader_entry, b, BATCH_READER_STACK,
+                           BATCH_READER_PRIO, 10);
+    if (tid == RT_NULL) {
+        rt_sem_detach(&b->free);
+        rt_sem_detach(&b->full);
+        return -1;
+    }
+    rt_thread_startup(tid);
+#endif
+    return 0;
+}
+
+// 读图线程放入end后就退出了，这里只回收信号量
+static void batch_stop(batch_t *b)
+{
+#ifndef VISION_HOST
+    rt_sem_detach(&b->free);
+    rt_sem_detach(&b->full);
+#endif
+    closedir(b->dir);
+}
+
+// 取下一张图片，板上等读图线程，主机上就地读取
+static batch_image_t *batch_take(batch_t *b)
+{
+#ifdef VISION_HOST
+    batch_fill(b, &b->image[b->cur]);
+#else
+    rt_sem_take(&b->full, RT_WAITING_FOREVER);
+#endif
+    return &b->image[b->cur];
+}
+
+static void batch_give(batch_t *b)
+{
+#ifndef VISION_HOST
+    rt_sem_release(&b->free);
+#endif
+    b->cur ^= 1;
+}
+
+// 三位小数，rt_snprintf不支持%f
+static int batch_fixed(char *buf, size_t size, float v)
+{
+    int32_t q;
+    uint32_t a;
+
+    if (v > 2000000.0f) {
+        v = 2000000.0f;
+    } else if (v < -2000000.0f) {
+        v = -2000000.0f;
+    }
+    q = (int32_t)(v * 1000 + (v < 0 ? -0.5f : 0.5f));
+    a = q < 0 ? (uint32_t)-q : (uint32_t)q;
+    return vision_snprintf(buf, size, "%s%u.%03u", q < 0 ? "-" : "", (unsigned)(a / 1000),
+                           (unsigned)(a % 1000));
+}
+
+static float batch_value(const vision_tensor_t *output, int i)
+{
+    switch (output->type) {
+    case VISION_TYPE_INT8:
+        return (((const int8_t *)output->data)[i] - output->zero_point) * output->scale;
+    case VISION_TYPE_UINT8:
+        return (((const uint8_t *)output->data)[i] - output->zero_point) * output->scale;
+    default:
+        return ((const float *)output->data)[i];
+    }
+}
+
+// [1,N,5+类别数]的int8输出按YOLO检测头解码，其余按分类处理
+static int batch_is_detector(const vision_tensor_t *input, const vision_tensor_t *output,
+                             yolo_post_cfg_t *cfg)
+{
+    if (output->type != VISION_TYPE_INT8 || output->ndims != 3 || output->dims[1] < 2 ||
+        output->dims[2] <= 5) {
+        return 0;
+    }
+    cfg->classes = output->dims[2] - 5;
+    cfg->conf_threshold = VISION_BATCH_CONF;
+    cfg->iou_threshold = VISION_BATCH_IOU;
+    cfg->width = input->dims[2];
+    cfg->height = input->dims[1];
+    cfg->head = NULL;
+    return 1;
+}
+
+// 写top,score,count,detail四列，返回长度
+static int batch_classify(char *buf, size_t size, const vision_tensor_t *output)
+{
+    int n = output->ndims > 0 ? output->dims[output->ndims - 1] : 0;
+    int top = 0, len, i;
+
+    if (n > BATCH_CLASS_MAX) {
+        n = BATCH_CLASS_MAX;
+    }
+    for (i = 1; i < n; i++) {
+        if (batch_value(output, i) > batch_value(output, top)) {
+            top = i;
+        }
+    }
+    len = vision_snprintf(buf, size, "%d,", n > 0 ? top : -1);
+    len += batch_fixed(buf + len, size - len, n > 0 ? batch_value(output, top) : 0);
+    len += vision_snprintf(buf + len, size - len, ",%d,", n);
+    for (i = 0; i < n; i++) {
+        if (i > 0) {
+            buf[len++] = ' ';
+        }
+        len += batch_fixed(buf + len, size - len, batch_value(output, i));
+    }
+    return len;
+}
+
+static int batch_detect(char *buf, size_t size, const vision_tensor_t *output,
+                        const yolo_post_cfg_t *cfg)
+{
+    yolo_box_t boxes[VISION_BATCH_BOX_MAX];
+    int n, len, i;
+
+    n = yolo_post_decode(output, cfg, boxes, VISION_BATCH_BOX_MAX);
+    len = vision_snprintf(buf, size, "%d,", n > 0 ? boxes[0].cls : -1);
+    len += batch_fixed(buf + len, size - len, n > 0 ? boxes[0].score : 0);
+    len += vision_snprintf(buf + len, size - len, ",%d,", n);
+    for (i = 0; i < n; i++) {
+        const yolo_box_t *box = &boxes[i];
+
+        if (i > 0) {
+            buf[len++] = ';';
+        }
+        len += vision_snprintf(buf + len, size - len, "%d ", box->cls);
+        len += batch_fixed(buf + len, size - len, box->score);
+        len += vision_snprintf(buf + len, size - len, " %d %d %d %d", box->x0, box->y0,
+                               box->x1, box->y1);
+    }
+    return len;
+}
+
+// 处理一张图片并写一行CSV，写文件失败返回负数
+static int batch_image(int fd, const batch_image_t *img, const vision_tensor_t *input,
+                       const vision_tensor_t *output, const yolo_post_cfg_t *post,
+                       vision_batch_stats_t *s)
+{
+    const uint32_t per_us = VISION_TICKS_PER_US;
+    const char *error = img->error;
+    uint32_t t0, t1, t2, t3;
+    int len;
+
+    t0 = vision_ticks();
+    if (error == NULL && vision_preproc_image(img->data, img->width, img->height, img->format,
+                                              input) != 0) {
+        error = "not supported by the model input";
+    }
+    t1 = vision_ticks();
+    if (error == NULL && vision_runtime_invoke() != 0) {
+        error = "invoke failed";
+    }
+    t2 = vision_ticks();
+
+    if (error == NULL) {
+        if (post->classes > 0) {
+            batch_detect(detail, sizeof(detail), output, post);
+        } else {
+            batch_classify(detail, sizeof(detail), output);
+        }
+        t3 = vision_ticks();
+        len = vision_snprintf(line, sizeof(line), "%s,%d,%d,%u,%u,%u,%u,%s\n", img->name,
+                              img->width, img->height, (unsigned)(img->read_ticks / per_us),
+                              (unsigned)((t1 - t0) / per_us), (unsigned)((t2 - t1) / per_us),
+                              (unsigned)((t3 - t2) / per_us), detail);
+        s->busy_ticks += t3 - t0;
+    } else {
+        len = vision_snprintf(line, sizeof(line), "%s,0,0,%u,,,,-1,0,0,%s\n", img->name,
+                              (unsigned)(img->read_ticks / per_us), error);
+        s->errors++;
+    }
+    s->images++;
+
+    return write(fd, line, len) == len ? 0 : -1;
+}
+
+int vision_batch_run(const char *dir, const char *csv, vision_batch_stats_t *stats)
+{
+    static const char header[] =
+        "file,width,height,read_us,preproc_us,invoke_us,post_us,top,score,count,detail\n";
+    batch_t *b = &batch;
+    vision_tensor_t input, output;
+    vision_batch_stats_t s;
+    yolo_post_cfg_t post;
+    batch_image_t *img;
+    uint32_t start, t;
+    int fd, ret = 0;
+
+    if (vision_runtime_input(0, &input) != 0 || vision_runtime_output(0, &output) != 0) {
+        vision_log("vision batch: runtime not loaded\n");
+        return -1;
+    }
+    b->dir = opendir(dir);
+    if (b->dir == NULL) {
+        vision_log("vision batch: cannot open %s\n", dir);
+        return -1;
+    }
+    fd = open(csv, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        vision_log("vision batch: cannot create %s\n", csv);
+        closedir(b->dir);
+        return -1;
+    }
+
+    memset(&s, 0, sizeof(s));
+    memset(&post, 0, sizeof(post));
+    batch_is_detector(&input, &output, &post);
+    b->path = dir;
+    b->image[0].data = image_pool[0];
+    b->image[1].data = image_pool[1];
+    b->next = 0;
+    b->cur = 0;
+    b->abort = 0;
+    if (write(fd, header, sizeof(header) - 1) != sizeof(header) - 1 || batch_start(b) != 0) {
+        close(fd);
+        closedir(b->dir);
+        return -1;
+    }
+    vision_runtime_profile_reset();
+
+    // 单张的耗时远小于DWT的回绕周期，总耗时按张累加
+    while (1) {
+        start = vision_ticks();
+        img = batch_take(b);
+        t = vision_ticks();
+        s.wait_ticks += t - start;
+        if (img->end) {
+            break;
+        }
+        // 写失败后不再推理，只取走读图线程已放入的缓冲，等它退出
+        if (ret == 0) {
+            s.read_ticks += img->read_ticks;
+            if ((ret = batch_image(fd, img, &input, &output, &post, &s)) != 0) {
+                vision_log("vision batch: write %s failed\n", csv);
+                b->abort = 1;
+            }
+        }
+        batch_give(b);
+        s.total_ticks += vision_ticks() - start;
+    }
+    batch_stop(b);
+    if (close(fd) != 0) {
+        ret = -1;
+    }
+
+    vision_log("vision batch: %u images from %s, results in %s\n", (unsigned)s.images, dir, csv);
+    if (stats != NULL) {
+        *stats = s;
+    }
+    return ret;
+}
+
+void vision_batch_report(const vision_batch_stats_t *s)
+{
+    uint32_t per_us = VISION_TICKS_PER_US;
+    uint32_t n = s->images ? s->images : 1;
+    uint64_t hidden = s->read_ticks > s->wait_ticks ? s->read_ticks - s->wait_ticks : 0;
+
+    vision_log("batch     : %u images, %u errors, %u ms\n", (unsigned)s->images,
+               (unsigned)s->errors, (unsigned)(s->total_ticks / per_us / 1000));
+    vision_log("per image : read %u us, wait %u us, busy %u us, total %u us\n",
+               (unsigned)(s->read_ticks / n / per_us), (unsigned)(s->wait_ticks / n / per_us),
+               (unsigned)(s->busy_ticks / n / per_us), (unsigned)(s->total_ticks / n / per_us));
+    vision_log("overlap   : %u%% of read time hidden behind inference\n",
+               (unsigned)(s->read_ticks ? hidden * 100 / s->read_ticks : 0));
+}
+
+void vision_batch_request(const char *dir, const char *csv)
+{
+    vision_snprintf(req_dir, sizeof(req_dir), "%s", dir);
+    vision_snprintf(req_csv, sizeof(req_csv), "%s", csv ? csv : VISION_BATCH_CSV);
+    batch_req = 1;
+}
+
+int vision_batch_take_request(const char **dir, const char **csv)
+{
+    if (!batch_req) {
+        return 0;
+    }
+    *dir = req_dir;
+    *csv = req_csv;
+    batch_req = 0;
+    return 1;
+}
+
+#if !defined(VISION_HOST) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+static void vision_batch(int argc, char **argv)
+{
+    if (argc < 2 || argc > 3) {
+        rt_kprintf("usage: vision_batch <dir> [out.csv]\n");
+        return;
+    }
+    vision_batch_request(argv[1], argc > 2 ? argv[2] : NULL);
+    rt_kprintf("batch over %s queued, results in %s\n", argv[1], argc > 2 ? argv[2] : VISION_BATCH_CSV);
+}
+MSH_CMD_EXPORT(vision_batch, run the model over images in a directory: vision_batch <dir> [out.csv]);
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_BATCH_H_
+#define APPLICATIONS_VISION_VISION_BATCH_H_
+
+#include "vision_runtime.h"
+
+/*
+ * 离线批量推理：遍历目录下的.ppm(P6)/.pgm(P5)图片，经与摄像头相同的
+ * 预处理和解释器推理，每张图一行写入CSV。板上由读图线程预读下一张，
+ * SD卡读取与推理重叠；主机上顺序读取，用作回归基准。
+ *
+ * CSV列：file,width,height,read_us,preproc_us,invoke_us,post_us,top,score,count,detail
+ *   检测模型（输出[1,N,5+类别数]的int8张量）：top/score为最高分框，count为框数，
+ *     detail为"类别 分数 x0 y0 x1 y1"，多个框以';'分隔
+ *   分类模型：top/score为最大类别，count为类别数，detail为各类别分数，以空格分隔
+ *   读图或预处理失败的行top为-1，detail为原因
+ */
+#define VISION_BATCH_IMAGE_MAX      (640 * 480 * 3)     /* 单张图片的像素数据上限 */
+#define VISION_BATCH_PATH_MAX       128
+#define VISION_BATCH_CONF           0.5f                /* 检测模型的后处理参数，同yolo_task */
+#define VISION_BATCH_IOU            0.45f
+#define VISION_BATCH_BOX_MAX        16
+#define VISION_BATCH_CSV            "/sdcard/batch.csv"
+
+typedef struct vision_batch_stats_
+{
+    uint32_t images;                /* 写入CSV的行数 */
+    uint32_t errors;                /* 其中读图或预处理失败的 */
+    uint64_t read_ticks;            /* 读图累计，板上与推理重叠 */
+    uint64_t wait_ticks;            /* 推理侧等图的累计，越小说明预读越充分 */
+    uint64_t busy_ticks;            /* 预处理、推理、后处理累计 */
+    uint64_t total_ticks;
+} vision_batch_stats_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 对已加载的模型跑一遍dir下的图片，结果写到csv。会改写输入张量，
+ * 调用者要保证期间没有别的推理。开始时清零逐层统计，结束后
+ * vision_runtime_report给出的就是这批图片的耗时分解。
+ * 成功返回0，stats可为NULL。
+ */
+int vision_batch_run(const char *dir, const char *csv, vision_batch_stats_t *stats);
+void vision_batch_report(const vision_batch_stats_t *stats);
+
+// 请求批量推理，由视觉线程在两帧之间取走执行；csv为NULL时用VISION_BATCH_CSV
+void vision_batch_request(const char *dir, const char *csv);
+// 取出待执行的请求，没有时返回0
+int vision_batch_take_request(const char **dir, const char **csv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_BATCH_H_ */
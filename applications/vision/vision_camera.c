@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include "vision_camera.h"
+
+/*
+ * 帧缓冲在SDRAM中，按cache行对齐，失效时不会波及相邻数据。
+ * 目前只有一路摄像头，两块缓冲由vision_camera_init分给它。
+ */
+static uint8_t frame_pool[2][VISION_CACHE_ALIGN(VISION_CAMERA_FRAME_MAX)]
+    __attribute__((aligned(VISION_CACHE_LINE))) VISION_SECTION_SDRAM;
+static struct vision_camera *frame_owner;
+
+size_t vision_pixfmt_size(vision_pixfmt_t format, int width, int height)
+{
+    switch (format) {
+    case VISION_PIXFMT_RGB565:
+    case VISION_PIXFMT_YUV422:
+        return (size_t)width * height * 2;
+    case VISION_PIXFMT_RGB888:
+        return (size_t)width * height * 3;
+    case VISION_PIXFMT_GRAY:
+        return (size_t)width * height;
+    default:
+        return 0;
+    }
+}
+
+int vision_camera_init(struct vision_camera *cam, const char *name,
+                       const struct vision_camera_ops *ops,
+                       int width, int height, vision_pixfmt_t format)
+{
+    size_t size = vision_pixfmt_size(format, width, height);
+
+    if (size == 0 || size > VISION_CAMERA_FRAME_MAX) {
+        vision_log("camera %s: %dx%d format %d does not fit\n", name, width, height, format);
+        return -1;
+    }
+    if (frame_owner != NULL && frame_owner != cam) {
+        vision_log("camera %s: frame buffers in use by %s\n", name, frame_owner->name);
+        return -1;
+    }
+
+    memset(cam, 0, sizeof(*cam));
+    cam->name = name;
+    cam->ops = ops;
+    cam->width = width;
+    cam->height = height;
+    cam->format = format;
+    cam->frame_size = size;
+    cam->buf[0] = frame_pool[0];
+    cam->buf[1] = frame_pool[1];
+    cam->filling = -1;
+    cam->ready = -1;
+    cam->held = -1;
+    vision_sem_init(&cam->sem, name);
+    frame_owner = cam;
+
+    return 0;
+}
+
+int vision_camera_start(struct vision_camera *cam)
+{
+    cam->ready = -1;
+    cam->held = -1;
+    cam->filling = 0;
+    return cam->ops->start(cam, cam->buf[0], cam->frame_size);
+}
+
+void vision_camera_stop(struct vision_camera *cam)
+{
+    if (cam->ops->stop != NULL) {
+        cam->ops->stop(cam);
+    }
+    cam->filling = -1;
+}
+
+void vision_camera_frame_done(struct vision_camera *cam)
+{
+    vision_lock_t level;
+    int8_t next;
+
+    level = vision_lock();
+    if (cam->filling < 0) {
+        vision_unlock(level);
+        return;
+    }
+    if (cam->ready >= 0) {
+        cam->stats.dropped++;
+    }
+    cam->ready = cam->filling;
+    cam->stats.frames++;
+
+    // 另一块缓冲没被消费者占用就立刻开始下一帧（其中若有旧帧，直接覆盖）
+    next = cam->ready ^ 1;
+    if (cam->held == next) {
+        cam->filling = -1;
+        cam->stats.stalls++;
+    } else {
+        cam->filling = next;
+    }
+    vision_unlock(level);
+
+    if (next == cam->filling) {
+        cam->ops->start(cam, cam->buf[next], cam->frame_size);
+    }
+    vision_sem_give(&cam->sem);
+}
+
+const uint8_t *vision_camera_get(struct vision_camera *cam, int timeout_ms)
+{
+    vision_lock_t level;
+    uint32_t start = vision_ticks();
+    int8_t index;
+
+    if (cam->held >= 0) {
+        vision_camera_release(cam);
+    }
+
+    for (;;) {
+        level = vision_lock();
+        index = cam->ready;
+        if (index >= 0) {
+            cam->held = index;
+            cam->ready = -1;
+        }
+        vision_unlock(level);
+
+        if (index >= 0) {
+            break;
+        }
+        if (cam->ops->poll != NULL) {
+            if (cam->ops->poll(cam) != 0) {
+                return NULL;
+            }
+            continue;
+        }
+        if (vision_sem_take(&cam->sem, timeout_ms) != 0) {
+            return NULL;
+        }
+    }
+    cam->stats.wait_ticks += vision_ticks() - start;
+
+    // DMA绕过了D-Cache，丢掉该缓冲可能残留的旧cache行
+    vision_dcache_invalidate(cam->buf[index], VISION_CACHE_ALIGN(cam->frame_size));
+    return cam->buf[index];
+}
+
+void vision_camera_release(struct vision_camera *cam)
+{
+    vision_lock_t level;
+    int8_t index;
+
+    level = vision_lock();
+    index = cam->held;
+    cam->held = -1;
+    if (index >= 0 && cam->filling < 0) {
+        cam->filling = index;
+    } else {
+        index = -1;
+    }
+    vision_unlock(level);
+
+    // 采集因缓冲都被占用而暂停过，用刚释放的缓冲恢复
+    if (index >= 0) {
+        cam->ops->start(cam, cam->buf[index], cam->frame_size);
+    }
+}
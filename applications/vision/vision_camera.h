@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_CAMERA_H_
+#define APPLICATIONS_VISION_VISION_CAMERA_H_
+
+#include "vision_port.h"
+
+#define VISION_CAMERA_FRAME_MAX     (320 * 240 * 2)     /* 单帧缓冲上限，QVGA RGB565 */
+
+typedef enum
+{
+    VISION_PIXFMT_RGB565 = 0,       /* 小端16位 */
+    VISION_PIXFMT_YUV422,           /* YUYV */
+    VISION_PIXFMT_RGB888,
+    VISION_PIXFMT_GRAY,
+} vision_pixfmt_t;
+
+struct vision_camera;
+
+/*
+ * 驱动接口。start把一帧采集到buf，完成后（通常在DMA中断里）调用
+ * vision_camera_frame_done；poll可选，没有中断的驱动在取帧前被调用，
+ * 在其中完成当前这一帧，失败返回负数。
+ */
+struct vision_camera_ops
+{
+    int (*start)(struct vision_camera *cam, uint8_t *buf, size_t size);
+    int (*poll)(struct vision_camera *cam);
+    void (*stop)(struct vision_camera *cam);
+};
+
+struct vision_camera_stats
+{
+    uint32_t frames;                /* DMA完成的帧数 */
+    uint32_t dropped;               /* 没被取走就被新帧覆盖的帧数 */
+    uint32_t stalls;                /* 两块缓冲都被占用，采集暂停的次数 */
+    uint32_t wait_ticks;            /* 消费者等帧的累计时间 */
+};
+
+/*
+ * 乒乓缓冲：一块由DMA写入，另一块是最新的完整帧或正被推理使用。
+ * 推理第N帧时DMA已经在采第N+1帧。
+ */
+struct vision_camera
+{
+    const char *name;
+    const struct vision_camera_ops *ops;
+    uint16_t width;
+    uint16_t height;
+    vision_pixfmt_t format;
+    size_t frame_size;
+    uint8_t *buf[2];
+    volatile int8_t filling;        /* DMA正在写的缓冲，-1为暂停 */
+    volatile int8_t ready;          /* 最新完整帧，-1为无 */
+    volatile int8_t held;           /* 消费者持有的缓冲，-1为无 */
+    vision_sem_t sem;
+    struct vision_camera_stats stats;
+    void *user_data;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+size_t vision_pixfmt_size(vision_pixfmt_t format, int width, int height);
+
+// 初始化公共部分并分配缓冲，由各驱动在自己的init里调用
+int vision_camera_init(struct vision_camera *cam, const char *name,
+                       const struct vision_camera_ops *ops,
+                       int width, int height, vision_pixfmt_t format);
+int vision_camera_start(struct vision_camera *cam);
+void vision_camera_stop(struct vision_camera *cam);
+
+// 驱动在一帧写完后调用，可在中断中调用
+void vision_camera_frame_done(struct vision_camera *cam);
+
+/*
+ * 取最新一帧，返回的缓冲已做过cache失效，直到vision_camera_release前
+ * 都归调用者所有，DMA不会写它。超时返回NULL。
+ */
+const uint8_t *vision_camera_get(struct vision_camera *cam, int timeout_ms);
+void vision_camera_release(struct vision_camera *cam);
+
+#ifdef BSP_USING_DCMI
+// DCMI摄像头，见vision_camera_dcmi.c
+int vision_camera_dcmi_init(struct vision_camera *cam, int width, int height, vision_pixfmt_t format);
+#endif
+
+// 文件回放的假摄像头：文件为连续的原始帧，读到结尾后从头循环
+int vision_camera_file_init(struct vision_camera *cam, const char *path,
+                            int width, int height, vision_pixfmt_t format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_CAMERA_H_ */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include "vision_camera.h"
+
+/*
+ * DCMI + DMA采集。需要在CubeMX中打开DCMI（生成HAL_DCMI_MspInit中的引脚配置）
+ * 并定义BSP_USING_DCMI；传感器寄存器（分辨率、输出格式）由板级代码经SCCB配置好。
+ * 每帧用快照模式启动一次DMA，帧中断里切到另一块缓冲。
+ */
+#if defined(BSP_USING_DCMI) && defined(HAL_DCMI_MODULE_ENABLED)
+
+static DCMI_HandleTypeDef hdcmi;
+static DMA_HandleTypeDef hdma_dcmi;
+static struct vision_camera *dcmi_cam;
+
+static int camera_dcmi_start(struct vision_camera *cam, uint8_t *buf, size_t size)
+{
+    (void)cam;
+    // DMA按字传输，帧大小都是4的整数倍
+    return HAL_DCMI_Start_DMA(&hdcmi, DCMI_MODE_SNAPSHOT, (uint32_t)buf, size / 4) == HAL_OK ? 0 : -1;
+}
+
+static void camera_dcmi_stop(struct vision_camera *cam)
+{
+    (void)cam;
+    HAL_DCMI_Stop(&hdcmi);
+}
+
+static const struct vision_camera_ops camera_dcmi_ops =
+{
+    camera_dcmi_start,
+    RT_NULL,
+    camera_dcmi_stop,
+};
+
+void HAL_DCMI_FrameEventCallback(DCMI_HandleTypeDef *handle)
+{
+    if (handle == &hdcmi && dcmi_cam != RT_NULL) {
+        vision_camera_frame_done(dcmi_cam);
+    }
+}
+
+void DCMI_IRQHandler(void)
+{
+    rt_interrupt_enter();
+    HAL_DCMI_IRQHandler(&hdcmi);
+    rt_interrupt_leave();
+}
+
+void DMA2_Stream1_IRQHandler(void)
+{
+    rt_interrupt_enter();
+    HAL_DMA_IRQHandler(&hdma_dcmi);
+    rt_interrupt_leave();
+}
+
+int vision_camera_dcmi_init(struct vision_camera *cam, int width, int height, vision_pixfmt_t format)
+{
+    if (vision_camera_init(cam, "dcmi", &camera_dcmi_ops, width, height, format) != 0) {
+        return -1;
+    }
+
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    hdma_dcmi.Instance = DMA2_Stream1;
+    hdma_dcmi.Init.Request = DMA_REQUEST_DCMI;
+    hdma_dcmi.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_dcmi.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_dcmi.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_dcmi.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    hdma_dcmi.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    hdma_dcmi.Init.Mode = DMA_NORMAL;
+    hdma_dcmi.Init.Priority = DMA_PRIORITY_HIGH;
+    hdma_dcmi.Init.FIFOMode = DMA_FIFOMODE_ENABLE;
+    hdma_dcmi.Init.FIFOThreshold = DMA_FIFO_THRESHOLD_FULL;
+    hdma_dcmi.Init.MemBurst = DMA_MBURST_INC4;
+    hdma_dcmi.Init.PeriphBurst = DMA_PBURST_SINGLE;
+    if (HAL_DMA_Init(&hdma_dcmi) != HAL_OK) {
+        return -1;
+    }
+
+    hdcmi.Instance = DCMI;
+    hdcmi.Init.SynchroMode = DCMI_SYNCHRO_HARDWARE;
+    hdcmi.Init.PCKPolarity = DCMI_PCKPOLARITY_RISING;
+    hdcmi.Init.VSPolarity = DCMI_VSPOLARITY_LOW;
+    hdcmi.Init.HSPolarity = DCMI_HSPOLARITY_LOW;
+    hdcmi.Init.CaptureRate = DCMI_CR_ALL_FRAME;
+    hdcmi.Init.ExtendedDataMode = DCMI_EXTEND_DATA_8B;
+    hdcmi.Init.JPEGMode = DCMI_JPEG_DISABLE;
+    hdcmi.Init.ByteSelectMode = DCMI_BSM_ALL;
+    hdcmi.Init.LineSelectMode = DCMI_LSM_ALL;
+    __HAL_LINKDMA(&hdcmi, DMA_Handle, hdma_dcmi);
+    if (HAL_DCMI_Init(&hdcmi) != HAL_OK) {
+        return -1;
+    }
+
+    HAL_NVIC_SetPriority(DMA2_Stream1_IRQn, 2, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+    HAL_NVIC_SetPriority(DCMI_IRQn, 2, 0);
+    HAL_NVIC_EnableIRQ(DCMI_IRQn);
+    dcmi_cam = cam;
+
+    return 0;
+}
+
+#endif /* BSP_USING_DCMI */
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include "vision_camera.h"
+
+/*
+ * 回放摄像头：start只记下目标缓冲，真正的读文件放在poll里，
+ * 在消费者取帧时完成。板上用/sdcard中的文件，主机上用本地文件。
+ */
+typedef struct camera_file_
+{
+    int fd;
+    uint8_t *pending;
+} camera_file_t;
+
+static camera_file_t camera_file;
+
+static int camera_file_start(struct vision_camera *cam, uint8_t *buf, size_t size)
+{
+    camera_file_t *f = cam->user_data;
+
+    (void)size;
+    f->pending = buf;
+    return 0;
+}
+
+static int camera_file_read(int fd, uint8_t *buf, size_t size)
+{
+    size_t done = 0;
+
+    while (done < size) {
+        int n = read(fd, buf + done, size - done);
+
+        if (n <= 0) {
+            return -1;
+        }
+        done += n;
+    }
+    return 0;
+}
+
+static int camera_file_poll(struct vision_camera *cam)
+{
+    camera_file_t *f = cam->user_data;
+
+    if (f->pending == NULL) {
+        return -1;
+    }
+    if (camera_file_read(f->fd, f->pending, cam->frame_size) != 0) {
+        // 到结尾（或剩下不足一帧）后从头循环
+        lseek(f->fd, 0, SEEK_SET);
+        if (camera_file_read(f->fd, f->pending, cam->frame_size) != 0) {
+            vision_log("camera %s: no complete frame in file\n", cam->name);
+            return -1;
+        }
+    }
+    f->pending = NULL;
+    vision_camera_frame_done(cam);
+    return 0;
+}
+
+static void camera_file_stop(struct vision_camera *cam)
+{
+    camera_file_t *f = cam->user_data;
+
+    f->pending = NULL;
+}
+
+static const struct vision_camera_ops camera_file_ops =
+{
+    camera_file_start,
+    camera_file_poll,
+    camera_file_stop,
+};
+
+int vision_camera_file_init(struct vision_camera *cam, const char *path,
+                            int width, int height, vision_pixfmt_t format)
+{
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        vision_log("camera file %s: open failed\n", path);
+        return -1;
+    }
+    if (vision_camera_init(cam, "camfile", &camera_file_ops, width, height, format) != 0) {
+        close(fd);
+        return -1;
+    }
+    if (camera_file.fd > 0) {
+        close(camera_file.fd);
+    }
+    camera_file.fd = fd;
+    camera_file.pending = NULL;
+    cam->user_data = &camera_file;
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include "vision_event.h"
+#include "sensor_msg.h"
+#include "json_writer.h"
+#include "mqtt_push.h"
+#include "vision_rec.h"
+
+// 置信度按两位小数输出，不依赖printf的浮点支持
+static const char *vision_event_conf(char *buf, float confidence)
+{
+    buf[json_format_fixed(buf, json_float_to_fixed(confidence, 2), 2)] = '\0';
+    return buf;
+}
+
+rt_err_t vision_event_stage(int stage, const char *name, float confidence)
+{
+    static const sensor_id_t ids[2] = {GROWTH_STAGE, GROWTH_CONF};
+    float values[2] = {(float)stage, confidence};
+    char payload[96];
+    char conf[16];
+
+    // 阶段和置信度成对入队，不会只发出阶段而在下一帧重发
+    if (sensor_msg_publish_batch(ids, values, 2, 0) != RT_EOK) {
+        return -RT_EFULL;
+    }
+    rt_snprintf(payload, sizeof(payload), "{\"stage\":%d,\"name\":\"%s\",\"conf\":%s}",
+                stage, name, vision_event_conf(conf, confidence));
+    mqtt_push_publish("vision/stage", payload);
+    vision_rec_trigger("stage");
+    return RT_EOK;
+}
+
+rt_err_t vision_event_pest(int cls, rt_bool_t present, int count, float confidence)
+{
+    char payload[96];
+    char conf[16];
+
+    if (sensor_msg_publish(PEST_DETECT, (float)count, 0) != RT_EOK) {
+        return -RT_EFULL;
+    }
+    rt_snprintf(payload, sizeof(payload), "{\"class\":%d,\"present\":%s,\"count\":%d,\"conf\":%s}",
+                cls, present ? "true" : "false", count, vision_event_conf(conf, confidence));
+    mqtt_push_publish("vision/pest", payload);
+    vision_rec_trigger("pest");
+    return RT_EOK;
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_EVENT_H_
+#define APPLICATIONS_VISION_VISION_EVENT_H_
+
+#include <rtthread.h>
+
+/*
+ * 视觉事件出口。任务只在vision_track判定的状态翻转时调用，
+ * 事件进入传感器消息管道（控制逻辑、网页、历史记录），同时发布到MQTT。
+ * 返回值只反映传感器管道：队列满时返回错误，调用者下一帧重发；
+ * MQTT未连接时直接丢弃，重连后由下一次翻转补上（retained）。
+ */
+
+// 生长阶段切换，写入GROWTH_STAGE/GROWTH_CONF，MQTT主题vision/stage
+rt_err_t vision_event_stage(int stage, const char *name, float confidence);
+// 某类虫害出现或消失，count为当前确认的虫害目标总数，写入PEST_DETECT，MQTT主题vision/pest
+rt_err_t vision_event_pest(int cls, rt_bool_t present, int count, float confidence);
+
+#endif /* APPLICATIONS_VISION_VISION_EVENT_H_ */
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <math.h>
+#include "vision_fix.h"
+
+/*
+ * sigmoid表覆盖[-16, 16]，步长1/16（Q12下为256），线性插值加取整误差在2.5 LSB以内。
+ * exp按2^(-t)计算，t = -x * log2(e)取Q16：整数部分移位，小数部分查2^(-f)表，
+ * 步长1/256。两张表都在运行时生成，放在DTCM里。
+ */
+#define SIG_RANGE       16
+#define SIG_SHIFT       8
+#define SIG_STEPS       (2 * SIG_RANGE << (VISION_FIX_IN_Q - SIG_SHIFT))
+#define EXP2_Q          16
+#define EXP2_SHIFT      8
+#define EXP2_STEPS      (1 << (EXP2_Q - EXP2_SHIFT))
+#define LOG2E_Q15       47274       /* log2(e) * 32768 */
+
+static uint16_t sig_tab[SIG_STEPS + 1] VISION_SECTION_DTCM;
+static uint16_t exp2_tab[EXP2_STEPS + 1] VISION_SECTION_DTCM;
+static uint8_t tab_ready;
+
+void vision_fix_init(void)
+{
+    int i;
+
+    if (tab_ready) {
+        return;
+    }
+    for (i = 0; i <= SIG_STEPS; i++) {
+        float x = (float)i / (SIG_STEPS / (2 * SIG_RANGE)) - SIG_RANGE;
+
+        sig_tab[i] = (uint16_t)vision_fix_from_float(1.0f / (1.0f + expf(-x)));
+    }
+    for (i = 0; i <= EXP2_STEPS; i++) {
+        exp2_tab[i] = (uint16_t)vision_fix_from_float(exp2f(-(float)i / EXP2_STEPS));
+    }
+    tab_ready = 1;
+}
+
+void vision_fix_lut_update(vision_fix_lut_t *lut, float scale, int32_t zero_point,
+                           vision_fix_func_t func)
+{
+    int i;
+
+    if (lut->valid && lut->scale == scale && lut->zero_point == zero_point && lut->func == func) {
+        return;
+    }
+    for (i = 0; i < 256; i++) {
+        float x = (i - 128 - zero_point) * scale;
+        float v;
+
+        switch (func) {
+        case VISION_FIX_SIGMOID:
+            v = 1.0f / (1.0f + expf(-x));
+            break;
+        case VISION_FIX_EXP:
+            v = expf(x);
+            break;
+        default:
+            v = x;
+            break;
+        }
+        v = v < -32.0f ? -32.0f : (v > 32.0f ? 32.0f : v);
+        lut->value[i] = vision_fix_from_float(v);
+    }
+    lut->scale = scale;
+    lut->zero_point = zero_point;
+    lut->func = func;
+    lut->valid = 1;
+}
+
+int32_t vision_fix_sigmoid(int32_t x)
+{
+    uint32_t pos;
+    int32_t a, b;
+
+    if (x <= -(SIG_RANGE << VISION_FIX_IN_Q)) {
+        return sig_tab[0];
+    }
+    if (x >= (SIG_RANGE << VISION_FIX_IN_Q)) {
+        return sig_tab[SIG_STEPS];
+    }
+    pos = (uint32_t)(x + (SIG_RANGE << VISION_FIX_IN_Q));
+    a = sig_tab[pos >> SIG_SHIFT];
+    b = sig_tab[(pos >> SIG_SHIFT) + 1];
+    return a + (((b - a) * (int32_t)(pos & ((1 << SIG_SHIFT) - 1)) + (1 << (SIG_SHIFT - 1))) >> SIG_SHIFT);
+}
+
+int32_t vision_fix_exp(int32_t x)
+{
+    uint32_t t, f;
+    int32_t a, b, v;
+    int n;
+
+    if (x >= 0) {
+        return VISION_FIX_ONE;
+    }
+    if (x <= -(SIG_RANGE << VISION_FIX_IN_Q)) {
+        return 0;
+    }
+    // t = -x * log2(e)，Q12 * Q15 -> Q16
+    t = ((uint32_t)(-x) * LOG2E_Q15 + (1 << 10)) >> 11;
+    n = t >> EXP2_Q;
+    f = t & ((1 << EXP2_Q) - 1);
+    a = exp2_tab[f >> EXP2_SHIFT];
+    b = exp2_tab[(f >> EXP2_SHIFT) + 1];
+    v = a + (((b - a) * (int32_t)(f & ((1 << EXP2_SHIFT) - 1)) + (1 << (EXP2_SHIFT - 1))) >> EXP2_SHIFT);
+    return n == 0 ? v : (v + (1 << (n - 1))) >> n;
+}
+
+#if defined(RT_USING_FINSH) && !defined(VISION_HOST)
+#include <finsh.h>
+
+#define BENCH_N     256
+
+static volatile int32_t bench_sink;
+static volatile float bench_sink_f;
+
+// 同一组输入上浮点和定点各跑一遍，给出每个元素的周期数
+static void vision_fix_bench(void)
+{
+    static int8_t q[BENCH_N];
+    static int32_t x[BENCH_N];
+    static int16_t box[BENCH_N][4];
+    static vision_fix_lut_t lut;
+    uint32_t seed = 1, start, t_float, t_fix, t_lut;
+    int32_t acc = 0;
+    float acc_f = 0;
+    int i;
+
+    vision_port_init();
+    vision_fix_init();
+    vision_fix_lut_update(&lut, 0.1f, 3, VISION_FIX_SIGMOID);
+    for (i = 0; i < BENCH_N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        q[i] = (int8_t)(seed >> 24);
+        x[i] = (int32_t)(seed >> 8 & 0xffff) - 0x8000;      /* Q12，±8 */
+        box[i][0] = seed >> 16 & 0xff;
+        box[i][1] = seed >> 8 & 0xff;
+        box[i][2] = box[i][0] + 8 + (seed >> 4 & 0x3f);
+        box[i][3] = box[i][1] + 8 + (seed & 0x3f);
+    }
+
+    start = vision_ticks();
+    for (i = 0; i < BENCH_N; i++) {
+        acc_f += 1.0f / (1.0f + expf(-x[i] / 4096.0f));
+    }
+    t_float = vision_ticks() - start;
+    start = vision_ticks();
+    for (i = 0; i < BENCH_N; i++) {
+        acc += vision_fix_sigmoid(x[i]);
+    }
+    t_fix = vision_ticks() - start;
+    start = vision_ticks();
+    for (i = 0; i < BENCH_N; i++) {
+        acc += vision_fix_lut_s8(&lut, q[i]);
+    }
+    t_lut = vision_ticks() - start;
+    rt_kprintf("sigmoid : float %u, interp %u, int8 lut %u cycles/elem\n", t_float / BENCH_N,
+               t_fix / BENCH_N, t_lut / BENCH_N);
+
+    start = vision_ticks();
+    for (i = 1; i < BENCH_N; i++) {
+        const int16_t *a = box[i - 1], *b = box[i];
+        int32_t w = (a[2] < b[2] ? a[2] : b[2]) - (a[0] > b[0] ? a[0] : b[0]);
+        int32_t h = (a[3] < b[3] ? a[3] : b[3]) - (a[1] > b[1] ? a[1] : b[1]);
+
+        if (w > 0 && h > 0) {
+            float inter = (float)w * h;
+
+            acc_f += inter / ((a[2] - a[0]) * (a[3] - a[1]) + (b[2] - b[0]) * (b[3] - b[1]) - inter);
+        }
+    }
+    t_float = vision_ticks() - start;
+    start = vision_ticks();
+    for (i = 1; i < BENCH_N; i++) {
+        const int16_t *a = box[i - 1], *b = box[i];
+
+        acc += vision_fix_iou(a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3]);
+    }
+    t_fix = vision_ticks() - start;
+    rt_kprintf("iou     : float %u, q15 %u cycles/pair\n", t_float / (BENCH_N - 1),
+               t_fix / (BENCH_N - 1));
+
+    start = vision_ticks();
+    for (i = 0; i < BENCH_N; i++) {
+        acc_f += expf(x[i] > 0 ? -x[i] / 4096.0f : x[i] / 4096.0f);
+    }
+    t_float = vision_ticks() - start;
+    start = vision_ticks();
+    for (i = 0; i < BENCH_N; i++) {
+        acc += vision_fix_exp(x[i] > 0 ? -x[i] : x[i]);
+    }
+    t_fix = vision_ticks() - start;
+    rt_kprintf("exp     : float %u, q15 %u cycles/elem\n", t_float / BENCH_N, t_fix / BENCH_N);
+
+    bench_sink = acc;
+    bench_sink_f = acc_f;
+}
+MSH_CMD_EXPORT(vision_fix_bench, compare float and fixed-point post-processing math);
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_FIX_H_
+#define APPLICATIONS_VISION_VISION_FIX_H_
+
+#include "vision_port.h"
+
+/*
+ * 推理之外的定点数学。概率、归一化坐标、IoU都用Q15（32768为1.0），
+ * 存在int32_t里，1.0本身和略超出[0, 1]的值都能表示。
+ *
+ * int8张量上的逐元素函数用量化感知查表：256个可能的取值直接映射为
+ * f((q - zero_point) * scale)的Q15结果，反量化和sigmoid/exp一次查完。
+ * 不在量化域的输入用vision_fix_sigmoid/exp，查表加线性插值。
+ */
+#define VISION_FIX_Q                15
+#define VISION_FIX_ONE              (1 << VISION_FIX_Q)
+#define VISION_FIX_IN_Q             12          /* vision_fix_sigmoid/exp的输入格式 */
+
+typedef enum
+{
+    VISION_FIX_LINEAR,              /* 只反量化 */
+    VISION_FIX_SIGMOID,
+    VISION_FIX_EXP,
+} vision_fix_func_t;
+
+// int8张量的查表，同一组量化参数只需生成一次
+typedef struct vision_fix_lut_
+{
+    int32_t value[256];             /* 以q + 128为下标 */
+    float scale;
+    int32_t zero_point;
+    vision_fix_func_t func;
+    uint8_t valid;
+} vision_fix_lut_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 生成sigmoid/exp的插值表，可重复调用；用vision_fix_sigmoid/exp之前调用一次
+void vision_fix_init(void);
+// 量化参数或函数变了才重新生成，LINEAR的结果限制在±32.0以内
+void vision_fix_lut_update(vision_fix_lut_t *lut, float scale, int32_t zero_point,
+                           vision_fix_func_t func);
+// 输入Q12，输出Q15。sigmoid在±16以外饱和；exp只接受x <= 0，低于-16时为0
+int32_t vision_fix_sigmoid(int32_t x);
+int32_t vision_fix_exp(int32_t x);
+
+static inline int32_t vision_fix_lut_s8(const vision_fix_lut_t *lut, int8_t q)
+{
+    return lut->value[q + 128];
+}
+
+static inline int32_t vision_fix_mul(int32_t a, int32_t b)
+{
+    return (int32_t)(((int64_t)a * b + (VISION_FIX_ONE >> 1)) >> VISION_FIX_Q);
+}
+
+static inline int32_t vision_fix_from_float(float v)
+{
+    return (int32_t)(v * VISION_FIX_ONE + (v >= 0 ? 0.5f : -0.5f));
+}
+
+/*
+ * 两个轴对齐框的交并比，Q15。坐标为非负整数，边界含x0不含x1。
+ * 只用32位整数和一次硬件除法：并集超过16位时交集和并集一起
+ * 舍入右移，交集左移15位后仍放得进32位，误差在1 LSB左右。
+ */
+static inline int32_t vision_fix_iou(int32_t ax0, int32_t ay0, int32_t ax1, int32_t ay1,
+                                     int32_t bx0, int32_t by0, int32_t bx1, int32_t by1)
+{
+    int32_t w = (ax1 < bx1 ? ax1 : bx1) - (ax0 > bx0 ? ax0 : bx0);
+    int32_t h = (ay1 < by1 ? ay1 : by1) - (ay0 > by0 ? ay0 : by0);
+    uint32_t inter, area;
+    int shift;
+
+    if (w <= 0 || h <= 0) {
+        return 0;
+    }
+    inter = (uint32_t)w * (uint32_t)h;
+    area = (uint32_t)(ax1 - ax0) * (uint32_t)(ay1 - ay0) +
+           (uint32_t)(bx1 - bx0) * (uint32_t)(by1 - by0) - inter;
+    if (area == 0) {
+        return 0;
+    }
+    shift = 16 - __builtin_clz(area);
+    if (shift > 0) {
+        inter = (inter + (1u << (shift - 1))) >> shift;
+        area = (area + (1u << (shift - 1))) >> shift;
+    }
+    return (int32_t)(((inter << VISION_FIX_Q) + area / 2) / area);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_FIX_H_ */
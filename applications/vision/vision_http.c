@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include "vision_runtime.h"
+#include "http_server.h"
+#include "json_writer.h"
+
+// 周期数换算成微秒，超出int32的按上限输出
+static rt_int32_t vision_us(uint64_t ticks)
+{
+    uint64_t us = ticks / VISION_TICKS_PER_US;
+
+    return us > 0x7fffffff ? 0x7fffffff : (rt_int32_t)us;
+}
+
+static void vision_json_latency(json_writer_t *w, const vision_runtime_info_t *info)
+{
+    uint32_t n = info->profiled ? info->profiled : 1;
+    int i;
+
+    json_object_begin(w);
+    json_key(w, "profiled");
+    json_int(w, info->profiled);
+    json_key(w, "last_us");
+    json_int(w, vision_us(info->ticks_last));
+    json_key(w, "min_us");
+    json_int(w, info->profiled ? vision_us(info->ticks_min) : 0);
+    json_key(w, "avg_us");
+    json_int(w, vision_us(info->ticks_total / n));
+    json_key(w, "max_us");
+    json_int(w, vision_us(info->ticks_max));
+    // 每个桶为[上一个上界, le_ms)，最后一个桶le_ms为null
+    json_key(w, "hist");
+    json_array_begin(w);
+    for (i = 0; i < VISION_HIST_BINS; i++) {
+        json_object_begin(w);
+        json_key(w, "le_ms");
+        if (i < VISION_HIST_BINS - 1) {
+            json_int(w, vision_hist_ms[i]);
+        } else {
+            json_null(w);
+        }
+        json_key(w, "count");
+        json_int(w, info->hist[i]);
+        json_object_end(w);
+    }
+    json_array_end(w);
+    json_object_end(w);
+}
+
+static void vision_json_ops(json_writer_t *w, const vision_runtime_info_t *info)
+{
+    vision_op_stat_t ops[VISION_PROFILE_OPS];
+    uint32_t n = info->profiled ? info->profiled : 1;
+    uint64_t sum = 0;
+    int num, i;
+
+    num = vision_runtime_ops(ops, VISION_PROFILE_OPS);
+    for (i = 0; i < num; i++) {
+        sum += ops[i].ticks_total;
+    }
+    json_array_begin(w);
+    for (i = 0; i < num; i++) {
+        json_object_begin(w);
+        json_key(w, "op");
+        json_string(w, ops[i].tag);
+        json_key(w, "layers");
+        json_int(w, ops[i].layers);
+        json_key(w, "avg_us");
+        json_int(w, vision_us(ops[i].ticks_total / n));
+        json_key(w, "share");
+        json_fixed(w, sum ? (rt_int32_t)(ops[i].ticks_total * 1000 / sum) : 0, 1);
+        json_object_end(w);
+    }
+    json_array_end(w);
+}
+
+static void vision_json_layers(json_writer_t *w, const vision_runtime_info_t *info)
+{
+    const vision_layer_stat_t *layers = vision_runtime_layers();
+    uint32_t n = info->profiled ? info->profiled : 1;
+    int i;
+
+    json_array_begin(w);
+    for (i = 0; i < info->layer_num && w->error == RT_EOK; i++) {
+        json_object_begin(w);
+        json_key(w, "op");
+        json_string(w, layers[i].tag ? layers[i].tag : "?");
+        json_key(w, "avg_us");
+        json_int(w, vision_us(layers[i].ticks_total / n));
+        json_key(w, "max_us");
+        json_int(w, vision_us(layers[i].ticks_max));
+        json_object_end(w);
+    }
+    json_array_end(w);
+}
+
+/*
+ * GET /api/vision/profile，推理耗时分布、按算子类型和逐层的耗时、arena用量，
+ * 与vision_info的输出对应。统计由视觉线程更新，这里直接读取不加锁，
+ * 个别数值可能来自相邻两帧。
+ */
+static void vision_profile_handler(http_request_t *req)
+{
+    const vision_runtime_info_t *info = vision_runtime_info();
+    char buf[HTTP_CHUNK_SIZE];
+    json_writer_t w;
+    int sock = req->sock;
+
+    if (info->model == RT_NULL) {
+        http_send_simple(sock, 503, "vision runtime not loaded");
+        return;
+    }
+
+    http_send_header(sock, 200, "application/json", -1);
+    json_writer_init(&w, buf, sizeof(buf), http_chunk_flush, &sock);
+    json_object_begin(&w);
+    json_key(&w, "model");
+    json_string(&w, info->model);
+    json_key(&w, "invokes");
+    json_int(&w, info->invokes);
+    json_key(&w, "arena");
+    json_object_begin(&w);
+    json_key(&w, "size");
+    json_int(&w, info->arena_size);
+    json_key(&w, "used");
+    json_int(&w, info->arena_used);
+    json_key(&w, "peak");
+    json_int(&w, info->arena_peak);
+    json_key(&w, "hot");
+    json_bool(&w, info->hot_arena);
+    json_object_end(&w);
+    json_key(&w, "latency");
+    vision_json_latency(&w, info);
+    json_key(&w, "ops");
+    vision_json_ops(&w, info);
+    json_key(&w, "layers");
+    vision_json_layers(&w, info);
+    json_object_end(&w);
+    if (json_writer_finish(&w) == RT_EOK) {
+        http_chunk_end(sock);
+    }
+}
+HTTP_ROUTE_EXPORT(vision_profile, HTTP_GET, "/api/vision/profile", vision_profile_handler,
+                  HTTP_ROUTE_SLOW);
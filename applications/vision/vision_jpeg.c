@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include "vision_jpeg.h"
+
+static const uint8_t zigzag[64] =
+{
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+};
+
+// ITU-T T.81 附录K的标准量化表，自然顺序
+static const uint8_t std_qt[2][64] =
+{
+    {
+        16,  11,  10,  16,  24,  40,  51,  61,
+        12,  12,  14,  19,  26,  58,  60,  55,
+        14,  13,  16,  24,  40,  57,  69,  56,
+        14,  17,  22,  29,  51,  87,  80,  62,
+        18,  22,  37,  56,  68, 109, 103,  77,
+        24,  35,  55,  64,  81, 104, 113,  92,
+        49,  64,  78,  87, 103, 121, 120, 101,
+        72,  92,  95,  98, 112, 100, 103,  99,
+    },
+    {
+        17,  18,  24,  47,  99,  99,  99,  99,
+        18,  21,  26,  66,  99,  99,  99,  99,
+        24,  26,  56,  99,  99,  99,  99,  99,
+        47,  66,  99,  99,  99,  99,  99,  99,
+        99,  99,  99,  99,  99,  99,  99,  99,
+        99,  99,  99,  99,  99,  99,  99,  99,
+        99,  99,  99,  99,  99,  99,  99,  99,
+        99,  99,  99,  99,  99,  99,  99,  99,
+    },
+};
+
+// 附录K的标准Huffman表：各码长的码字个数和按码长排列的符号
+static const uint8_t dc_bits[2][16] =
+{
+    {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0},
+    {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0},
+};
+
+static const uint8_t dc_vals[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+static const uint8_t ac_bits[2][16] =
+{
+    {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d},
+    {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77},
+};
+
+static const uint8_t ac_vals[2][162] =
+{
+    {
+        0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+        0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+        0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+        0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+        0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+        0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+        0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+        0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+        0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+        0xf9, 0xfa,
+    },
+    {
+        0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+        0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0,
+        0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+        0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+        0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+        0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+        0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5,
+        0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+        0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+        0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+        0xf9, 0xfa,
+    },
+};
+
+// AAN DCT各频率的缩放因子
+static const float aan_scale[8] =
+{
+    1.0f, 1.387039845f, 1.306562965f, 1.175875602f,
+    1.0f, 0.785694958f, 0.541196100f, 0.275899379f,
+};
+
+static void jpeg_huff_build(vision_jpeg_huff_t *huff, const uint8_t *bits, const uint8_t *vals)
+{
+    uint16_t code = 0;
+    int len, i, k = 0;
+
+    memset(huff, 0, sizeof(*huff));
+    for (len = 1; len <= 16; len++) {
+        for (i = 0; i < bits[len - 1]; i++, k++) {
+            huff->code[vals[k]] = code++;
+            huff->size[vals[k]] = len;
+        }
+        code <<= 1;
+    }
+}
+
+void vision_jpeg_init(vision_jpeg_t *enc, int quality)
+{
+    int scale, t, i;
+
+    if (quality < 1) {
+        quality = 1;
+    } else if (quality > 100) {
+        quality = 100;
+    }
+    // 与IJG libjpeg相同的质量换算
+    scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+    enc->quality = quality;
+
+    for (t = 0; t < 2; t++) {
+        for (i = 0; i < 64; i++) {
+            int q = (std_qt[t][i] * scale + 50) / 100;
+
+            q = q < 1 ? 1 : (q > 255 ? 255 : q);
+            enc->fdtbl[t][i] = 1.0f / (q * aan_scale[i >> 3] * aan_scale[i & 7] * 8.0f);
+        }
+        for (i = 0; i < 64; i++) {
+            int q = (std_qt[t][zigzag[i]] * scale + 50) / 100;
+
+            enc->qt[t][i] = q < 1 ? 1 : (q > 255 ? 255 : q);
+        }
+        jpeg_huff_build(&enc->dc[t], dc_bits[t], dc_vals);
+        jpeg_huff_build(&enc->ac[t], ac_bits[t], ac_vals[t]);
+    }
+}
+
+static void jpeg_flush(vision_jpeg_t *enc)
+{
+    if (enc->len > 0 && !enc->error && enc->write(enc->ctx, enc->buf, enc->len) != 0) {
+        enc->error = 1;
+    }
+    enc->total += enc->len;
+    enc->len = 0;
+}
+
+static void jpeg_byte(vision_jpeg_t *enc, uint8_t byte)
+{
+    enc->buf[enc->len++] = byte;
+    if (enc->len == VISION_JPEG_BUF_SIZE) {
+        jpeg_flush(enc);
+    }
+}
+
+static void jpeg_word(vision_jpeg_t *enc, uint16_t word)
+{
+    jpeg_byte(enc, word >> 8);
+    jpeg_byte(enc, word & 0xff);
+}
+
+// 熵编码段里的0xFF后面要补0x00
+static void jpeg_bits(vision_jpeg_t *enc, uint32_t code, int size)
+{
+    enc->bits = (enc->bits << size) | (code & ((1u << size) - 1));
+    enc->nbits += size;
+    while (enc->nbits >= 8) {
+        uint8_t byte = (uint8_t)(enc->bits >> (enc->nbits - 8));
+
+        jpeg_byte(enc, byte);
+        if (byte == 0xff) {
+            jpeg_byte(enc, 0);
+        }
+        enc->nbits -= 8;
+    }
+    enc->bits &= (1u << enc->nbits) - 1;
+}
+
+static void jpeg_headers(vision_jpeg_t *enc, int width, int height, int comps)
+{
+    static const uint8_t jfif[] = {'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0};
+    int tables = comps == 1 ? 1 : 2;
+    int t, i;
+
+    jpeg_word(enc, 0xffd8);
+    jpeg_word(enc, 0xffe0);
+    jpeg_word(enc, 2 + sizeof(jfif));
+    for (i = 0; i < (int)sizeof(jfif); i++) {
+        jpeg_byte(enc, jfif[i]);
+    }
+
+    jpeg_word(enc, 0xffdb);
+    jpeg_word(enc, 2 + 65 * tables);
+    for (t = 0; t < tables; t++) {
+        jpeg_byte(enc, t);
+        for (i = 0; i < 64; i++) {
+            jpeg_byte(enc, enc->qt[t][i]);
+        }
+    }
+
+    // SOF0：彩色时Y为2x2采样，Cb/Cr各1x1，即4:2:0
+    jpeg_word(enc, 0xffc0);
+    jpeg_word(enc, 8 + 3 * comps);
+    jpeg_byte(enc, 8);
+    jpeg_word(enc, height);
+    jpeg_word(enc, width);
+    jpeg_byte(enc, comps);
+    for (i = 0; i < comps; i++) {
+        jpeg_byte(enc, i + 1);
+        jpeg_byte(enc, i == 0 && comps > 1 ? 0x22 : 0x11);
+        jpeg_byte(enc, i == 0 ? 0 : 1);
+    }
+
+    jpeg_word(enc, 0xffc4);
+    jpeg_word(enc, 2 + tables * (17 + 12 + 17 + 162));
+    for (t = 0; t < tables; t++) {
+        jpeg_byte(enc, 0x00 | t);
+        for (i = 0; i < 16; i++) {
+            jpeg_byte(enc, dc_bits[t][i]);
+        }
+        for (i = 0; i < 12; i++) {
+            jpeg_byte(enc, dc_vals[i]);
+        }
+        jpeg_byte(enc, 0x10 | t);
+        for (i = 0; i < 16; i++) {
+            jpeg_byte(enc, ac_bits[t][i]);
+        }
+        for (i = 0; i < 162; i++) {
+            jpeg_byte(enc, ac_vals[t][i]);
+        }
+    }
+
+    jpeg_word(enc, 0xffda);
+    jpeg_word(enc, 6 + 2 * comps);
+    jpeg_byte(enc, comps);
+    for (i = 0; i < comps; i++) {
+        jpeg_byte(enc, i + 1);
+        jpeg_byte(enc, i == 0 ? 0x00 : 0x11);
+    }
+    jpeg_byte(enc, 0);
+    jpeg_byte(enc, 63);
+    jpeg_byte(enc, 0);
+}
+
+// AAN浮点正向DCT，先行后列，输出的缩放并入了fdtbl
+static void jpeg_fdct(float *d, int stride, int step)
+{
+    float t0, t1, t2, t3, t4, t5, t6, t7, t10, t11, t12, t13;
+    float z1, z2, z3, z4, z5, z11, z13;
+    int i;
+
+    for (i = 0; i < 8; i++, d += stride) {
+        t0 = d[0 * step] + d[7 * step];
+        t7 = d[0 * step] - d[7 * step];
+        t1 = d[1 * step] + d[6 * step];
+        t6 = d[1 * step] - d[6 * step];
+        t2 = d[2 * step] + d[5 * step];
+        t5 = d[2 * step] - d[5 * step];
+        t3 = d[3 * step] + d[4 * step];
+        t4 = d[3 * step] - d[4 * step];
+
+        t10 = t0 + t3;
+        t13 = t0 - t3;
+        t11 = t1 + t2;
+        t12 = t1 - t2;
+        d[0 * step] = t10 + t11;
+        d[4 * step] = t10 - t11;
+        z1 = (t12 + t13) * 0.707106781f;
+        d[2 * step] = t13 + z1;
+        d[6 * step] = t13 - z1;
+
+        t10 = t4 + t5;
+        t11 = t5 + t6;
+        t12 = t6 + t7;
+        z5 = (t10 - t12) * 0.382683433f;
+        z2 = 0.541196100f * t10 + z5;
+        z4 = 1.306562965f * t12 + z5;
+        z3 = t11 * 0.707106781f;
+        z11 = t7 + z3;
+        z13 = t7 - z3;
+        d[5 * step] = z13 + z2;
+        d[3 * step] = z13 - z2;
+        d[1 * step] = z11 + z4;
+        d[7 * step] = z11 - z4;
+    }
+}
+
+static int jpeg_category(int v)
+{
+    int n = 0;
+
+    if (v < 0) {
+        v = -v;
+    }
+    while (v) {
+        n++;
+        v >>= 1;
+    }
+    return n;
+}
+
+// 负数按T.81写成v-1的低size位
+static void jpeg_value(vision_jpeg_t *enc, const vision_jpeg_huff_t *huff, int symbol, int v,
+                       int size)
+{
+    jpeg_bits(enc, huff->code[symbol], huff->size[symbol]);
+    if (size > 0) {
+        jpeg_bits(enc, v < 0 ? v - 1 : v, size);
+    }
+}
+
+static void jpeg_block(vision_jpeg_t *enc, float *blk, int table, int *dc_pred)
+{
+    const float *fdtbl = enc->fdtbl[table];
+    const vision_jpeg_huff_t *ac = &enc->ac[table];
+    int q[64], diff, size, run = 0, i;
+
+    jpeg_fdct(blk, 8, 1);
+    jpeg_fdct(blk, 1, 8);
+    for (i = 0; i < 64; i++) {
+        float v = blk[zigzag[i]] * fdtbl[zigzag[i]];
+
+        q[i] = (int)(v < 0 ? v - 0.5f : v + 0.5f);
+    }
+
+    diff = q[0] - *dc_pred;
+    *dc_pred = q[0];
+    size = jpeg_category(diff);
+    jpeg_value(enc, &enc->dc[table], size, diff, size);
+
+    for (i = 1; i < 64; i++) {
+        if (q[i] == 0) {
+            run++;
+            continue;
+        }
+        // 16个以上连续的0用ZRL(0xF0)
+        while (run > 15) {
+            jpeg_bits(enc, ac->code[0xf0], ac->size[0xf0]);
+            run -= 16;
+        }
+        size = jpeg_category(q[i]);
+        jpeg_value(enc, ac, (run << 4) | size, q[i], size);
+        run = 0;
+    }
+    if (run > 0) {
+        jpeg_bits(enc, ac->code[0x00], ac->size[0x00]);
+    }
+}
+
+static uint8_t jpeg_clamp(int v)
+{
+    return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+static void jpeg_pixel(const uint8_t *row, vision_pixfmt_t format, int x, int rgb[3])
+{
+    const uint8_t *p;
+    int y, u, v;
+
+    switch (format) {
+    case VISION_PIXFMT_RGB565:
+        p = row + x * 2;
+        rgb[0] = (p[1] & 0xf8) | (p[1] >> 5);
+        rgb[1] = ((p[1] & 0x07) << 5) | ((p[0] & 0xe0) >> 3) | ((p[1] & 0x07) >> 1);
+        rgb[2] = ((p[0] & 0x1f) << 3) | ((p[0] & 0x1f) >> 2);
+        break;
+    case VISION_PIXFMT_YUV422:
+        p = row + (x & ~1) * 2;
+        y = p[(x & 1) * 2];
+        u = p[1] - 128;
+        v = p[3] - 128;
+        rgb[0] = jpeg_clamp(y + ((359 * v) >> 8));
+        rgb[1] = jpeg_clamp(y - ((88 * u + 183 * v) >> 8));
+        rgb[2] = jpeg_clamp(y + ((454 * u) >> 8));
+        break;
+    case VISION_PIXFMT_RGB888:
+        p = row + x * 3;
+        rgb[0] = p[0];
+        rgb[1] = p[1];
+        rgb[2] = p[2];
+        break;
+    default:
+        rgb[0] = rgb[1] = rgb[2] = row[x];
+        break;
+    }
+}
+
+/*
+ * 取出(mx, my)处16x16的MCU：4个Y块按左上、右上、左下、右下排列，
+ * Cb/Cr为2x2平均。超出图像的部分复制边缘像素。
+ */
+static void jpeg_mcu_color(vision_jpeg_t *enc, const uint8_t *image, int width, int height,
+                           size_t stride, vision_pixfmt_t format, int mx, int my)
+{
+    float *cb = enc->block[4], *cr = enc->block[5];
+    int x, y, rgb[3];
+
+    memset(cb, 0, sizeof(enc->block[4]) * 2);
+    for (y = 0; y < 16; y++) {
+        int sy = my + y < height ? my + y : height - 1;
+        const uint8_t *row = image + (size_t)sy * stride;
+
+        for (x = 0; x < 16; x++) {
+            int sx = mx + x < width ? mx + x : width - 1;
+            float *lum = enc->block[(y >> 3) * 2 + (x >> 3)];
+            int c = (y >> 1) * 8 + (x >> 1);
+
+            jpeg_pixel(row, format, sx, rgb);
+            lum[(y & 7) * 8 + (x & 7)] = 0.299f * rgb[0] + 0.587f * rgb[1] + 0.114f * rgb[2] - 128;
+            cb[c] += 0.25f * (-0.168736f * rgb[0] - 0.331264f * rgb[1] + 0.5f * rgb[2]);
+            cr[c] += 0.25f * (0.5f * rgb[0] - 0.418688f * rgb[1] - 0.081312f * rgb[2]);
+        }
+    }
+}
+
+static void jpeg_mcu_gray(vision_jpeg_t *enc, const uint8_t *image, int width, int height,
+                          size_t stride, vision_pixfmt_t format, int mx, int my)
+{
+    int x, y, rgb[3];
+
+    for (y = 0; y < 8; y++) {
+        int sy = my + y < height ? my + y : height - 1;
+        const uint8_t *row = image + (size_t)sy * stride;
+
+        for (x = 0; x < 8; x++) {
+            jpeg_pixel(row, format, mx + x < width ? mx + x : width - 1, rgb);
+            enc->block[0][y * 8 + x] = rgb[0] - 128.0f;
+        }
+    }
+}
+
+int vision_jpeg_encode(vision_jpeg_t *enc, const uint8_t *image, int width, int height,
+                       vision_pixfmt_t format, vision_jpeg_write_t write, void *ctx)
+{
+    size_t stride = vision_pixfmt_size(format, width, 1);
+    int gray = format == VISION_PIXFMT_GRAY;
+    int mcu = gray ? 8 : 16;
+    int dc[3] = {0, 0, 0};
+    int mx, my, i;
+
+    if (stride == 0 || width < 1 || height < 1 || width > 0xffff || height > 0xffff) {
+        return -1;
+    }
+    enc->write = write;
+    enc->ctx = ctx;
+    enc->len = 0;
+    enc->total = 0;
+    enc->error = 0;
+    enc->bits = 0;
+    enc->nbits = 0;
+
+    jpeg_headers(enc, width, height, gray ? 1 : 3);
+    for (my = 0; my < height && !enc->error; my += mcu) {
+        for (mx = 0; mx < width; mx += mcu) {
+            if (gray) {
+                jpeg_mcu_gray(enc, image, width, height, stride, format, mx, my);
+                jpeg_block(enc, enc->block[0], 0, &dc[0]);
+                continue;
+            }
+            jpeg_mcu_color(enc, image, width, height, stride, format, mx, my);
+            for (i = 0; i < 4; i++) {
+                jpeg_block(enc, enc->block[i], 0, &dc[0]);
+            }
+            jpeg_block(enc, enc->block[4], 1, &dc[1]);
+            jpeg_block(enc, enc->block[5], 1, &dc[2]);
+        }
+    }
+
+    // 剩余的位用1补齐到整字节
+    if (enc->nbits > 0) {
+        jpeg_bits(enc, 0x7f, 8 - enc->nbits);
+    }
+    jpeg_word(enc, 0xffd9);
+    jpeg_flush(enc);
+
+    return enc->error ? -1 : (int)enc->total;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_JPEG_H_
+#define APPLICATIONS_VISION_VISION_JPEG_H_
+
+#include "vision_camera.h"
+
+/*
+ * 定长内存的基线JPEG编码器。彩色按YCbCr 4:2:0、灰度按单分量编码，
+ * 使用标准Huffman表和按质量缩放的标准量化表。全部状态在vision_jpeg_t里，
+ * 不做动态分配；码流攒满VISION_JPEG_BUF_SIZE就交给写回调。
+ */
+#define VISION_JPEG_BUF_SIZE        1024
+
+// 写回调，返回非0时编码中止
+typedef int (*vision_jpeg_write_t)(void *ctx, const uint8_t *data, size_t len);
+
+typedef struct vision_jpeg_huff_
+{
+    uint16_t code[256];
+    uint8_t size[256];
+} vision_jpeg_huff_t;
+
+typedef struct vision_jpeg_
+{
+    int quality;
+    uint8_t qt[2][64];              /* 亮度/色度量化表，zigzag顺序，写入DQT */
+    float fdtbl[2][64];             /* 同上，已并入AAN DCT的缩放，自然顺序 */
+    vision_jpeg_huff_t dc[2];
+    vision_jpeg_huff_t ac[2];
+    float block[6][64];             /* 一个MCU：4个Y块 + Cb + Cr */
+
+    vision_jpeg_write_t write;
+    void *ctx;
+    uint8_t buf[VISION_JPEG_BUF_SIZE];
+    size_t len;
+    size_t total;
+    int error;
+    uint32_t bits;
+    int nbits;
+} vision_jpeg_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 按质量（1~100）生成量化表，建Huffman码表，同一质量只需调用一次
+void vision_jpeg_init(vision_jpeg_t *enc, int quality);
+// 编码一帧，返回写出的字节数，不支持的格式或写回调失败返回负数
+int vision_jpeg_encode(vision_jpeg_t *enc, const uint8_t *image, int width, int height,
+                       vision_pixfmt_t format, vision_jpeg_write_t write, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_JPEG_H_ */
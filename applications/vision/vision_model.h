@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_MODEL_H_
+#define APPLICATIONS_VISION_VISION_MODEL_H_
+
+#include "vision_port.h"
+
+/*
+ * 模型描述：flatbuffer数据和它需要的算子。每个模型只注册自己用到的
+ * 算子，未用到的内核不会被链接。C代码只通过指针引用描述符。
+ */
+typedef struct vision_model vision_model_t;
+
+#ifdef __cplusplus
+
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+
+#define VISION_OP_MAX             16      /* 单个模型可注册的算子数 */
+
+typedef tflite::MicroMutableOpResolver<VISION_OP_MAX> vision_resolver_t;
+
+struct vision_model
+{
+    const char *name;
+    const uint8_t *data;
+    size_t size;
+    int (*add_ops)(vision_resolver_t &resolver);
+};
+
+#define VISION_MODEL_ADD_OP(op)                                                     \
+    if (resolver.Add##op() != kTfLiteOk) {                                          \
+        return -1;                                                                  \
+    }
+
+/*
+ * 定义一个模型描述符。ops为算子列表宏，形如
+ *   #define XXX_MODEL_OPS(OP) OP(Conv2D) OP(Reshape) ...
+ * 名称同MicroMutableOpResolver的AddXxx。
+ */
+#define VISION_MODEL_DEFINE(var, name, data, size, ops)                             \
+    static int var##_add_ops(vision_resolver_t &resolver)                           \
+    {                                                                               \
+        ops(VISION_MODEL_ADD_OP)                                                    \
+        return 0;                                                                   \
+    }                                                                               \
+    extern "C" const vision_model_t var = {name, data, size, var##_add_ops}
+
+#endif /* __cplusplus */
+
+#endif /* APPLICATIONS_VISION_VISION_MODEL_H_ */
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include "vision_port.h"
+
+void vision_port_init(void)
+{
+#ifndef VISION_HOST
+    rt_hw_cycle_counter_enable();
+#endif
+}
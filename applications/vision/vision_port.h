@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_PORT_H_
+#define APPLICATIONS_VISION_VISION_PORT_H_
+
+/*
+ * 视觉模块的移植层。模块内的推理、前后处理代码只依赖本文件，
+ * 定义VISION_HOST时在Linux上编译，用于拿同一个模型做回归测试。
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef VISION_HOST
+
+#include <stdio.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define vision_log                  printf
+#define vision_snprintf             snprintf
+#define VISION_SECTION_SDRAM
+#define VISION_SECTION_DTCM
+#define VISION_SECTION_ITCM
+#define VISION_TICKS_PER_US         1000u       /* 主机上以纳秒计时 */
+
+// 主机端是单线程的，锁为空，信号量退化为计数
+typedef int vision_lock_t;
+#define vision_lock()               0
+#define vision_unlock(level)        ((void)(level))
+
+typedef int vision_sem_t;
+#define vision_sem_init(s, name)    (*(s) = 0)
+#define vision_sem_give(s)          ((*(s))++)
+#define vision_sem_take(s, ms)      ((void)(ms), *(s) > 0 ? ((*(s))--, 0) : -1)
+
+#define vision_dcache_invalidate(addr, size)
+
+static inline uint32_t vision_ticks(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+
+#else
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <dfs_posix.h>
+#include "board.h"
+
+#define vision_log                  rt_kprintf
+#define vision_snprintf             rt_snprintf
+// 各段的用途见board.h
+#define VISION_SECTION_SDRAM        BSP_SECTION_SDRAM       /* FMC SDRAM */
+#define VISION_SECTION_DTCM         BSP_SECTION_DTCM        /* DTCM，零等待且不经过D-Cache */
+#define VISION_SECTION_ITCM         BSP_SECTION_ITCM        /* 每帧都跑的内循环，免去QSPI取指 */
+#define VISION_TICKS_PER_US         (SystemCoreClock / 1000000u)
+
+// 摄像头状态在DMA中断里修改，用关中断保护
+typedef rt_base_t vision_lock_t;
+#define vision_lock()               rt_hw_interrupt_disable()
+#define vision_unlock(level)        rt_hw_interrupt_enable(level)
+
+typedef struct rt_semaphore vision_sem_t;
+#define vision_sem_init(s, name)    rt_sem_init(s, name, 0, RT_IPC_FLAG_FIFO)
+#define vision_sem_give(s)          rt_sem_release(s)
+#define vision_sem_take(s, ms)      (rt_sem_take(s, rt_tick_from_millisecond(ms)) == RT_EOK ? 0 : -1)
+
+/*
+ * SDRAM和AXI SRAM在drv_mpu.c中都配置为可缓存（写通），DMA写入后
+ * CPU读之前必须按32字节cache行失效，缓冲区也要按32字节对齐。
+ */
+#define vision_dcache_invalidate(addr, size) \
+    SCB_InvalidateDCache_by_Addr((uint32_t *)(addr), (int32_t)(size))
+
+// DWT周期计数器，由vision_port_init打开
+static inline uint32_t vision_ticks(void)
+{
+    return DWT->CYCCNT;
+}
+
+#endif /* VISION_HOST */
+
+#define VISION_CACHE_LINE           32
+#define VISION_CACHE_ALIGN(size)    (((size) + VISION_CACHE_LINE - 1) & ~(VISION_CACHE_LINE - 1))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 打开计时器等，模块内任何计时之前调用一次，可重复调用
+void vision_port_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_PORT_H_ */
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <math.h>
+#include "vision_preproc.h"
+
+/*
+ * 双线性缩放按行分离：源图的一行先做颜色转换和水平插值，结果放进DTCM中的
+ * 两行缓存；输出行只做垂直插值和查表量化，直接写入输入张量。
+ * 每个源行只被读一次，中间结果不落到SDRAM。权重为Q7定点。
+ */
+#define PREPROC_Q               7
+#define PREPROC_ONE             (1 << PREPROC_Q)
+
+/*
+ * 两个权重打包在一个字里：低16位给a，高16位给b。
+ * M7上一条SMUAD完成a * wa + b * wb，要求a、b都能放进有符号16位。
+ */
+#if defined(__ARM_FEATURE_DSP) && !defined(VISION_HOST)
+#define PREPROC_BLEND(a, b, w)  ((int32_t)__SMUAD(__PKHBT((a), (b), 16), (w)))
+#else
+#define PREPROC_BLEND(a, b, w)  ((int32_t)(a) * (int32_t)((w) & 0xffff) + \
+                                 (int32_t)(b) * (int32_t)((w) >> 16))
+#endif
+#define PREPROC_WEIGHT(f)       ((uint32_t)(PREPROC_ONE - (f)) | ((uint32_t)(f) << 16))
+
+// 像素值(0~255) -> 量化值的查表，按当前输入张量的量化参数生成，每个输出字节查一次
+static uint8_t quant_lut[256] VISION_SECTION_DTCM;
+static float lut_scale;
+static int32_t lut_zero_point;
+static vision_type_t lut_type = VISION_TYPE_OTHER;
+
+// 列映射表与两行缓存，DTCM是NOLOAD段，全部在运行时初始化
+static uint16_t col_x0[VISION_PREPROC_OUT_MAX] VISION_SECTION_DTCM;
+static uint32_t col_w[VISION_PREPROC_OUT_MAX] VISION_SECTION_DTCM;
+static int16_t line_buf[2][VISION_PREPROC_OUT_MAX * 3] VISION_SECTION_DTCM;
+static int col_src_w, col_dst_w;
+
+static void preproc_lut_update(const vision_tensor_t *input)
+{
+    int i;
+
+    if (lut_type == input->type && lut_scale == input->scale &&
+        lut_zero_point == input->zero_point) {
+        return;
+    }
+    for (i = 0; i < 256; i++) {
+        int32_t q = (int32_t)lroundf(i / 255.0f / input->scale) + input->zero_point;
+
+        if (input->type == VISION_TYPE_INT8) {
+            q = q < -128 ? -128 : (q > 127 ? 127 : q);
+        } else {
+            q = q < 0 ? 0 : (q > 255 ? 255 : q);
+        }
+        quant_lut[i] = (uint8_t)q;
+    }
+    lut_type = input->type;
+    lut_scale = input->scale;
+    lut_zero_point = input->zero_point;
+}
+
+/*
+ * 像素中心对齐：src = (dst + 0.5) * src_n / dst_n - 0.5，Q7定点。
+ * 保证x0 + 1不越界：落在最后一个像素上时x0退回src_n - 2，权重全给x0 + 1，
+ * 即取最后一个像素本身。左边缘pos截到0，权重全给x0。
+ */
+static void preproc_map(int dst, int src_n, int dst_n, uint16_t *x0, uint32_t *w)
+{
+    int32_t pos = ((2 * dst + 1) * src_n * PREPROC_ONE) / (2 * dst_n) - PREPROC_ONE / 2;
+    int32_t i, f;
+
+    if (pos < 0) {
+        pos = 0;
+    }
+    i = pos >> PREPROC_Q;
+    f = pos & (PREPROC_ONE - 1);
+    if (i >= src_n - 1) {
+        i = src_n - 2;
+        f = PREPROC_ONE;
+    }
+    *x0 = (uint16_t)i;
+    *w = PREPROC_WEIGHT(f);
+}
+
+static void preproc_cols_update(int src_w, int dst_w)
+{
+    int x;
+
+    if (col_src_w == src_w && col_dst_w == dst_w) {
+        return;
+    }
+    for (x = 0; x < dst_w; x++) {
+        preproc_map(x, src_w, dst_w, &col_x0[x], &col_w[x]);
+    }
+    col_src_w = src_w;
+    col_dst_w = dst_w;
+}
+
+static inline uint8_t preproc_clamp(int32_t v)
+{
+    return v < 0 ? 0 : (v > 255 ? 255 : (uint8_t)v);
+}
+
+// 全范围BT.601，系数为Q8
+static inline void preproc_yuv(int32_t y, int32_t u, int32_t v, int32_t *rgb)
+{
+    u -= 128;
+    v -= 128;
+    rgb[0] = preproc_clamp(y + ((359 * v) >> 8));
+    rgb[1] = preproc_clamp(y - ((88 * u + 183 * v) >> 8));
+    rgb[2] = preproc_clamp(y + ((454 * u) >> 8));
+}
+
+static inline __attribute__((always_inline))
+void preproc_pixel(const uint8_t *row, int x, vision_pixfmt_t format, int32_t *rgb)
+{
+    const uint8_t *p;
+    uint32_t v;
+
+    switch (format) {
+    case VISION_PIXFMT_RGB565:
+        v = row[2 * x] | (row[2 * x + 1] << 8);
+        rgb[0] = ((v >> 8) & 0xf8) | (v >> 13);
+        rgb[1] = ((v >> 3) & 0xfc) | ((v >> 9) & 0x03);
+        rgb[2] = ((v << 3) & 0xf8) | ((v >> 2) & 0x07);
+        break;
+    case VISION_PIXFMT_YUV422:
+        p = row + (x & ~1) * 2;     /* Y0 U Y1 V */
+        preproc_yuv(p[(x & 1) * 2], p[1], p[3], rgb);
+        break;
+    case VISION_PIXFMT_RGB888:
+        p = row + x * 3;
+        rgb[0] = p[0];
+        rgb[1] = p[1];
+        rgb[2] = p[2];
+        break;
+    default:
+        rgb[0] = rgb[1] = rgb[2] = row[x];
+        break;
+    }
+}
+
+// 一个源行：颜色转换 + 水平插值，结果为Q7的RGB。format为常量，内联后每种格式各展开一份
+static inline __attribute__((always_inline))
+void preproc_hline_fmt(const uint8_t *row, vision_pixfmt_t format, int dst_w, int16_t *out)
+{
+    int32_t a[3], b[3];
+    int x, c;
+
+    for (x = 0; x < dst_w; x++, out += 3) {
+        uint32_t w = col_w[x];
+
+        preproc_pixel(row, col_x0[x], format, a);
+        preproc_pixel(row, col_x0[x] + 1, format, b);
+        for (c = 0; c < 3; c++) {
+            out[c] = (int16_t)PREPROC_BLEND(a[c], b[c], w);
+        }
+    }
+}
+
+static void VISION_SECTION_ITCM preproc_hline(const uint8_t *row, vision_pixfmt_t format, int dst_w, int16_t *out)
+{
+    switch (format) {
+    case VISION_PIXFMT_RGB565:
+        preproc_hline_fmt(row, VISION_PIXFMT_RGB565, dst_w, out);
+        break;
+    case VISION_PIXFMT_YUV422:
+        preproc_hline_fmt(row, VISION_PIXFMT_YUV422, dst_w, out);
+        break;
+    case VISION_PIXFMT_RGB888:
+        preproc_hline_fmt(row, VISION_PIXFMT_RGB888, dst_w, out);
+        break;
+    default:
+        preproc_hline_fmt(row, VISION_PIXFMT_GRAY, dst_w, out);
+        break;
+    }
+}
+
+// 逐像素的两层循环放在ITCM，缩放一帧不用从QSPI取指
+int VISION_SECTION_ITCM vision_preproc_image(const uint8_t *image, int width, int height,
+                                             vision_pixfmt_t format, const vision_tensor_t *input)
+{
+    int dst_w, dst_h, stride, n, y, i;
+    int line_row[2] = {-1, -1};
+    uint8_t *out = (uint8_t *)input->data;
+
+    if ((input->type != VISION_TYPE_INT8 && input->type != VISION_TYPE_UINT8) ||
+        input->scale <= 0 || input->ndims != 4 || input->dims[3] != 3) {
+        return -1;
+    }
+    dst_h = input->dims[1];
+    dst_w = input->dims[2];
+    stride = (int)vision_pixfmt_size(format, width, 1);
+    if (stride == 0 || width < 2 || height < 2 || dst_w > VISION_PREPROC_OUT_MAX) {
+        return -1;
+    }
+    preproc_lut_update(input);
+
+    // 尺寸相同的RGB888只需量化
+    if (format == VISION_PIXFMT_RGB888 && width == dst_w && height == dst_h) {
+        for (i = 0; i < dst_w * dst_h * 3; i++) {
+            out[i] = quant_lut[image[i]];
+        }
+        return 0;
+    }
+
+    preproc_cols_update(width, dst_w);
+    n = dst_w * 3;
+    for (y = 0; y < dst_h; y++, out += n) {
+        const int16_t *l0, *l1;
+        uint16_t y0;
+        uint32_t w;
+        int slot;
+
+        preproc_map(y, height, dst_h, &y0, &w);
+
+        // 两行缓存按源行号命中，缩小时相邻输出行常常共用源行
+        for (i = 0; i < 2; i++) {
+            int need = y0 + i;
+
+            if (line_row[0] == need || line_row[1] == need) {
+                continue;
+            }
+            slot = (line_row[0] == y0 || line_row[0] == y0 + 1) ? 1 : 0;
+            preproc_hline(image + (size_t)need * stride, format, dst_w, line_buf[slot]);
+            line_row[slot] = need;
+        }
+        l0 = line_buf[line_row[0] == y0 ? 0 : 1];
+        l1 = line_buf[line_row[0] == y0 ? 1 : 0];
+
+        for (i = 0; i < n; i++) {
+            int32_t v = (PREPROC_BLEND(l0[i], l1[i], w) + (1 << (2 * PREPROC_Q - 1))) >> (2 * PREPROC_Q);
+
+            out[i] = quant_lut[v > 255 ? 255 : v];
+        }
+    }
+    return 0;
+}
+
+int vision_preproc_frame(const struct vision_camera *cam, const uint8_t *frame,
+                         const vision_tensor_t *input)
+{
+    return vision_preproc_image(frame, cam->width, cam->height, cam->format, input);
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_PREPROC_H_
+#define APPLICATIONS_VISION_VISION_PREPROC_H_
+
+#include "vision_runtime.h"
+#include "vision_camera.h"
+
+#define VISION_PREPROC_OUT_MAX     320     /* 输出（模型输入）宽度上限 */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 单趟完成颜色转换、双线性缩放到张量尺寸和量化，直接写进模型输入张量
+ * （NHWC，int8/uint8），中间不经过整帧的临时缓冲。量化按输入张量的
+ * scale/zero_point查表完成。不支持的格式或尺寸返回负数。
+ */
+int vision_preproc_image(const uint8_t *image, int width, int height, vision_pixfmt_t format,
+                         const vision_tensor_t *input);
+// 同上，图像参数取自摄像头
+int vision_preproc_frame(const struct vision_camera *cam, const uint8_t *frame,
+                         const vision_tensor_t *input);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_PREPROC_H_ */
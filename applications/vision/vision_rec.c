@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <rtthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include "vision_rec.h"
+#include "vision_jpeg.h"
+#include "http_server.h"
+#include "json_writer.h"
+
+#define REC_NAME_MAX        48      /* NNNNNNNN-YYYYMMDD_HHMMSS_<原因>.jpg */
+#define REC_SEQ_DIGITS      8       /* 与文件名格式中的%08u一致 */
+
+static uint8_t rec_frame[VISION_CAMERA_FRAME_MAX] VISION_SECTION_SDRAM;
+static vision_jpeg_t rec_jpeg;
+
+static struct
+{
+    struct rt_semaphore sem;
+    volatile int busy;              /* rec_frame中有待编码的帧 */
+    const char *volatile trigger;   /* 待执行的事件抓拍 */
+    uint32_t period_s;
+    rt_tick_t last_tick;
+    rt_bool_t started;
+    uint32_t seq;                   /* 下一张的序号，0为尚未从目录里找出 */
+
+    // 待编码帧的参数，busy期间只由编码线程读
+    const char *reason;
+    int width;
+    int height;
+    vision_pixfmt_t format;
+
+    struct vision_rec_stats stats;
+} rec = {.period_s = VISION_REC_PERIOD_S};
+
+// /api/snapshots的列表缓冲，两个slow工作线程共用
+static char list_names[VISION_REC_LIST_MAX][REC_NAME_MAX];
+static rt_mutex_t list_lock;
+
+void vision_rec_frame(const struct vision_camera *cam, const uint8_t *frame)
+{
+    rt_tick_t now = rt_tick_get();
+    const char *reason = rec.trigger;
+
+    if (reason == RT_NULL && rec.period_s > 0 &&
+        (!rec.started || now - rec.last_tick >= rec.period_s * RT_TICK_PER_SECOND)) {
+        reason = "timelapse";
+    }
+    if (reason == RT_NULL) {
+        return;
+    }
+    if (rec.busy) {
+        rec.stats.deferred++;
+        return;
+    }
+
+    rt_memcpy(rec_frame, frame, cam->frame_size);
+    rec.width = cam->width;
+    rec.height = cam->height;
+    rec.format = cam->format;
+    rec.reason = reason;
+    if (reason == rec.trigger) {
+        rec.trigger = RT_NULL;
+    } else {
+        rec.last_tick = now;
+        rec.started = RT_TRUE;
+    }
+    rec.busy = 1;
+    rt_sem_release(&rec.sem);
+}
+
+void vision_rec_trigger(const char *reason)
+{
+    rec.trigger = reason;
+}
+
+void vision_rec_set_period(uint32_t seconds)
+{
+    rec.period_s = seconds;
+    rec.started = RT_FALSE;
+}
+
+const struct vision_rec_stats *vision_rec_stats(void)
+{
+    return &rec.stats;
+}
+
+static rt_bool_t rec_is_photo(const char *name)
+{
+    rt_size_t len = rt_strlen(name);
+
+    return len > 4 && rt_strcmp(name + len - 4, ".jpg") == 0;
+}
+
+static uint32_t rec_free_kb(void)
+{
+    struct statfs fs;
+
+    if (statfs(VISION_REC_DIR, &fs) != 0) {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)fs.f_bfree * fs.f_bsize / 1024);
+}
+
+/*
+ * 照片的先后看名字前面的序号，不看时间：RTC掉电回到1970年后拍的照片
+ * 按时间排在前面，会被当成最旧的先删掉。没有序号的旧照片视为最旧。
+ */
+static uint32_t rec_seq(const char *name)
+{
+    uint32_t seq = 0;
+    int i;
+
+    for (i = 0; i < REC_SEQ_DIGITS; i++) {
+        if (name[i] < '0' || name[i] > '9') {
+            return 0;
+        }
+        seq = seq * 10 + (name[i] - '0');
+    }
+    return name[i] == '-' ? seq + 1 : 0;
+}
+
+// 名字a比b新时返回正数
+static int rec_name_cmp(const char *a, const char *b)
+{
+    uint32_t sa = rec_seq(a), sb = rec_seq(b);
+
+    if (sa != sb) {
+        return sa > sb ? 1 : -1;
+    }
+    return rt_strcmp(a, b);
+}
+
+struct rec_scan
+{
+    char oldest[REC_NAME_MAX];
+    uint32_t last_seq;              /* 最大的序号加一，没有带序号的照片时为0 */
+    uint32_t count;
+    uint32_t total_kb;              /* 照片占用的空间 */
+};
+
+static int rec_scan(struct rec_scan *s)
+{
+    char path[sizeof(VISION_REC_DIR) + REC_NAME_MAX];
+    struct dirent *ent;
+    struct stat st;
+    DIR *dir;
+
+    rt_memset(s, 0, sizeof(*s));
+    dir = opendir(VISION_REC_DIR);
+    if (dir == RT_NULL) {
+        return -1;
+    }
+    while ((ent = readdir(dir)) != RT_NULL) {
+        if (!rec_is_photo(ent->d_name) || rt_strlen(ent->d_name) >= REC_NAME_MAX) {
+            continue;
+        }
+        rt_snprintf(path, sizeof(path), "%s/%s", VISION_REC_DIR, ent->d_name);
+        if (stat(path, &st) == 0) {
+            s->total_kb += (st.st_size + 1023) / 1024;
+        }
+        if (s->count == 0 || rec_name_cmp(ent->d_name, s->oldest) < 0) {
+            rt_strncpy(s->oldest, ent->d_name, sizeof(s->oldest));
+        }
+        if (rec_seq(ent->d_name) > s->last_seq) {
+            s->last_seq = rec_seq(ent->d_name);
+        }
+        s->count++;
+    }
+    closedir(dir);
+    return 0;
+}
+
+/*
+ * 删最旧的照片直到剩余空间够用。只删录制器自己的照片：卡被别的数据
+ * 占满、照片全删了也腾不出空间时一张都不删，直接报错。
+ */
+static int rec_make_room(void)
+{
+    char path[sizeof(VISION_REC_DIR) + REC_NAME_MAX];
+    struct rec_scan s;
+    uint32_t free_kb = rec_free_kb();
+
+    while (free_kb < VISION_REC_MIN_FREE_KB) {
+        if (rec_scan(&s) != 0 || s.count == 0 || free_kb + s.total_kb < VISION_REC_MIN_FREE_KB) {
+            rt_kprintf("vision rec: %s has no room, %u KB free, photos use %u KB\n",
+                       VISION_REC_DIR, free_kb, s.total_kb);
+            return -1;
+        }
+        rt_snprintf(path, sizeof(path), "%s/%s", VISION_REC_DIR, s.oldest);
+        if (unlink(path) != 0) {
+            return -1;
+        }
+        rec.stats.deleted++;
+        free_kb = rec_free_kb();
+    }
+    return 0;
+}
+
+static int rec_write(void *ctx, const uint8_t *data, size_t len)
+{
+    int fd = *(int *)ctx;
+
+    return write(fd, data, len) == (int)len ? 0 : -1;
+}
+
+static int rec_save(void)
+{
+    char path[sizeof(VISION_REC_DIR) + REC_NAME_MAX];
+    time_t now = time(RT_NULL);
+    uint32_t start, ticks;
+    struct tm tm;
+    struct rec_scan s;
+    int fd, size;
+
+    // 卡可能是启动后才插上的，目录每次都确认一下
+    mkdir(VISION_REC_DIR, 0);
+    if (rec.seq == 0) {
+        rec.seq = rec_scan(&s) == 0 ? s.last_seq : 0;
+    }
+    if (rec_make_room() != 0) {
+        return -1;
+    }
+
+    localtime_r(&now, &tm);
+    rt_snprintf(path, sizeof(path), "%s/%08u-%04d%02d%02d_%02d%02d%02d_%s.jpg", VISION_REC_DIR,
+                (unsigned int)rec.seq, tm.tm_year + 1900, tm.tm_mon + 1,
+                tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, rec.reason);
+    rec.seq++;
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    start = vision_ticks();
+    size = vision_jpeg_encode(&rec_jpeg, rec_frame, rec.width, rec.height, rec.format,
+                              rec_write, &fd);
+    close(fd);
+    ticks = vision_ticks() - start;
+    if (size < 0) {
+        // 写了一半的文件不留下
+        unlink(path);
+        return -1;
+    }
+
+    rec.stats.shots++;
+    rec.stats.bytes_last = size;
+    rec.stats.ticks_last = ticks;
+    if (ticks > rec.stats.ticks_max) {
+        rec.stats.ticks_max = ticks;
+    }
+    return 0;
+}
+
+static void rec_thread_entry(void *param)
+{
+    while (1) {
+        rt_sem_take(&rec.sem, RT_WAITING_FOREVER);
+        if (rec_save() != 0) {
+            rec.stats.errors++;
+        }
+        rec.busy = 0;
+    }
+}
+
+// 按序号降序保留最新的VISION_REC_LIST_MAX张，返回张数
+static int rec_list(void)
+{
+    struct dirent *ent;
+    DIR *dir;
+    int num = 0, i;
+
+    dir = opendir(VISION_REC_DIR);
+    if (dir == RT_NULL) {
+        return 0;
+    }
+    while ((ent = readdir(dir)) != RT_NULL) {
+        if (!rec_is_photo(ent->d_name) || rt_strlen(ent->d_name) >= REC_NAME_MAX) {
+            continue;
+        }
+        for (i = num; i > 0 && rec_name_cmp(list_names[i - 1], ent->d_name) < 0; i--) {
+            if (i < VISION_REC_LIST_MAX) {
+                rt_strncpy(list_names[i], list_names[i - 1], REC_NAME_MAX);
+            }
+        }
+        if (i < VISION_REC_LIST_MAX) {
+            rt_strncpy(list_names[i], ent->d_name, REC_NAME_MAX);
+            if (num < VISION_REC_LIST_MAX) {
+                num++;
+            }
+        }
+    }
+    closedir(dir);
+    return num;
+}
+
+//GET /api/snapshots，最新的照片在前，图片本身经/sdcard/snap/<name>获取
+//图片所在的文件路由需要登录，列表同样需要，仪表盘的照片面板使用
+static void snapshots_handler(http_request_t *req)
+{
+    char buf[HTTP_CHUNK_SIZE];
+    json_writer_t w;
+    int sock = req->sock;
+    int num, i;
+
+    rt_mutex_take(list_lock, RT_WAITING_FOREVER);
+    num = rec_list();
+
+    http_send_header(sock, 200, "application/json", -1);
+    json_writer_init(&w, buf, sizeof(buf), http_chunk_flush, &sock);
+    json_object_begin(&w);
+    json_key(&w, "dir");
+    json_string(&w, VISION_REC_DIR);
+    json_key(&w, "period");
+    json_int(&w, rec.period_s);
+    json_key(&w, "files");
+    json_array_begin(&w);
+    for (i = 0; i < num; i++) {
+        json_string(&w, list_names[i]);
+    }
+    json_array_end(&w);
+    json_object_end(&w);
+    if (json_writer_finish(&w) == RT_EOK) {
+        http_chunk_end(sock);
+    }
+
+    rt_mutex_release(list_lock);
+}
+HTTP_ROUTE_EXPORT(snapshots, HTTP_GET, "/api/snapshots", snapshots_handler, HTTP_ROUTE_SLOW | HTTP_ROUTE_AUTH);
+
+static int vision_rec_init(void)
+{
+    rt_thread_t tid;
+
+    vision_jpeg_init(&rec_jpeg, VISION_REC_QUALITY);
+    rt_sem_init(&rec.sem, "vrec", 0, RT_IPC_FLAG_FIFO);
+    list_lock = rt_mutex_create("vrec", RT_IPC_FLAG_FIFO);
+    tid = rt_thread_create("vision_rec", rec_thread_entry, RT_NULL, VISION_REC_STACK,
+                           VISION_REC_PRIORITY, 10);
+    if (list_lock == RT_NULL || tid == RT_NULL) {
+        return -RT_ENOMEM;
+    }
+    rt_thread_startup(tid);
+    return 0;
+}
+INIT_APP_EXPORT(vision_rec_init);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void vision_rec(int argc, char **argv)
+{
+    const struct vision_rec_stats *s = &rec.stats;
+
+    if (argc == 2 && rt_strcmp(argv[1], "snap") == 0) {
+        vision_rec_trigger("manual");
+        return;
+    }
+    if (argc == 3 && rt_strcmp(argv[1], "period") == 0) {
+        vision_rec_set_period(atoi(argv[2]));
+        return;
+    }
+    if (argc != 1) {
+        rt_kprintf("usage: vision_rec [snap | period <seconds>]\n");
+        return;
+    }
+    rt_kprintf("dir        : %s, %u KB free\n", VISION_REC_DIR, rec_free_kb());
+    rt_kprintf("period     : %u s, quality %d\n", rec.period_s, rec_jpeg.quality);
+    rt_kprintf("shots      : %u, %u deferred, %u errors, %u deleted\n", s->shots, s->deferred,
+               s->errors, s->deleted);
+    rt_kprintf("last       : %u bytes, %u us, max %u us\n", s->bytes_last,
+               s->ticks_last / VISION_TICKS_PER_US, s->ticks_max / VISION_TICKS_PER_US);
+}
+MSH_CMD_EXPORT(vision_rec, show recorder status or take a snapshot: vision_rec [snap | period <s>]);
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_REC_H_
+#define APPLICATIONS_VISION_VISION_REC_H_
+
+#include "vision_camera.h"
+
+/*
+ * 抓拍与延时摄影。视觉线程在取到帧后调用vision_rec_frame，到了定时间隔
+ * 或有事件触发时把帧拷进录制器自己的缓冲，由低优先级线程编码成JPEG
+ * 写到SD卡。编码线程忙时本次抓拍顺延到下一帧，视觉线程从不等待。
+ * 文件名为NNNNNNNN-YYYYMMDD_HHMMSS_<原因>.jpg，N为递增序号，先后按序号
+ * 判断，RTC未设置或被重置时也不乱；剩余空间不足时先删最旧的，但只删
+ * 自己的照片。照片经/sdcard下的静态路由访问，需要登录。
+ */
+#define VISION_REC_DIR              "/sdcard/snap"
+#define VISION_REC_PERIOD_S         600             /* 定时抓拍间隔，0为关闭 */
+#define VISION_REC_QUALITY          75
+#define VISION_REC_MIN_FREE_KB      (64 * 1024)     /* SD卡剩余空间的下限 */
+#define VISION_REC_LIST_MAX         32              /* /api/snapshots列出的最新照片数 */
+#define VISION_REC_STACK            2048
+#define VISION_REC_PRIORITY         (RT_THREAD_PRIORITY_MAX - 4)
+
+struct vision_rec_stats
+{
+    uint32_t shots;                 /* 写成功的照片数 */
+    uint32_t deferred;              /* 编码线程忙，顺延到下一帧的次数 */
+    uint32_t errors;
+    uint32_t deleted;               /* 为腾空间删掉的旧照片数 */
+    uint32_t bytes_last;
+    uint32_t ticks_last;            /* 编码加写文件的耗时，单位见VISION_TICKS_PER_US */
+    uint32_t ticks_max;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 视觉线程取到帧后、归还前调用，只在需要抓拍且编码线程空闲时拷贝一帧
+void vision_rec_frame(const struct vision_camera *cam, const uint8_t *frame);
+// 请求在下一帧抓拍，reason写进文件名，须为常量字符串
+void vision_rec_trigger(const char *reason);
+// 修改定时抓拍间隔，0为关闭
+void vision_rec_set_period(uint32_t seconds);
+const struct vision_rec_stats *vision_rec_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_REC_H_ */
@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <new>
+#include "vision_runtime.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_allocator.h"
+#include "tensorflow/lite/micro/micro_profiler_interface.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+/*
+ * 内存布局：模型权重留在flash，arena放在32MB的SDRAM，
+ * 激活和scratch这类每层都要反复读写的非持久区优先放进DTCM。
+ */
+alignas(16) static uint8_t tensor_arena[VISION_ARENA_SIZE] VISION_SECTION_SDRAM;
+alignas(16) static uint8_t hot_arena[VISION_HOT_ARENA_SIZE] VISION_SECTION_DTCM;
+
+// 按调用顺序给每个算子计时，Invoke期间事件是顺序且不嵌套的
+class LayerProfiler : public tflite::MicroProfilerInterface
+{
+public:
+    void Reset(void)
+    {
+        count_ = 0;
+    }
+
+    void Clear(void)
+    {
+        count_ = 0;
+        memset(layers_, 0, sizeof(layers_));
+    }
+
+    void ClearTotals(void)
+    {
+        for (int i = 0; i < VISION_PROFILE_MAX; i++) {
+            layers_[i].ticks_max = 0;
+            layers_[i].ticks_total = 0;
+        }
+    }
+
+    uint32_t BeginEvent(const char *tag) override
+    {
+        uint32_t index = count_++;
+
+        if (index < VISION_PROFILE_MAX) {
+            layers_[index].tag = tag;
+            start_[index] = vision_ticks();
+        }
+        return index;
+    }
+
+    void EndEvent(uint32_t event_handle) override
+    {
+        if (event_handle < VISION_PROFILE_MAX) {
+            vision_layer_stat_t *layer = &layers_[event_handle];
+
+            layer->ticks_last = vision_ticks() - start_[event_handle];
+            if (layer->ticks_last > layer->ticks_max) {
+                layer->ticks_max = layer->ticks_last;
+            }
+            layer->ticks_total += layer->ticks_last;
+        }
+    }
+
+    int Count(void) const
+    {
+        return count_ < VISION_PROFILE_MAX ? (int)count_ : VISION_PROFILE_MAX;
+    }
+
+    const vision_layer_stat_t *Layers(void) const
+    {
+        return layers_;
+    }
+
+private:
+    uint32_t count_ = 0;
+    uint32_t start_[VISION_PROFILE_MAX] = {};
+    vision_layer_stat_t layers_[VISION_PROFILE_MAX] = {};
+};
+
+static LayerProfiler profiler;
+static vision_runtime_info_t info;
+
+extern "C" const uint16_t vision_hist_ms[VISION_HIST_BINS - 1] = {
+    5, 10, 20, 50, 100, 200, 500, 1000, 2000,
+};
+
+// 解释器和解析器放在静态存储里，换模型时原地析构再构造，不走堆
+alignas(tflite::MicroInterpreter) static uint8_t interpreter_buf[sizeof(tflite::MicroInterpreter)];
+static tflite::MicroInterpreter *interpreter = nullptr;
+alignas(vision_resolver_t) static uint8_t resolver_buf[sizeof(vision_resolver_t)];
+static vision_resolver_t *resolver = nullptr;
+
+static void vision_interpreter_drop(void)
+{
+    if (interpreter != nullptr) {
+        interpreter->~MicroInterpreter();
+        interpreter = nullptr;
+    }
+}
+
+static void vision_resolver_drop(void)
+{
+    vision_interpreter_drop();
+    if (resolver != nullptr) {
+        resolver->~vision_resolver_t();
+        resolver = nullptr;
+    }
+}
+
+static TfLiteStatus vision_interpreter_create(const tflite::Model *model, bool hot)
+{
+    tflite::MicroAllocator *allocator;
+
+    vision_interpreter_drop();
+    if (hot) {
+        // 持久区（张量描述、量化参数）留在SDRAM，非持久区放DTCM
+        allocator = tflite::MicroAllocator::Create(tensor_arena, sizeof(tensor_arena),
+                                                   hot_arena, sizeof(hot_arena));
+    } else {
+        allocator = tflite::MicroAllocator::Create(tensor_arena, sizeof(tensor_arena));
+    }
+    if (allocator == nullptr) {
+        return kTfLiteError;
+    }
+
+    interpreter = new (interpreter_buf) tflite::MicroInterpreter(model, *resolver, allocator,
+                                                                 nullptr, &profiler);
+    return interpreter->AllocateTensors();
+}
+
+extern "C" int vision_runtime_load(const vision_model_t *desc)
+{
+    return vision_runtime_load_image(desc, desc->data, desc->size);
+}
+
+extern "C" int vision_runtime_has_builtin(const vision_model_t *desc)
+{
+    return desc->data != nullptr && desc->size > 0;
+}
+
+extern "C" int vision_runtime_load_image(const vision_model_t *desc, const void *data, size_t size)
+{
+    const tflite::Model *model;
+
+    vision_port_init();
+    vision_resolver_drop();
+    memset(&info, 0, sizeof(info));
+    info.ticks_min = UINT32_MAX;
+    profiler.Clear();
+
+    if (data == nullptr || size == 0) {
+        vision_log("vision: %s has no model data\n", desc->name);
+        return -1;
+    }
+    model = tflite::GetModel(data);
+    if (model->version() != TFLITE_SCHEMA_VERSION) {
+        vision_log("vision: %s schema %d, expected %d\n", desc->name,
+                   (int)model->version(), TFLITE_SCHEMA_VERSION);
+        return -1;
+    }
+    resolver = new (resolver_buf) vision_resolver_t();
+    if (desc->add_ops(*resolver) != 0) {
+        vision_resolver_drop();
+        vision_log("vision: %s needs more than %d ops\n", desc->name, VISION_OP_MAX);
+        return -1;
+    }
+
+    info.model = desc->name;
+    info.model_data = data;
+    info.model_size = size;
+    info.arena_size = sizeof(tensor_arena);
+    if (vision_interpreter_create(model, true) == kTfLiteOk) {
+        info.hot_arena = 1;
+    } else if (vision_interpreter_create(model, false) != kTfLiteOk) {
+        // 分配失败时张量指针无效，不能继续Invoke
+        vision_resolver_drop();
+        vision_log("vision: %s AllocateTensors failed, arena %d bytes\n", desc->name,
+                   (int)sizeof(tensor_arena));
+        return -1;
+    }
+    info.arena_used = interpreter->arena_used_bytes();
+    info.arena_peak = info.arena_used;
+
+    vision_log("vision: %s arena used %d / %d bytes, scratch in %s\n", desc->name,
+               (int)info.arena_used, (int)info.arena_size, info.hot_arena ? "DTCM" : "SDRAM");
+    return 0;
+}
+
+static void vision_profile_account(uint32_t ticks)
+{
+    uint32_t ms = ticks / (VISION_TICKS_PER_US * 1000);
+    size_t used = interpreter->arena_used_bytes();
+    int bin = 0;
+
+    if (ticks > info.ticks_max) {
+        info.ticks_max = ticks;
+    }
+    if (ticks < info.ticks_min) {
+        info.ticks_min = ticks;
+    }
+    info.ticks_total += ticks;
+    info.profiled++;
+
+    while (bin < VISION_HIST_BINS - 1 && ms >= vision_hist_ms[bin]) {
+        bin++;
+    }
+    info.hist[bin]++;
+
+    // 内核在Prepare/Eval里申请的scratch也算在内
+    if (used > info.arena_peak) {
+        info.arena_peak = used;
+    }
+}
+
+extern "C" int vision_runtime_invoke(void)
+{
+    uint32_t start;
+    TfLiteStatus status;
+
+    if (interpreter == nullptr) {
+        return -1;
+    }
+
+    profiler.Reset();
+    start = vision_ticks();
+    status = interpreter->Invoke();
+    info.ticks_last = vision_ticks() - start;
+    info.invokes++;
+    info.layer_num = profiler.Count();
+    vision_profile_account(info.ticks_last);
+
+    return status == kTfLiteOk ? 0 : -1;
+}
+
+static vision_type_t vision_type(TfLiteType type)
+{
+    switch (type) {
+    case kTfLiteFloat32:
+        return VISION_TYPE_FLOAT32;
+    case kTfLiteInt8:
+        return VISION_TYPE_INT8;
+    case kTfLiteUInt8:
+        return VISION_TYPE_UINT8;
+    default:
+        return VISION_TYPE_OTHER;
+    }
+}
+
+static int vision_tensor_fill(const TfLiteTensor *t, vision_tensor_t *tensor)
+{
+    int i;
+
+    if (t == nullptr) {
+        return -1;
+    }
+
+    tensor->data = t->data.data;
+    tensor->bytes = t->bytes;
+    tensor->type = vision_type(t->type);
+    tensor->ndims = t->dims->size < VISION_DIMS_MAX ? t->dims->size : VISION_DIMS_MAX;
+    for (i = 0; i < VISION_DIMS_MAX; i++) {
+        tensor->dims[i] = i < tensor->ndims ? t->dims->data[i] : 1;
+    }
+    tensor->scale = t->params.scale;
+    tensor->zero_point = t->params.zero_point;
+    return 0;
+}
+
+extern "C" int vision_runtime_input(int index, vision_tensor_t *tensor)
+{
+    if (interpreter == nullptr || index < 0 || (size_t)index >= interpreter->inputs_size()) {
+        return -1;
+    }
+    return vision_tensor_fill(interpreter->input(index), tensor);
+}
+
+extern "C" int vision_runtime_output(int index, vision_tensor_t *tensor)
+{
+    if (interpreter == nullptr || index < 0 || (size_t)index >= interpreter->outputs_size()) {
+        return -1;
+    }
+    return vision_tensor_fill(interpreter->output(index), tensor);
+}
+
+extern "C" const vision_runtime_info_t *vision_runtime_info(void)
+{
+    return &info;
+}
+
+extern "C" const vision_layer_stat_t *vision_runtime_layers(void)
+{
+    return profiler.Layers();
+}
+
+extern "C" int vision_runtime_ops(vision_op_stat_t *ops, int max)
+{
+    const vision_layer_stat_t *layers = profiler.Layers();
+    int num = 0, i, j;
+
+    for (i = 0; i < info.layer_num; i++) {
+        const char *tag = layers[i].tag ? layers[i].tag : "?";
+
+        for (j = 0; j < num; j++) {
+            if (strcmp(ops[j].tag, tag) == 0) {
+                break;
+            }
+        }
+        if (j == num) {
+            if (num == max) {
+                continue;
+            }
+            ops[num].tag = tag;
+            ops[num].layers = 0;
+            ops[num].ticks_total = 0;
+            num++;
+        }
+        ops[j].layers++;
+        ops[j].ticks_total += layers[i].ticks_total;
+    }
+
+    // 类型数不超过VISION_OP_MAX，插入排序即可
+    for (i = 1; i < num; i++) {
+        vision_op_stat_t op = ops[i];
+
+        for (j = i; j > 0 && ops[j - 1].ticks_total < op.ticks_total; j--) {
+            ops[j] = ops[j - 1];
+        }
+        ops[j] = op;
+    }
+    return num;
+}
+
+extern "C" void vision_runtime_profile_reset(void)
+{
+    profiler.ClearTotals();
+    info.ticks_max = 0;
+    info.ticks_min = UINT32_MAX;
+    info.ticks_total = 0;
+    info.profiled = 0;
+    memset(info.hist, 0, sizeof(info.hist));
+}
+
+extern "C" void vision_runtime_report(void)
+{
+    const vision_layer_stat_t *layers = profiler.Layers();
+    vision_op_stat_t ops[VISION_PROFILE_OPS];
+    uint32_t per_us = VISION_TICKS_PER_US;
+    uint32_t n = info.profiled ? info.profiled : 1;
+    uint64_t layer_sum = 0;
+    int num, i;
+
+    vision_log("model     : %s, %u bytes at %p\n", info.model ? info.model : "-",
+               (unsigned)info.model_size, info.model_data);
+    vision_log("arena     : %d / %d bytes, peak %d (%s)\n", (int)info.arena_used,
+               (int)info.arena_size, (int)info.arena_peak,
+               info.hot_arena ? "scratch in DTCM" : "all in SDRAM");
+    vision_log("invokes   : %u, last %u us, max %u us\n", (unsigned)info.invokes,
+               (unsigned)(info.ticks_last / per_us), (unsigned)(info.ticks_max / per_us));
+    if (info.profiled == 0) {
+        return;
+    }
+    vision_log("latency   : %u profiled, min %u us, avg %u us\n", (unsigned)info.profiled,
+               (unsigned)(info.ticks_min / per_us), (unsigned)(info.ticks_total / n / per_us));
+    for (i = 0; i < VISION_HIST_BINS; i++) {
+        if (info.hist[i] == 0) {
+            continue;
+        }
+        if (i < VISION_HIST_BINS - 1) {
+            vision_log("  < %4u ms : %u\n", (unsigned)vision_hist_ms[i], (unsigned)info.hist[i]);
+        } else {
+            vision_log("  >=%4u ms : %u\n", (unsigned)vision_hist_ms[i - 1], (unsigned)info.hist[i]);
+        }
+    }
+
+    num = vision_runtime_ops(ops, VISION_PROFILE_OPS);
+    for (i = 0; i < num; i++) {
+        layer_sum += ops[i].ticks_total;
+    }
+    if (layer_sum == 0) {
+        layer_sum = 1;
+    }
+    vision_log("op                       layers   avg(us)  share\n");
+    for (i = 0; i < num; i++) {
+        vision_log("%-24s %6d %9u %5u%%\n", ops[i].tag, ops[i].layers,
+                   (unsigned)(ops[i].ticks_total / n / per_us),
+                   (unsigned)(ops[i].ticks_total * 100 / layer_sum));
+    }
+
+    vision_log("idx op                         last(us)   avg(us)   max(us)\n");
+    for (i = 0; i < info.layer_num; i++) {
+        vision_log("%3d %-24s %10u %9u %9u\n", i, layers[i].tag ? layers[i].tag : "?",
+                   (unsigned)(layers[i].ticks_last / per_us),
+                   (unsigned)(layers[i].ticks_total / n / per_us),
+                   (unsigned)(layers[i].ticks_max / per_us));
+    }
+}
+
+#if !defined(VISION_HOST) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+static void vision_info(int argc, char **argv)
+{
+    if (interpreter == nullptr) {
+        rt_kprintf("vision runtime not loaded\n");
+        return;
+    }
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+        vision_runtime_profile_reset();
+        return;
+    }
+    vision_runtime_report();
+}
+MSH_CMD_EXPORT(vision_info, show arena usage and per-op timing: vision_info [reset]);
+#endif
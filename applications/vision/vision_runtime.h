@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_RUNTIME_H_
+#define APPLICATIONS_VISION_VISION_RUNTIME_H_
+
+#include "vision_port.h"
+#include "vision_model.h"
+
+#define VISION_ARENA_SIZE         (4 * 1024 * 1024)   /* SDRAM中的张量内存池 */
+#define VISION_HOT_ARENA_SIZE     (96 * 1024)         /* DTCM中的激活/scratch区 */
+#define VISION_PROFILE_MAX        128                 /* 逐层计时的记录条数 */
+#define VISION_PROFILE_OPS        16                  /* 汇总的算子类型数，同VISION_OP_MAX */
+#define VISION_HIST_BINS          10                  /* 推理耗时直方图的桶数 */
+
+#define VISION_DIMS_MAX           4
+
+typedef enum
+{
+    VISION_TYPE_FLOAT32 = 0,
+    VISION_TYPE_INT8,
+    VISION_TYPE_UINT8,
+    VISION_TYPE_OTHER,
+} vision_type_t;
+
+// 张量的C视图，data直接指向arena，不做拷贝
+typedef struct vision_tensor_
+{
+    void *data;
+    size_t bytes;
+    vision_type_t type;
+    int dims[VISION_DIMS_MAX];
+    int ndims;
+    float scale;                    /* 量化参数，浮点张量为0 */
+    int32_t zero_point;
+} vision_tensor_t;
+
+typedef struct vision_layer_stat_
+{
+    const char *tag;                /* 算子名 */
+    uint32_t ticks_last;
+    uint32_t ticks_max;
+    uint64_t ticks_total;           /* 自上次清零以来的累计 */
+} vision_layer_stat_t;
+
+// 按算子类型汇总的耗时
+typedef struct vision_op_stat_
+{
+    const char *tag;
+    int layers;                     /* 该类型的层数 */
+    uint64_t ticks_total;
+} vision_op_stat_t;
+
+typedef struct vision_runtime_info_
+{
+    const char *model;              /* 当前模型名 */
+    const void *model_data;         /* flatbuffer所在地址，flash、XIP窗口或SDRAM */
+    size_t model_size;
+    size_t arena_used;              /* AllocateTensors后的arena_used_bytes */
+    size_t arena_peak;              /* 加载以来arena_used_bytes的最大值，含Invoke中申请的scratch */
+    size_t arena_size;
+    int hot_arena;                  /* 非持久区是否放进了DTCM */
+    uint32_t invokes;
+    uint32_t ticks_last;            /* 单帧推理耗时，单位见VISION_TICKS_PER_US */
+    uint32_t ticks_max;
+    int layer_num;
+    // 以下统计可由vision_runtime_profile_reset清零
+    uint32_t profiled;              /* 计入统计的推理次数 */
+    uint32_t ticks_min;
+    uint64_t ticks_total;
+    uint32_t hist[VISION_HIST_BINS];    /* 推理耗时分布，桶上界见vision_hist_ms */
+} vision_runtime_info_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 直方图前VISION_HIST_BINS-1个桶的上界（毫秒），最后一个桶收其余的
+extern const uint16_t vision_hist_ms[VISION_HIST_BINS - 1];
+
+/*
+ * 加载模型并分配张量，替换之前加载的模型。先尝试把非持久区（激活、scratch）
+ * 放进DTCM，放不下时整个arena都放在SDRAM。失败返回负数，不会带着未分配的
+ * 张量继续运行。
+ */
+int vision_runtime_load(const vision_model_t *model);
+// 模型是否编进了固件，没有时只能从存储槽载入
+int vision_runtime_has_builtin(const vision_model_t *model);
+// 同上，但flatbuffer取自data（如外部存储载入的模型），算子表仍用model的
+int vision_runtime_load_image(const vision_model_t *model, const void *data, size_t size);
+// 执行一次推理并更新逐层计时
+int vision_runtime_invoke(void);
+
+int vision_runtime_input(int index, vision_tensor_t *tensor);
+int vision_runtime_output(int index, vision_tensor_t *tensor);
+
+const vision_runtime_info_t *vision_runtime_info(void);
+const vision_layer_stat_t *vision_runtime_layers(void);
+// 把逐层耗时按算子类型汇总到ops，按累计耗时降序，返回类型数
+int vision_runtime_ops(vision_op_stat_t *ops, int max);
+// 清零逐层累计、耗时直方图等统计，预热或换场景后调用
+void vision_runtime_profile_reset(void);
+// 打印arena用量、耗时分布、按算子类型和逐层的耗时
+void vision_runtime_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_RUNTIME_H_ */
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include "vision_sched.h"
+
+#define SCHED_SAMPLES   (VISION_SCHED_THUMB_W * VISION_SCHED_THUMB_H)
+
+// 取(x, y)处像素的亮度，系数为Q8的BT.601
+static uint8_t sched_luma(const uint8_t *frame, int width, vision_pixfmt_t format, int x, int y)
+{
+    const uint8_t *p;
+    uint32_t v, r, g, b;
+
+    switch (format) {
+    case VISION_PIXFMT_RGB565:
+        p = frame + ((size_t)y * width + x) * 2;
+        v = p[0] | (p[1] << 8);
+        r = (v >> 8) & 0xf8;
+        g = (v >> 3) & 0xfc;
+        b = (v << 3) & 0xf8;
+        break;
+    case VISION_PIXFMT_YUV422:
+        return frame[((size_t)y * width + x) * 2];     /* YUYV中偶数字节是Y */
+    case VISION_PIXFMT_RGB888:
+        p = frame + ((size_t)y * width + x) * 3;
+        r = p[0];
+        g = p[1];
+        b = p[2];
+        break;
+    default:
+        return frame[(size_t)y * width + x];
+    }
+    return (uint8_t)((77 * r + 150 * g + 29 * b) >> 8);
+}
+
+// 在网格中心采样，整帧只读SCHED_SAMPLES个像素
+static uint32_t sched_sample(const uint8_t *frame, int width, int height, vision_pixfmt_t format,
+                             uint8_t *thumb, uint16_t *hist)
+{
+    uint32_t sum = 0;
+    int x, y;
+
+    memset(hist, 0, sizeof(uint16_t) * VISION_SCHED_HIST_BINS);
+    for (y = 0; y < VISION_SCHED_THUMB_H; y++) {
+        int sy = (2 * y + 1) * height / (2 * VISION_SCHED_THUMB_H);
+
+        for (x = 0; x < VISION_SCHED_THUMB_W; x++) {
+            int sx = (2 * x + 1) * width / (2 * VISION_SCHED_THUMB_W);
+            uint8_t l = sched_luma(frame, width, format, sx, sy);
+
+            *thumb++ = l;
+            hist[l * VISION_SCHED_HIST_BINS / 256]++;
+            sum += l;
+        }
+    }
+    return sum / SCHED_SAMPLES;
+}
+
+/*
+ * 帧差先减去两帧平均亮度之差，云遮日这类整体明暗变化不算画面变化；
+ * 直方图不看位置，摄像头轻微晃动时比帧差稳定。
+ */
+static int sched_changed(const vision_sched_t *sched, const uint8_t *thumb, const uint16_t *hist,
+                         uint32_t mean)
+{
+    uint32_t ref_mean = 0, diff = 0, dist = 0;
+    int32_t offset;
+    int i;
+
+    for (i = 0; i < SCHED_SAMPLES; i++) {
+        ref_mean += sched->thumb[i];
+    }
+    offset = (int32_t)mean - (int32_t)(ref_mean / SCHED_SAMPLES);
+    for (i = 0; i < SCHED_SAMPLES; i++) {
+        int32_t d = (int32_t)thumb[i] - sched->thumb[i] - offset;
+
+        diff += d < 0 ? -d : d;
+    }
+    for (i = 0; i < VISION_SCHED_HIST_BINS; i++) {
+        int32_t d = (int32_t)hist[i] - sched->hist[i];
+
+        dist += d < 0 ? -d : d;
+    }
+
+    return diff / SCHED_SAMPLES > sched->cfg.diff_threshold ||
+           dist * 1000 / (2 * SCHED_SAMPLES) > sched->cfg.hist_threshold;
+}
+
+void vision_sched_init(vision_sched_t *sched, const vision_sched_cfg_t *cfg, uint32_t now_ms)
+{
+    memset(sched, 0, sizeof(*sched));
+    sched->cfg = *cfg;
+    sched->start_ms = now_ms;
+    sched->last_change_ms = now_ms;
+    sched->last_infer_ms = now_ms;
+}
+
+int vision_sched_check(vision_sched_t *sched, const uint8_t *frame, int width, int height,
+                       vision_pixfmt_t format, float lux, uint32_t now_ms)
+{
+    uint8_t thumb[SCHED_SAMPLES];
+    uint16_t hist[VISION_SCHED_HIST_BINS];
+    uint32_t start = vision_ticks();
+    uint32_t mean;
+    int changed, infer;
+
+    mean = sched_sample(frame, width, height, format, thumb, hist);
+    sched->stats.checks++;
+
+    // 光照传感器和画面同时判为黑才算夜间，避免传感器未上报或被遮挡时误判
+    if (lux < sched->cfg.dark_lux && mean < sched->cfg.dark_luma) {
+        sched->stats.dark++;
+        sched->active = 0;
+        sched->stats.detect_ticks += vision_ticks() - start;
+        return 0;
+    }
+
+    changed = !sched->has_ref || sched_changed(sched, thumb, hist, mean);
+    if (changed) {
+        if (sched->has_ref) {
+            sched->stats.changes++;
+        }
+        sched->last_change_ms = now_ms;
+        sched->active = 1;
+    } else if (sched->active && now_ms - sched->last_change_ms >= sched->cfg.hold_ms) {
+        sched->active = 0;
+    }
+
+    infer = changed || sched->active || now_ms - sched->last_infer_ms >= sched->cfg.idle_ms;
+    if (infer) {
+        if (!changed && !sched->active) {
+            sched->stats.idle_infers++;
+        }
+        memcpy(sched->thumb, thumb, sizeof(thumb));
+        memcpy(sched->hist, hist, sizeof(hist));
+        sched->has_ref = 1;
+        sched->last_infer_ms = now_ms;
+        sched->stats.infers++;
+    }
+    sched->stats.detect_ticks += vision_ticks() - start;
+    return infer;
+}
+
+void vision_sched_account(vision_sched_t *sched, uint32_t ticks)
+{
+    sched->stats.infer_ticks += ticks;
+}
+
+uint32_t vision_sched_delay(const vision_sched_t *sched, uint32_t now_ms)
+{
+    uint32_t left;
+
+    if (sched->active) {
+        return sched->cfg.active_ms;
+    }
+    // 不越过强制推理的时间点
+    left = now_ms - sched->last_infer_ms < sched->cfg.idle_ms ?
+           sched->cfg.idle_ms - (now_ms - sched->last_infer_ms) : 0;
+    return left < sched->cfg.probe_ms ? left : sched->cfg.probe_ms;
+}
+
+// 运行busy_us、其余时间睡眠的能耗，单位uJ
+static uint64_t sched_energy_uj(uint64_t busy_us, uint64_t total_us)
+{
+    if (busy_us > total_us) {
+        busy_us = total_us;
+    }
+    return (busy_us * VISION_SCHED_RUN_MW + (total_us - busy_us) * VISION_SCHED_SLEEP_MW) / 1000;
+}
+
+void vision_sched_report(const vision_sched_t *sched, uint32_t now_ms)
+{
+    const struct vision_sched_stats *s = &sched->stats;
+    uint64_t total_us = (uint64_t)(now_ms - sched->start_ms) * 1000;
+    uint64_t detect_us = s->detect_ticks / VISION_TICKS_PER_US;
+    uint64_t infer_us = s->infer_ticks / VISION_TICKS_PER_US;
+    uint64_t avg_us = s->infers ? infer_us / s->infers : 0;
+    uint64_t fixed_us, busy_us, energy, fixed_energy;
+
+    // 对照：每active_ms推理一次、不做检测
+    fixed_us = sched->cfg.active_ms ? total_us / 1000 / sched->cfg.active_ms * avg_us : 0;
+    if (fixed_us > total_us) {
+        fixed_us = total_us;
+    }
+    busy_us = detect_us + infer_us;
+    energy = sched_energy_uj(busy_us, total_us);
+    fixed_energy = sched_energy_uj(fixed_us, total_us);
+    if (total_us == 0) {
+        total_us = 1;
+    }
+
+    vision_log("sched     : %s, active %u ms, probe %u ms, idle %u s\n",
+               sched->active ? "active" : "idle", (unsigned)sched->cfg.active_ms,
+               (unsigned)sched->cfg.probe_ms, (unsigned)(sched->cfg.idle_ms / 1000));
+    vision_log("checks    : %u, %u changes, %u dark, detect avg %u us\n", (unsigned)s->checks,
+               (unsigned)s->changes, (unsigned)s->dark,
+               (unsigned)(s->checks ? detect_us / s->checks : 0));
+    vision_log("infers    : %u (%u idle timeout), avg %u us\n", (unsigned)s->infers,
+               (unsigned)s->idle_infers, (unsigned)avg_us);
+    vision_log("duty      : %u.%u%%, fixed rate %u.%u%%\n",
+               (unsigned)(busy_us * 1000 / total_us / 10), (unsigned)(busy_us * 1000 / total_us % 10),
+               (unsigned)(fixed_us * 1000 / total_us / 10), (unsigned)(fixed_us * 1000 / total_us % 10));
+    vision_log("energy    : %u mJ, fixed rate %u mJ, saved %u mJ (estimate)\n",
+               (unsigned)(energy / 1000), (unsigned)(fixed_energy / 1000),
+               (unsigned)(fixed_energy > energy ? (fixed_energy - energy) / 1000 : 0));
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_SCHED_H_
+#define APPLICATIONS_VISION_VISION_SCHED_H_
+
+#include "vision_port.h"
+#include "vision_camera.h"
+
+/*
+ * 自适应推理调度。每帧先在稀疏采样的缩略图上做帧差和亮度直方图比较，
+ * 画面相对上次推理有变化时才推理：有变化期间按active_ms推理，
+ * 平静后只按probe_ms检测变化，最长idle_ms强制推理一次。
+ * 光照传感器和画面都显示为夜间时不推理。
+ */
+#define VISION_SCHED_THUMB_W        32
+#define VISION_SCHED_THUMB_H        24
+#define VISION_SCHED_HIST_BINS      16
+
+/* 功耗估算值(mW)，H750在480MHz满速运行/线程睡眠时的板级功耗，用于报告节能 */
+#define VISION_SCHED_RUN_MW         300
+#define VISION_SCHED_SLEEP_MW       90
+
+typedef struct vision_sched_cfg_
+{
+    uint32_t active_ms;             /* 有变化时的推理周期 */
+    uint32_t probe_ms;              /* 平静时检测变化的周期 */
+    uint32_t idle_ms;               /* 平静时强制推理的最长间隔 */
+    uint32_t hold_ms;               /* 最后一次变化后保持活跃的时间 */
+    uint8_t diff_threshold;         /* 去掉整体亮度变化后的平均帧差，0~255 */
+    uint16_t hist_threshold;        /* 亮度直方图L1距离，千分比 */
+    uint8_t dark_luma;              /* 画面平均亮度低于此值视为黑 */
+    float dark_lux;                 /* 光照低于此值视为夜间 */
+} vision_sched_cfg_t;
+
+struct vision_sched_stats
+{
+    uint32_t checks;                /* 做过变化检测的帧数 */
+    uint32_t changes;               /* 检测到变化的次数 */
+    uint32_t dark;                  /* 因夜间跳过的帧数 */
+    uint32_t infers;
+    uint32_t idle_infers;           /* 其中因idle_ms到期的推理 */
+    uint64_t detect_ticks;          /* 变化检测累计耗时 */
+    uint64_t infer_ticks;           /* 预处理+推理+后处理累计耗时 */
+};
+
+typedef struct vision_sched_
+{
+    vision_sched_cfg_t cfg;
+    uint8_t thumb[VISION_SCHED_THUMB_W * VISION_SCHED_THUMB_H];   /* 上次推理时的画面 */
+    uint16_t hist[VISION_SCHED_HIST_BINS];
+    int has_ref;
+    int active;
+    uint32_t start_ms;
+    uint32_t last_change_ms;
+    uint32_t last_infer_ms;
+    struct vision_sched_stats stats;
+} vision_sched_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vision_sched_init(vision_sched_t *sched, const vision_sched_cfg_t *cfg, uint32_t now_ms);
+/*
+ * 判断这一帧要不要推理，返回1推理、0跳过。lux为光照传感器读数，
+ * 推理时以这一帧作为后续比较的参考。
+ */
+int vision_sched_check(vision_sched_t *sched, const uint8_t *frame, int width, int height,
+                       vision_pixfmt_t format, float lux, uint32_t now_ms);
+// 记录一次推理（预处理到后处理）的耗时
+void vision_sched_account(vision_sched_t *sched, uint32_t ticks);
+// 到下一次检测前应等待的毫秒数
+uint32_t vision_sched_delay(const vision_sched_t *sched, uint32_t now_ms);
+// 打印占空比和相对固定active_ms推理的节能估算
+void vision_sched_report(const vision_sched_t *sched, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_SCHED_H_ */
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include <fal.h>
+#include <easyflash.h>
+#include "vision_store.h"
+
+#define STORE_CHUNK         4096    /* 校验和安装时的分块，SPI NOR的擦除块大小 */
+
+typedef enum
+{
+    STORE_XIP = 0,
+    STORE_FAL,
+    STORE_FILE,
+} store_type_t;
+
+typedef struct store_slot_
+{
+    const char *name;
+    store_type_t type;
+    const char *path;               /* fal分区名或文件路径 */
+    uintptr_t addr;                 /* XIP地址 */
+} store_slot_t;
+
+static const store_slot_t store_slots[] =
+{
+    {"xip_a", STORE_XIP,  NULL, VISION_STORE_XIP_BASE},
+    {"xip_b", STORE_XIP,  NULL, VISION_STORE_XIP_BASE + VISION_STORE_SLOT_SIZE},
+    {"fal_a", STORE_FAL,  "model_a", 0},
+    {"fal_b", STORE_FAL,  "model_b", 0},
+    {"sd_a",  STORE_FILE, VISION_STORE_SD_DIR "/model_a.vmdl", 0},
+    {"sd_b",  STORE_FILE, VISION_STORE_SD_DIR "/model_b.vmdl", 0},
+};
+#define STORE_SLOT_NUM      (sizeof(store_slots) / sizeof(store_slots[0]))
+
+/*
+ * 两块SDRAM缓冲轮流使用：运行中的模型占一块，新模型读进另一块，
+ * 加载失败时旧模型原封不动，可以立即切回去。
+ */
+static uint8_t model_buf[2][VISION_STORE_MODEL_MAX] __attribute__((aligned(16))) VISION_SECTION_SDRAM;
+static int buf_used = -1;
+
+static volatile int store_req;
+static const char *volatile store_req_slot;
+
+static const store_slot_t *store_find(const char *name)
+{
+    rt_size_t i;
+
+    for (i = 0; i < STORE_SLOT_NUM; i++) {
+        if (rt_strcmp(store_slots[i].name, name) == 0) {
+            return &store_slots[i];
+        }
+    }
+    return NULL;
+}
+
+// 从槽的offset处读len字节
+static int store_read(const store_slot_t *slot, uint32_t offset, void *buf, size_t len)
+{
+    const struct fal_partition *part;
+    int fd, ret = -1;
+
+    switch (slot->type) {
+    case STORE_XIP:
+        memcpy(buf, (const void *)(slot->addr + offset), len);
+        return 0;
+    case STORE_FAL:
+        part = fal_partition_find(slot->path);
+        if (part == NULL || offset + len > part->len) {
+            return -1;
+        }
+        return fal_partition_read(part, offset, buf, len) == (int)len ? 0 : -1;
+    default:
+        fd = open(slot->path, O_RDONLY);
+        if (fd < 0) {
+            return -1;
+        }
+        if (lseek(fd, offset, SEEK_SET) == (off_t)offset && read(fd, buf, len) == (ssize_t)len) {
+            ret = 0;
+        }
+        close(fd);
+        return ret;
+    }
+}
+
+static int store_hdr_valid(const vision_store_hdr_t *hdr)
+{
+    return hdr->magic == VISION_STORE_MAGIC && hdr->hdr_size == VISION_STORE_HDR_SIZE &&
+           hdr->size > 8 && hdr->size <= VISION_STORE_MODEL_MAX &&
+           hdr->name[VISION_STORE_NAME_MAX - 1] == '\0' &&
+           hdr->hdr_crc == ef_calc_crc32(0, hdr, offsetof(vision_store_hdr_t, hdr_crc));
+}
+
+// flatbuffer的文件标识在第4字节
+static int store_data_valid(const vision_store_hdr_t *hdr, const uint8_t *data, uint32_t crc)
+{
+    return crc == hdr->crc32 && memcmp(data + 4, "TFL3", 4) == 0;
+}
+
+// 不占用SDRAM缓冲，分块读出整个模型计算CRC
+static int store_slot_check(const store_slot_t *slot, const vision_store_hdr_t *hdr)
+{
+    uint8_t chunk[256];
+    uint8_t ident[8];
+    uint32_t crc = 0, offset;
+
+    if (slot->type == STORE_XIP) {
+        const uint8_t *data = (const uint8_t *)(slot->addr + VISION_STORE_HDR_SIZE);
+
+        return store_data_valid(hdr, data, ef_calc_crc32(0, data, hdr->size));
+    }
+    for (offset = 0; offset < hdr->size; offset += sizeof(chunk)) {
+        size_t n = hdr->size - offset < sizeof(chunk) ? hdr->size - offset : sizeof(chunk);
+
+        if (store_read(slot, VISION_STORE_HDR_SIZE + offset, chunk, n) != 0) {
+            return 0;
+        }
+        if (offset == 0) {
+            memcpy(ident, chunk, sizeof(ident));
+        }
+        crc = ef_calc_crc32(crc, chunk, n);
+    }
+    return store_data_valid(hdr, ident, crc);
+}
+
+int vision_store_scan(vision_store_slot_info_t *info, int max)
+{
+    int i;
+
+    for (i = 0; i < (int)STORE_SLOT_NUM && i < max; i++) {
+        info[i].slot = store_slots[i].name;
+        info[i].valid = store_read(&store_slots[i], 0, &info[i].hdr, sizeof(info[i].hdr)) == 0 &&
+                        store_hdr_valid(&info[i].hdr) &&
+                        store_slot_check(&store_slots[i], &info[i].hdr);
+        if (!info[i].valid && !store_hdr_valid(&info[i].hdr)) {
+            memset(&info[i].hdr, 0, sizeof(info[i].hdr));
+        }
+    }
+    return i;
+}
+
+// 把槽中的模型读进空闲缓冲（XIP直接返回窗口地址）并校验数据
+static const uint8_t *store_load(const store_slot_t *slot, const vision_store_hdr_t *hdr)
+{
+    uint8_t *buf;
+    uint32_t start = vision_ticks();
+
+    if (slot->type == STORE_XIP) {
+        const uint8_t *data = (const uint8_t *)(slot->addr + VISION_STORE_HDR_SIZE);
+
+        return store_data_valid(hdr, data, ef_calc_crc32(0, data, hdr->size)) ? data : NULL;
+    }
+
+    buf = model_buf[buf_used == 0 ? 1 : 0];
+    if (store_read(slot, VISION_STORE_HDR_SIZE, buf, hdr->size) != 0) {
+        vision_log("vision store: %s read failed\n", slot->name);
+        return NULL;
+    }
+    if (!store_data_valid(hdr, buf, ef_calc_crc32(0, buf, hdr->size))) {
+        vision_log("vision store: %s crc mismatch\n", slot->name);
+        return NULL;
+    }
+    vision_log("vision store: %s %u bytes to SDRAM in %u ms\n", slot->name, (unsigned)hdr->size,
+               (unsigned)((vision_ticks() - start) / VISION_TICKS_PER_US / 1000));
+    return buf;
+}
+
+const uint8_t *vision_store_open(const char *name, const char *slot, size_t *size,
+                                 vision_store_hdr_t *hdr)
+{
+    vision_store_hdr_t hdrs[STORE_SLOT_NUM];
+    int order[STORE_SLOT_NUM];
+    int num = 0, i, j;
+
+    // 头部有效且名字匹配的槽按版本从高到低排，逐个尝试直到数据校验通过
+    for (i = 0; i < (int)STORE_SLOT_NUM; i++) {
+        if (slot != NULL && rt_strcmp(store_slots[i].name, slot) != 0) {
+            continue;
+        }
+        if (store_read(&store_slots[i], 0, &hdrs[i], sizeof(hdrs[i])) != 0 ||
+            !store_hdr_valid(&hdrs[i]) || rt_strcmp(hdrs[i].name, name) != 0) {
+            continue;
+        }
+        for (j = num++; j > 0 && hdrs[order[j - 1]].version < hdrs[i].version; j--) {
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+    }
+
+    for (i = 0; i < num; i++) {
+        const uint8_t *data = store_load(&store_slots[order[i]], &hdrs[order[i]]);
+
+        if (data != NULL) {
+            *size = hdrs[order[i]].size;
+            if (hdr != NULL) {
+                *hdr = hdrs[order[i]];
+            }
+            vision_log("vision store: %s v%u from %s\n", name, (unsigned)hdrs[order[i]].version,
+                       store_slots[order[i]].name);
+            return data;
+        }
+    }
+    return NULL;
+}
+
+void vision_store_commit(const uint8_t *data)
+{
+    if (data == model_buf[0]) {
+        buf_used = 0;
+    } else if (data == model_buf[1]) {
+        buf_used = 1;
+    } else {
+        buf_used = -1;              /* XIP或编进固件的模型，两块缓冲都空出来 */
+    }
+}
+
+void vision_store_request(const char *slot)
+{
+    store_req_slot = slot;
+    store_req = 1;
+}
+
+int vision_store_take_request(const char **slot)
+{
+    if (!store_req) {
+        return 0;
+    }
+    *slot = store_req_slot;
+    store_req = 0;
+    return 1;
+}
+
+int vision_store_install(const char *path, const char *slot_name)
+{
+    const store_slot_t *slot = store_find(slot_name);
+    const struct fal_partition *part;
+    vision_store_hdr_t hdr;
+    uint8_t *chunk;
+    uint32_t offset, total;
+    int fd, ret = -1;
+
+    if (slot == NULL || slot->type != STORE_FAL || (part = fal_partition_find(slot->path)) == NULL) {
+        vision_log("vision store: %s is not a fal slot\n", slot_name);
+        return -1;
+    }
+    // /flash还是旧布局时fal槽与文件系统重叠，见board/port/filesystem.c
+    if (access(FS_LAYOUT_MARK, 0) != 0) {
+        vision_log("vision store: /flash still uses the old layout, %s is unusable\n", slot_name);
+        return -1;
+    }
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        vision_log("vision store: cannot open %s\n", path);
+        return -1;
+    }
+    chunk = rt_malloc(STORE_CHUNK);
+    if (chunk == NULL) {
+        close(fd);
+        return -1;
+    }
+
+    if (read(fd, &hdr, sizeof(hdr)) != sizeof(hdr) || !store_hdr_valid(&hdr)) {
+        vision_log("vision store: %s has no valid model header\n", path);
+        goto __exit;
+    }
+    total = VISION_STORE_HDR_SIZE + hdr.size;
+    if (total > part->len) {
+        goto __exit;
+    }
+
+    // 头最后写：中途失败时槽里没有有效头，不会被选中
+    lseek(fd, 0, SEEK_SET);
+    for (offset = 0; offset < total; offset += STORE_CHUNK) {
+        size_t n = total - offset < STORE_CHUNK ? total - offset : STORE_CHUNK;
+
+        if (read(fd, chunk, n) != (ssize_t)n) {
+            goto __exit;
+        }
+        if (offset == 0) {
+            memset(chunk, 0xff, VISION_STORE_HDR_SIZE);
+        }
+        if (fal_partition_erase(part, offset, STORE_CHUNK) < 0 ||
+            fal_partition_write(part, offset, chunk, n) < 0) {
+            goto __exit;
+        }
+    }
+    if (fal_partition_write(part, 0, (const uint8_t *)&hdr, sizeof(hdr)) < 0 ||
+        !store_slot_check(slot, &hdr)) {
+        vision_log("vision store: verify %s failed\n", slot_name);
+        goto __exit;
+    }
+    vision_log("vision store: %s v%u installed to %s\n", hdr.name, (unsigned)hdr.version, slot_name);
+    ret = 0;
+
+__exit:
+    rt_free(chunk);
+    close(fd);
+    return ret;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void vision_model(int argc, char **argv)
+{
+    vision_store_slot_info_t info[STORE_SLOT_NUM];
+    const store_slot_t *slot;
+    int i, n;
+
+    if (argc >= 2 && rt_strcmp(argv[1], "use") == 0) {
+        slot = argc >= 3 ? store_find(argv[2]) : NULL;
+        if (argc >= 3 && slot == NULL) {
+            rt_kprintf("unknown slot %s\n", argv[2]);
+            return;
+        }
+        vision_store_request(slot ? slot->name : NULL);
+        rt_kprintf("switch to %s requested\n", slot ? slot->name : "latest");
+        return;
+    }
+    if (argc == 4 && rt_strcmp(argv[1], "install") == 0) {
+        vision_store_install(argv[2], argv[3]);
+        return;
+    }
+    if (argc != 1) {
+        rt_kprintf("usage: vision_model [use [slot] | install <file> <fal_a|fal_b>]\n");
+        return;
+    }
+
+    n = vision_store_scan(info, STORE_SLOT_NUM);
+    rt_kprintf("slot   valid name                     version      size    crc32\n");
+    for (i = 0; i < n; i++) {
+        rt_kprintf("%-6s %-5s %-24s %7u %9u %08x\n", info[i].slot, info[i].valid ? "yes" : "no",
+                   info[i].hdr.name[0] ? info[i].hdr.name : "-", (unsigned)info[i].hdr.version,
+                   (unsigned)info[i].hdr.size, (unsigned)info[i].hdr.crc32);
+    }
+}
+MSH_CMD_EXPORT(vision_model, list model slots or switch the running model);
+#endif
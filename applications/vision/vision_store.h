@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_STORE_H_
+#define APPLICATIONS_VISION_VISION_STORE_H_
+
+#include "vision_port.h"
+
+/*
+ * 模型存储。模型镜像 = 64字节头 + flatbuffer，由tools/model_pack.py生成，
+ * 可放在三类A/B槽里：
+ *   xip_a/xip_b  QSPI的XIP窗口（link.lds中的MODEL区），直接映射使用，不拷贝
+ *   fal_a/fal_b  SPI NOR上的model_a/model_b分区，读进SDRAM
+ *   sd_a/sd_b    /sdcard下的文件，读进SDRAM
+ * 名字与当前任务一致、头和数据CRC都正确的槽中选版本号最高的。
+ */
+#define VISION_STORE_MAGIC          0x4C444D56      /* "VMDL" */
+#define VISION_STORE_HDR_SIZE       64
+#define VISION_STORE_NAME_MAX       24
+#define VISION_STORE_SLOT_SIZE      (2 * 1024 * 1024)
+#define VISION_STORE_MODEL_MAX      (VISION_STORE_SLOT_SIZE - VISION_STORE_HDR_SIZE)
+
+#define VISION_STORE_XIP_BASE       0x90400000      /* 同link.lds的MODEL区 */
+#define VISION_STORE_SD_DIR         "/sdcard"
+
+// 镜像头，小端，hdr_crc覆盖它之前的60字节
+typedef struct vision_store_hdr_
+{
+    uint32_t magic;
+    uint32_t hdr_size;
+    uint32_t version;               /* 模型版本，越大越新 */
+    uint32_t size;                  /* flatbuffer字节数 */
+    uint32_t crc32;                 /* flatbuffer的CRC32 */
+    char name[VISION_STORE_NAME_MAX];   /* 对应的任务名，如yolov5 */
+    uint32_t reserved[4];
+    uint32_t hdr_crc;
+} vision_store_hdr_t;
+
+typedef struct vision_store_slot_info_
+{
+    const char *slot;
+    int valid;                      /* 头和数据都校验通过 */
+    vision_store_hdr_t hdr;
+} vision_store_slot_info_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 列出所有槽的状态，返回槽数
+int vision_store_scan(vision_store_slot_info_t *info, int max);
+
+/*
+ * 打开一个模型：slot为NULL时选name匹配的最新版本。XIP槽返回窗口内地址，
+ * 其余读进当前未被使用的SDRAM缓冲。失败返回NULL。
+ * 新模型加载成功后调用vision_store_commit，之前的缓冲才会被复用。
+ */
+const uint8_t *vision_store_open(const char *name, const char *slot, size_t *size,
+                                 vision_store_hdr_t *hdr);
+void vision_store_commit(const uint8_t *data);
+
+// 请求热切换，由视觉线程在两帧之间取走执行；slot为NULL表示最新版本
+void vision_store_request(const char *slot);
+// 取出待执行的请求，没有时返回0；*slot为NULL表示最新版本
+int vision_store_take_request(const char **slot);
+
+// 把SD卡上的镜像文件校验后写入fal槽
+int vision_store_install(const char *path, const char *slot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_STORE_H_ */
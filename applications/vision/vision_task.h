@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_TASK_H_
+#define APPLICATIONS_VISION_VISION_TASK_H_
+
+#include "vision_runtime.h"
+
+/*
+ * 模型槽：视觉线程同一时间只跑一个任务，编译时二选一。
+ * 任务只由rtconfig.h中的VISION_TASK_YOLOV5选择（主机构建用-D），SConscript按同一个宏
+ * 生成算子表，不要在源码里另行定义，否则生成的算子表会和编译进来的任务对不上。
+ * 未选中的任务连同它的模型数据和算子内核都不会被链接。
+ */
+#if defined(VISION_TASK_GROWTH) && defined(VISION_TASK_YOLOV5)
+#error "VISION_TASK_GROWTH and VISION_TASK_YOLOV5 are mutually exclusive"
+#endif
+#ifndef VISION_TASK_YOLOV5
+#define VISION_TASK_GROWTH                  /* 生长阶段分类，控制逻辑需要的默认任务 */
+#endif
+
+typedef struct vision_task_
+{
+    const char *name;
+    const vision_model_t *model;
+    uint32_t period_ms;                     /* 两次推理的间隔 */
+    // 加载后检查输入输出张量是否符合预期，不符合返回负数
+    int (*setup)(const vision_tensor_t *input, const vision_tensor_t *output);
+    // 每次推理后处理输出
+    void (*process)(const vision_tensor_t *output);
+    // 打印任务自己的统计，可为空
+    void (*report)(void);
+} vision_task_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef VISION_TASK_GROWTH
+extern const vision_model_t growth_model;
+extern const vision_task_t growth_task;
+#endif
+#ifdef VISION_TASK_YOLOV5
+extern const vision_model_t yolov5_model;
+extern const vision_task_t yolov5_task;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_TASK_H_ */
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include "vision_track.h"
+
+void vision_track_init(vision_track_t *track, const vision_track_cfg_t *cfg)
+{
+    memset(track, 0, sizeof(*track));
+    track->cfg = *cfg;
+    if (track->cfg.classes > VISION_TRACK_CLASS_MAX) {
+        track->cfg.classes = VISION_TRACK_CLASS_MAX;
+    }
+    track->top = -1;
+    track->candidate = -1;
+    track->next_id = 1;
+}
+
+static void track_ema(vision_track_t *track, const float *scores)
+{
+    int i;
+
+    for (i = 0; i < track->cfg.classes; i++) {
+        track->ema[i] += track->cfg.alpha * (scores[i] - track->ema[i]);
+    }
+}
+
+int vision_track_top(vision_track_t *track, const float *scores)
+{
+    int best = 0, i;
+
+    track_ema(track, scores);
+    for (i = 1; i < track->cfg.classes; i++) {
+        if (track->ema[i] > track->ema[best]) {
+            best = i;
+        }
+    }
+
+    if (best == track->top) {
+        track->candidate = -1;
+        return 0;
+    }
+    if (best != track->candidate) {
+        track->candidate = best;
+        track->candidate_frames = 0;
+    }
+    if (++track->candidate_frames < track->cfg.debounce || track->ema[best] < track->cfg.on_threshold) {
+        return 0;
+    }
+    track->top = best;
+    track->candidate = -1;
+    track->transitions++;
+    return 1;
+}
+
+// 已有轨迹按顺序各取一个IoU最大的同类框，剩下的框开新轨迹
+static void track_match(vision_track_t *track, const yolo_box_t *boxes, int num, float *scores)
+{
+    uint8_t used[VISION_TRACK_OBJ_MAX * 4] = {0};
+    int i, j, n = num < (int)sizeof(used) ? num : (int)sizeof(used);
+
+    for (i = 0; i < track->obj_num; i++) {
+        vision_track_obj_t *obj = &track->objs[i];
+        int32_t best_iou = vision_fix_from_float(track->cfg.iou_threshold);
+        int best = -1;
+
+        for (j = 0; j < n; j++) {
+            int32_t iou;
+
+            if (used[j] || boxes[j].cls != obj->box.cls) {
+                continue;
+            }
+            iou = yolo_post_iou(&boxes[j], &obj->box);
+            if (iou >= best_iou) {
+                best_iou = iou;
+                best = j;
+            }
+        }
+        if (best < 0) {
+            obj->miss++;
+            continue;
+        }
+        used[best] = 1;
+        obj->box = boxes[best];
+        obj->miss = 0;
+        if (obj->hits < 255) {
+            obj->hits++;
+        }
+    }
+
+    // 删除丢失太久的轨迹
+    for (i = 0, j = 0; i < track->obj_num; i++) {
+        if (track->objs[i].miss <= track->cfg.max_miss) {
+            track->objs[j++] = track->objs[i];
+        }
+    }
+    track->obj_num = j;
+
+    for (j = 0; j < n && track->obj_num < VISION_TRACK_OBJ_MAX; j++) {
+        vision_track_obj_t *obj;
+
+        if (used[j] || boxes[j].cls >= track->cfg.classes) {
+            continue;
+        }
+        obj = &track->objs[track->obj_num++];
+        obj->box = boxes[j];
+        obj->id = track->next_id++;
+        obj->hits = 1;
+        obj->miss = 0;
+    }
+
+    // 类别得分只看本帧命中的已确认轨迹，刚出现一帧的框不算
+    for (i = 0; i < track->obj_num; i++) {
+        const vision_track_obj_t *obj = &track->objs[i];
+
+        if (obj->miss == 0 && obj->hits >= track->cfg.min_hits && obj->box.score > scores[obj->box.cls]) {
+            scores[obj->box.cls] = obj->box.score;
+        }
+    }
+}
+
+int vision_track_boxes(vision_track_t *track, const yolo_box_t *boxes, int num)
+{
+    float scores[VISION_TRACK_CLASS_MAX] = {0};
+    int changed = 0, i;
+
+    track_match(track, boxes, num, scores);
+    track_ema(track, scores);
+
+    for (i = 0; i < track->cfg.classes; i++) {
+        int on = track->present[i] ? track->ema[i] >= track->cfg.off_threshold :
+                                     track->ema[i] >= track->cfg.on_threshold;
+
+        if (on == track->present[i]) {
+            track->pending[i] = 0;
+            continue;
+        }
+        if (++track->pending[i] >= track->cfg.debounce) {
+            track->present[i] = (uint8_t)on;
+            track->pending[i] = 0;
+            track->transitions++;
+            changed++;
+        }
+    }
+    return changed;
+}
+
+int vision_track_count(const vision_track_t *track, int cls)
+{
+    int count = 0, i;
+
+    for (i = 0; i < track->obj_num; i++) {
+        const vision_track_obj_t *obj = &track->objs[i];
+
+        if (obj->box.cls == cls && obj->miss == 0 && obj->hits >= track->cfg.min_hits) {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_VISION_TRACK_H_
+#define APPLICATIONS_VISION_VISION_TRACK_H_
+
+#include "vision_port.h"
+#include "yolo_post.h"
+
+/*
+ * 推理结果的时间平滑。每个类别维护一个置信度的指数滑动平均，
+ * 状态要越过回差阈值并连续保持debounce帧才翻转，单帧的类别跳变
+ * 不会传到控制逻辑。检测框按IoU跨帧关联成轨迹，只有连续命中
+ * min_hits帧的轨迹才计入类别得分。
+ */
+#define VISION_TRACK_CLASS_MAX      80
+#define VISION_TRACK_OBJ_MAX        16
+
+typedef struct vision_track_cfg_
+{
+    int classes;
+    float alpha;                    /* 新一帧在滑动平均中的权重 */
+    float on_threshold;             /* 平均置信度高于此值判为出现 */
+    float off_threshold;            /* 低于此值判为消失，与on_threshold形成回差 */
+    uint8_t debounce;               /* 新状态连续保持的帧数 */
+    uint8_t min_hits;               /* 轨迹连续命中这么多帧才确认 */
+    uint8_t max_miss;               /* 轨迹连续丢失超过这么多帧就删除 */
+    float iou_threshold;            /* 同类框跨帧关联的IoU下限 */
+} vision_track_cfg_t;
+
+typedef struct vision_track_obj_
+{
+    yolo_box_t box;                 /* 最近一次命中的框 */
+    uint16_t id;
+    uint8_t hits;
+    uint8_t miss;
+} vision_track_obj_t;
+
+typedef struct vision_track_
+{
+    vision_track_cfg_t cfg;
+    float ema[VISION_TRACK_CLASS_MAX];
+    uint8_t present[VISION_TRACK_CLASS_MAX];    /* 去抖后的出现状态 */
+    uint8_t pending[VISION_TRACK_CLASS_MAX];    /* 与present相反的连续帧数 */
+    int top;                        /* 互斥分类的当前类别，-1为未定 */
+    int candidate;
+    uint8_t candidate_frames;
+    vision_track_obj_t objs[VISION_TRACK_OBJ_MAX];
+    int obj_num;
+    uint16_t next_id;
+    uint32_t transitions;           /* 状态翻转次数 */
+} vision_track_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vision_track_init(vision_track_t *track, const vision_track_cfg_t *cfg);
+/*
+ * 互斥分类（如生长阶段）：scores为各类别本帧的概率。平均值最高的类别
+ * 连续debounce帧不变且不低于on_threshold时才切换。切换时返回1。
+ */
+int vision_track_top(vision_track_t *track, const float *scores);
+/*
+ * 目标检测：boxes按分数降序。关联轨迹后，以每类已确认轨迹的最高分
+ * 更新滑动平均和出现状态，返回本帧状态翻转的类别数。
+ */
+int vision_track_boxes(vision_track_t *track, const yolo_box_t *boxes, int num);
+
+static inline int vision_track_present(const vision_track_t *track, int cls)
+{
+    return track->present[cls];
+}
+
+// 某类别已确认且本帧命中的轨迹数
+int vision_track_count(const vision_track_t *track, int cls);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_VISION_TRACK_H_ */
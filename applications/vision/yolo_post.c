@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include "yolo_post.h"
+
+#if defined(__ARM_FEATURE_MVE)
+#include <arm_mve.h>
+#endif
+
+struct yolo_post_stats yolo_post_stats;
+
+typedef struct yolo_cand_
+{
+    int32_t score;                  /* Q15 */
+    uint32_t row;
+    uint16_t cls;
+} yolo_cand_t;
+
+typedef struct yolo_post_ctx_
+{
+    const int8_t *base;
+    int stride;
+    int classes;
+    const vision_fix_lut_t *lut;
+    int32_t threshold;              /* Q15 */
+    int num;
+    uint32_t candidates;
+    uint32_t overflow;
+    yolo_cand_t heap[YOLO_POST_CAND_MAX];   /* 以score为键的小顶堆 */
+} yolo_post_ctx_t;
+
+// 量化值 -> Q15的查表，量化参数或输出形式变了才重建
+static vision_fix_lut_t post_lut VISION_SECTION_DTCM;
+
+int VISION_SECTION_ITCM yolo_post_argmax_s8(const int8_t *data, int n, int8_t *max_value)
+{
+    int8_t best = -128;
+    int i = 0;
+
+#if defined(__ARM_FEATURE_MVE)
+    // Helium：每次16个，尾部用谓词加载
+    while (i < n) {
+        mve_pred16_t p = vctp8q(n - i);
+
+        best = vmaxvq_p_s8(best, vld1q_z_s8(data + i, p), p);
+        i += 16;
+    }
+    i = n;
+#elif defined(__ARM_FEATURE_DSP)
+    // M7 DSP扩展：SSUB8按字节置GE标志，SEL按GE逐字节取大者，一次比较4个
+    uint32_t lanes = 0x80808080u;
+
+    for (; i + 4 <= n; i += 4) {
+        uint32_t word;
+
+        memcpy(&word, data + i, 4);
+        (void)__SSUB8(word, lanes);
+        lanes = __SEL(word, lanes);
+    }
+    for (int k = 0; k < 4; k++) {
+        int8_t v = (int8_t)(lanes >> (k * 8));
+
+        if (v > best) {
+            best = v;
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if (data[i] > best) {
+            best = data[i];
+        }
+    }
+
+    // 第二遍找下标，最大值通常出现得很早
+    for (i = 0; i < n - 1 && data[i] != best; i++) {
+    }
+    *max_value = best;
+    return i;
+}
+
+static void yolo_heap_down(yolo_cand_t *heap, int num, int i)
+{
+    yolo_cand_t item = heap[i];
+
+    for (;;) {
+        int child = 2 * i + 1;
+
+        if (child >= num) {
+            break;
+        }
+        if (child + 1 < num && heap[child + 1].score < heap[child].score) {
+            child++;
+        }
+        if (heap[child].score >= item.score) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = item;
+}
+
+static void yolo_heap_push(yolo_post_ctx_t *ctx, const yolo_cand_t *cand)
+{
+    int i;
+
+    if (ctx->num < YOLO_POST_CAND_MAX) {
+        i = ctx->num++;
+        while (i > 0 && ctx->heap[(i - 1) / 2].score > cand->score) {
+            ctx->heap[i] = ctx->heap[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        ctx->heap[i] = *cand;
+        return;
+    }
+
+    // 堆满，新框比最低分高时替换堆顶
+    ctx->overflow++;
+    if (cand->score > ctx->heap[0].score) {
+        ctx->heap[0] = *cand;
+        yolo_heap_down(ctx->heap, ctx->num, 0);
+    }
+}
+
+// 只有objectness过了阈值的行才会进来，这里才开始查表；表单调递增，量化域的argmax就是概率的argmax
+static void VISION_SECTION_ITCM yolo_post_row(yolo_post_ctx_t *ctx, uint32_t row)
+{
+    const int8_t *p = ctx->base + row * ctx->stride;
+    yolo_cand_t cand;
+    int8_t cls_q;
+
+    cand.cls = yolo_post_argmax_s8(p + 5, ctx->classes, &cls_q);
+    cand.score = vision_fix_mul(vision_fix_lut_s8(ctx->lut, p[4]), vision_fix_lut_s8(ctx->lut, cls_q));
+    if (cand.score < ctx->threshold) {
+        return;
+    }
+    cand.row = row;
+    ctx->candidates++;
+    yolo_heap_push(ctx, &cand);
+}
+
+// Q15的像素坐标四舍五入到整数像素，限制在[0, limit]
+static int16_t yolo_clamp(int32_t v, int limit)
+{
+    if (v < 0) {
+        return 0;
+    }
+    v = (v + (VISION_FIX_ONE >> 1)) >> VISION_FIX_Q;
+    return v > limit ? limit : (int16_t)v;
+}
+
+// 原始输出的行号 -> 检测层、锚框和格子，行号超出各层之和时返回负数
+static int yolo_post_grid(const yolo_post_head_t *head, const yolo_post_cfg_t *cfg, uint32_t row,
+                          int *level, int *anchor, int *gx, int *gy)
+{
+    int l;
+
+    for (l = 0; l < head->levels; l++) {
+        uint32_t gw = cfg->width / head->stride[l];
+        uint32_t cells = gw * (cfg->height / head->stride[l]);
+
+        if (row < YOLO_POST_ANCHORS * cells) {
+            *level = l;
+            *anchor = row / cells;
+            row %= cells;
+            *gy = row / gw;
+            *gx = row % gw;
+            return 0;
+        }
+        row -= YOLO_POST_ANCHORS * cells;
+    }
+    return -1;
+}
+
+// 一行的坐标查表得到Q15，换算为Q15的输入像素后取整
+static int yolo_post_box(const yolo_post_ctx_t *ctx, const yolo_post_cfg_t *cfg, uint32_t row,
+                         yolo_box_t *box)
+{
+    const int8_t *p = ctx->base + row * ctx->stride;
+    int32_t tx = vision_fix_lut_s8(ctx->lut, p[0]);
+    int32_t ty = vision_fix_lut_s8(ctx->lut, p[1]);
+    int32_t tw = vision_fix_lut_s8(ctx->lut, p[2]);
+    int32_t th = vision_fix_lut_s8(ctx->lut, p[3]);
+    int32_t cx, cy, w, h;
+
+    if (cfg->head == NULL) {
+        cx = tx * cfg->width;
+        cy = ty * cfg->height;
+        w = tw * cfg->width;
+        h = th * cfg->height;
+    } else {
+        const yolo_post_head_t *head = cfg->head;
+        int level, anchor, gx, gy;
+
+        if (yolo_post_grid(head, cfg, row, &level, &anchor, &gx, &gy) != 0) {
+            return -1;
+        }
+        cx = (2 * tx - VISION_FIX_ONE / 2 + gx * VISION_FIX_ONE) * head->stride[level];
+        cy = (2 * ty - VISION_FIX_ONE / 2 + gy * VISION_FIX_ONE) * head->stride[level];
+        w = 4 * vision_fix_mul(tw, tw) * head->anchors[level][anchor][0];
+        h = 4 * vision_fix_mul(th, th) * head->anchors[level][anchor][1];
+    }
+    box->x0 = yolo_clamp(cx - w / 2, cfg->width);
+    box->y0 = yolo_clamp(cy - h / 2, cfg->height);
+    box->x1 = yolo_clamp(cx + w / 2, cfg->width);
+    box->y1 = yolo_clamp(cy + h / 2, cfg->height);
+    return 0;
+}
+
+int32_t yolo_post_iou(const yolo_box_t *a, const yolo_box_t *b)
+{
+    return vision_fix_iou(a->x0, a->y0, a->x1, a->y1, b->x0, b->y0, b->x1, b->y1);
+}
+
+// 逐行扫描obj列要走遍整个输出张量，和取候选、NMS一起放在ITCM
+int VISION_SECTION_ITCM yolo_post_decode(const vision_tensor_t *output, const yolo_post_cfg_t *cfg,
+                                         yolo_box_t *boxes, int max)
+{
+    yolo_post_ctx_t ctx;
+    uint32_t start, rows, row;
+    int32_t iou_threshold;
+    int qthr, kept, i, j, n;
+
+    if (output->type != VISION_TYPE_INT8 || output->scale <= 0 || cfg->classes <= 0) {
+        return 0;
+    }
+
+    start = vision_ticks();
+    ctx.base = (const int8_t *)output->data;
+    ctx.classes = cfg->classes;
+    ctx.stride = cfg->classes + 5;
+    vision_fix_lut_update(&post_lut, output->scale, output->zero_point,
+                          cfg->head != NULL ? VISION_FIX_SIGMOID : VISION_FIX_LINEAR);
+    ctx.lut = &post_lut;
+    ctx.threshold = vision_fix_from_float(cfg->conf_threshold);
+    ctx.num = 0;
+    ctx.candidates = 0;
+    ctx.overflow = 0;
+    rows = output->bytes / ctx.stride;
+
+    // 类别概率不超过1，obj低于阈值的行不可能达标；表单调，找出达标的最小量化值即可整行跳过
+    for (qthr = -128; qthr <= 127 && vision_fix_lut_s8(ctx.lut, qthr) < ctx.threshold; qthr++) {
+    }
+    if (qthr > 127) {
+        rows = 0;
+    }
+
+    row = 0;
+#if defined(__ARM_FEATURE_MVE)
+    {
+        // obj列的步长为stride，用gather一次取8行
+        uint16x8_t offsets = vmulq_n_u16(vidupq_n_u16(0, 1), ctx.stride);
+
+        for (; row + 8 <= rows; row += 8) {
+            int16x8_t obj = vldrbq_gather_offset_s16(ctx.base + row * ctx.stride + 4, offsets);
+            mve_pred16_t hit = vcmpgeq_n_s16(obj, qthr);
+
+            while (hit) {
+                int lane = __builtin_ctz(hit) / 2;
+
+                yolo_post_row(&ctx, row + lane);
+                hit &= ~(3u << (lane * 2));
+            }
+        }
+    }
+#endif
+    for (; row < rows; row++) {
+        if (ctx.base[row * ctx.stride + 4] >= qthr) {
+            yolo_post_row(&ctx, row);
+        }
+    }
+
+    // 堆排序，结果按分数降序
+    for (n = ctx.num; n > 1; n--) {
+        yolo_cand_t top = ctx.heap[0];
+
+        ctx.heap[0] = ctx.heap[n - 1];
+        ctx.heap[n - 1] = top;
+        yolo_heap_down(ctx.heap, n - 1, 0);
+    }
+
+    // 按类别NMS，只比较同类的已保留框
+    iou_threshold = vision_fix_from_float(cfg->iou_threshold);
+    kept = 0;
+    for (i = 0; i < ctx.num && kept < max; i++) {
+        yolo_box_t *box = &boxes[kept];
+
+        if (yolo_post_box(&ctx, cfg, ctx.heap[i].row, box) != 0) {
+            continue;
+        }
+        box->cls = ctx.heap[i].cls;
+        box->score = (float)ctx.heap[i].score / VISION_FIX_ONE;
+
+        for (j = 0; j < kept; j++) {
+            if (boxes[j].cls == box->cls && yolo_post_iou(&boxes[j], box) > iou_threshold) {
+                break;
+            }
+        }
+        if (j == kept) {
+            kept++;
+        }
+    }
+
+    yolo_post_stats.frames++;
+    yolo_post_stats.candidates += ctx.candidates;
+    yolo_post_stats.overflow += ctx.overflow;
+    yolo_post_stats.kept += kept;
+    yolo_post_stats.ticks_last = vision_ticks() - start;
+    if (yolo_post_stats.ticks_last > yolo_post_stats.ticks_max) {
+        yolo_post_stats.ticks_max = yolo_post_stats.ticks_last;
+    }
+
+    return kept;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_YOLO_POST_H_
+#define APPLICATIONS_VISION_YOLO_POST_H_
+
+#include "vision_runtime.h"
+#include "vision_fix.h"
+
+#define YOLO_POST_CAND_MAX      64      /* NMS前候选框堆的容量，满了淘汰最低分 */
+#define YOLO_POST_LEVELS        3
+#define YOLO_POST_ANCHORS       3       /* 每个检测层每个格子的锚框数 */
+
+// 检测结果，坐标为输入图像上的像素
+typedef struct yolo_box_
+{
+    int16_t x0, y0, x1, y1;
+    uint16_t cls;
+    float score;
+} yolo_box_t;
+
+/*
+ * 导出时去掉了Detect层的sigmoid和网格解码时，输出是原始值，
+ * 行序为[层][锚框][gy][gx]，按YOLOv5的公式解码：
+ *   cx = (2 * sigmoid(tx) - 0.5 + gx) * stride，w = (2 * sigmoid(tw))^2 * anchor_w
+ */
+typedef struct yolo_post_head_
+{
+    int levels;
+    uint16_t stride[YOLO_POST_LEVELS];
+    uint16_t anchors[YOLO_POST_LEVELS][YOLO_POST_ANCHORS][2];  /* 宽、高，单位为输入像素 */
+} yolo_post_head_t;
+
+typedef struct yolo_post_cfg_
+{
+    int classes;                /* 类别数，每行为x, y, w, h, obj + classes */
+    float conf_threshold;       /* obj * cls的下限 */
+    float iou_threshold;        /* 同类框IoU超过此值时抑制低分框 */
+    int width;                  /* 模型输入尺寸，用于把归一化坐标换成像素 */
+    int height;
+    const yolo_post_head_t *head;   /* NULL表示模型已输出sigmoid后的概率和归一化的cx, cy, w, h */
+} yolo_post_cfg_t;
+
+struct yolo_post_stats
+{
+    uint32_t frames;
+    uint32_t candidates;        /* 通过objectness和类别阈值的行数 */
+    uint32_t overflow;          /* 因候选堆已满被淘汰的行数 */
+    uint32_t kept;              /* NMS后保留的框数 */
+    uint32_t ticks_last;
+    uint32_t ticks_max;
+};
+
+extern struct yolo_post_stats yolo_post_stats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 直接在int8输出张量上解码：先用量化后的objectness阈值整行跳过，
+ * 通过的行查表得到Q15的概率和坐标（原始输出时查表同时做sigmoid），
+ * 分数、坐标和NMS的IoU全程为整数。返回写入boxes的个数，按分数降序。
+ */
+int yolo_post_decode(const vision_tensor_t *output, const yolo_post_cfg_t *cfg,
+                     yolo_box_t *boxes, int max);
+
+// 两个框的交并比，Q15，不看类别
+int32_t yolo_post_iou(const yolo_box_t *a, const yolo_box_t *b);
+
+// 类别得分的argmax，返回下标，*max_value为最大的量化值；相同取最前
+int yolo_post_argmax_s8(const int8_t *data, int n, int8_t *max_value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APPLICATIONS_VISION_YOLO_POST_H_ */
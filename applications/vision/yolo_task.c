@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-10     HUAWEI       the first version
+ * 2026-10-19     HUAWEI       use vision_runtime, int8 output
+ * 2026-10-19     HUAWEI       run as a task in the vision model slot
+ * 2026-10-19     HUAWEI       track boxes across frames, publish pest events
+ */
+#include <rtthread.h>
+#include "vision_task.h"
+#include "yolo_post.h"
+#include "vision_track.h"
+#include "vision_event.h"
+
+#ifdef VISION_TASK_YOLOV5
+
+/* 模型输入输出配置 */
+#define INPUT_WIDTH      160
+#define INPUT_HEIGHT     160
+#define INPUT_CHANNELS   3
+#define ROW_SIZE         85      // x, y, w, h, obj + 80类
+#define CLASS_NUM        (ROW_SIZE - 5)
+#define CONF_THRESHOLD   0.5f
+#define IOU_THRESHOLD    0.45f
+#define BOX_MAX          16
+#define YOLO_PERIOD_MS   100
+
+static const yolo_post_cfg_t post = {CLASS_NUM, CONF_THRESHOLD, IOU_THRESHOLD, INPUT_WIDTH, INPUT_HEIGHT};
+
+// 框连续命中2帧才算目标，平均置信度越过0.5出现、跌破0.3消失，各需连续2帧
+static const vision_track_cfg_t track_cfg = {
+    .classes       = CLASS_NUM,
+    .alpha         = 0.4f,
+    .on_threshold  = 0.5f,
+    .off_threshold = 0.3f,
+    .debounce      = 2,
+    .min_hits      = 2,
+    .max_miss      = 3,
+    .iou_threshold = 0.3f,
+};
+
+// 视为虫害的类别：COCO中的bird、cat、dog，换成自训练的害虫模型时改这里
+static const uint16_t pest_classes[] = {14, 15, 16};
+#define PEST_NUM        (sizeof(pest_classes) / sizeof(pest_classes[0]))
+
+static vision_track_t track;
+static uint8_t pest_published[PEST_NUM];    /* 已发布的出现状态 */
+
+static int yolov5_setup(const vision_tensor_t *input, const vision_tensor_t *output)
+{
+    if (input->type != VISION_TYPE_INT8 || output->type != VISION_TYPE_INT8 ||
+        input->bytes != INPUT_WIDTH * INPUT_HEIGHT * INPUT_CHANNELS ||
+        output->bytes % ROW_SIZE != 0) {
+        return -1;
+    }
+    vision_track_init(&track, &track_cfg);
+    return 0;
+}
+
+// 在int8输出上解码并做NMS，跨帧跟踪后只在虫害出现/消失时发事件
+static void yolov5_process(const vision_tensor_t *output)
+{
+    yolo_box_t boxes[BOX_MAX];
+    int count = 0, n;
+    rt_size_t i;
+
+    n = yolo_post_decode(output, &post, boxes, BOX_MAX);
+    vision_track_boxes(&track, boxes, n);
+
+    for (i = 0; i < PEST_NUM; i++) {
+        count += vision_track_count(&track, pest_classes[i]);
+    }
+    // 与已发布的状态比较，队列满没发出去的翻转下一帧重发
+    for (i = 0; i < PEST_NUM; i++) {
+        uint16_t cls = pest_classes[i];
+        int present = vision_track_present(&track, cls);
+
+        if (present == pest_published[i] ||
+            vision_event_pest(cls, present, count, track.ema[cls]) != RT_EOK) {
+            continue;
+        }
+        rt_kprintf("pest class %d %s, %d tracked\n", cls, present ? "detected" : "cleared", count);
+        pest_published[i] = present;
+    }
+}
+
+static void yolov5_report(void)
+{
+    struct yolo_post_stats s = yolo_post_stats;
+    rt_uint32_t frames = s.frames ? s.frames : 1;
+
+    rt_kprintf("frames     : %u\n", s.frames);
+    rt_kprintf("candidates : %u / frame, heap overflow %u\n", s.candidates / frames, s.overflow);
+    rt_kprintf("boxes      : %u / frame after NMS\n", s.kept / frames);
+    rt_kprintf("post ticks : last %u, max %u\n", s.ticks_last, s.ticks_max);
+    rt_kprintf("tracks     : %d, %u switches\n", track.obj_num, track.transitions);
+}
+
+const vision_task_t yolov5_task =
+{
+    "yolov5",
+    &yolov5_model,
+    YOLO_PERIOD_MS,
+    yolov5_setup,
+    yolov5_process,
+    yolov5_report,
+};
+
+#endif /* VISION_TASK_YOLOV5 */
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#include "vision_task.h"
+#include "vision_model.h"
+
+#ifdef VISION_TASK_YOLOV5
+
+#include "yolov5_model_ops.h"
+
+/*
+ * 模型数据可以编进固件（tools/tflite_ops.py从models/yolov5.tflite生成yolo_model.h），
+ * 也可以不编进来，由vision_store从XIP槽、fal分区或SD卡载入。
+ */
+#if __has_include("yolo_model.h")
+#include "yolo_model.h"
+VISION_MODEL_DEFINE(yolov5_model, "yolov5", g_yolov5_tflite, g_yolov5_tflite_len, YOLOV5_MODEL_OPS);
+#else
+VISION_MODEL_DEFINE(yolov5_model, "yolov5", nullptr, 0, YOLOV5_MODEL_OPS);
+#endif
+
+#endif
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       the first version
+ */
+#ifndef APPLICATIONS_VISION_YOLOV5_MODEL_OPS_H_
+#define APPLICATIONS_VISION_YOLOV5_MODEL_OPS_H_
+
+// models/yolov5.tflite存在时由tools/tflite_ops.py按模型重新生成
+// YOLOv5 int8导出后图中出现的算子
+#define YOLOV5_MODEL_OPS(OP)                                                        \
+    OP(Add)                                                                         \
+    OP(Concatenation)                                                               \
+    OP(Conv2D)                                                                      \
+    OP(Dequantize)                                                                  \
+    OP(Logistic)                                                                    \
+    OP(MaxPool2D)                                                                   \
+    OP(Mul)                                                                         \
+    OP(Pad)                                                                         \
+    OP(Quantize)                                                                    \
+    OP(Reshape)                                                                     \
+    OP(ResizeNearestNeighbor)                                                       \
+    OP(StridedSlice)                                                                \
+    OP(Transpose)
+
+#endif /* APPLICATIONS_VISION_YOLOV5_MODEL_OPS_H_ */
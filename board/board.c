@@ -126,6 +126,9 @@ RT_WEAK void rt_hw_board_init()
 {
     extern void hw_board_init(char *clock_src, int32_t clock_src_freq, int32_t clock_target_freq);
 
+    /* ITCM code and zeroed TCM/DMA sections must be ready before anything runs from them */
+    rt_hw_mem_sections_init();
+
     /* Heap initialization */
 #if defined(RT_USING_HEAP)
     rt_system_heap_init((void *) HEAP_BEGIN, (void *) HEAP_END);
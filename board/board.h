@@ -30,7 +30,7 @@ extern "C"
 
 /*-------------------------- ROM/RAM CONFIG BEGIN --------------------------*/
  #define ROM_START              ((uint32_t)0x90000000)
- #define ROM_SIZE               (16384)
+ #define ROM_SIZE               (4096)           /* 0x90400000 on holds the XIP model slots */
  #define ROM_END                ((uint32_t)(ROM_START + ROM_SIZE * 1024))
 
 #define RAM_START              (0x24000000)
@@ -39,6 +39,48 @@ extern "C"
 
 /*-------------------------- ROM/RAM CONFIG END --------------------------*/
 
+/*-------------------------- MEMORY SECTION CONFIG BEGIN --------------------------*/
+
+/*
+ * Named sections, laid out in link.lds and set up by drv_memmap.c:
+ *
+ *   ITCM     63K  code, zero wait, copied from flash at boot: hot inner loops
+ *   DTCM    128K  data, zero wait, never cached, zeroed at boot: CPU-only scratch
+ *   NOCACHE 256K  D2 SRAM1/2, non-cacheable, zeroed at boot: DMA buffers that
+ *                 need no cache maintenance
+ *   SDRAM    32M  cached write-through, left uninitialized: bulk data
+ *
+ * DMA1/DMA2 cannot reach ITCM/DTCM, keep their buffers in NOCACHE, AXI SRAM or SDRAM.
+ * Code in ITCM calling flash (and back) goes through linker-generated long-branch veneers.
+ */
+#define BSP_SECTION_ITCM        RT_SECTION(".itcm")
+#define BSP_SECTION_DTCM        RT_SECTION(".dtcm")
+#define BSP_SECTION_NOCACHE     RT_SECTION(".nocache")
+#define BSP_SECTION_SDRAM       RT_SECTION(".sdram")
+
+/* copy .itcm and zero .dtcm/.nocache, called first thing in rt_hw_board_init */
+void rt_hw_mem_sections_init(void);
+/* SDRAM above the .sdram section, nothing owns it; only for one-shot use during boot */
+void *rt_hw_sdram_scratch(rt_size_t *size);
+
+/*-------------------------- MEMORY SECTION CONFIG END --------------------------*/
+
+/*-------------------------- CYCLE COUNTER CONFIG BEGIN --------------------------*/
+
+/* start the DWT cycle counter; a running counter is left as is so other users' deltas stay valid */
+rt_inline void rt_hw_cycle_counter_enable(void)
+{
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->LAR = 0xC5ACCE55;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+}
+
+/*-------------------------- CYCLE COUNTER CONFIG END --------------------------*/
+
 /*-------------------------- CLOCK CONFIG BEGIN --------------------------*/
 
 #define BSP_CLOCK_SOURCE                  ("HSE")
@@ -84,6 +126,13 @@ extern "C"
 
 /*-------------------------- UART CONFIG END --------------------------*/
 
+/*-------------------------- FLASH STORAGE CONFIG BEGIN --------------------------*/
+
+/* bring up FAL and EasyFlash once, runs at INIT_ENV level and is safe to call again */
+int rt_hw_easyflash_init(void);
+
+/*-------------------------- FLASH STORAGE CONFIG END --------------------------*/
+
 #ifdef __cplusplus
 }
 #endif
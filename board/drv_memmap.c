@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     HUAWEI       first version
+ */
+#include <rtthread.h>
+#include <string.h>
+#include "board.h"
+
+/*
+ * Boot-time setup of the named sections declared in board.h, a memory
+ * map report, and a benchmark comparing the regions for each kind of
+ * buffer the application places in them.
+ */
+
+#if defined(__ARMCC_VERSION)
+/* __main already copies ER_ITCM, UNINIT regions are only zeroed here */
+extern int Image$$ER_ITCM$$Base, Image$$ER_ITCM$$Limit;
+extern int Image$$RW_DTCM$$Base, Image$$RW_DTCM$$ZI$$Limit;
+extern int Image$$RW_NOCACHE$$Base, Image$$RW_NOCACHE$$ZI$$Limit;
+extern int Image$$RW_SDRAM$$Base, Image$$RW_SDRAM$$ZI$$Limit;
+extern int Image$$RW_IRAM1$$Base, Image$$RW_IRAM1$$ZI$$Limit;
+extern int Image$$ER_IROM1$$Base, Image$$ER_IROM1$$Limit;
+#define ITCM_START      ((uint8_t *)&Image$$ER_ITCM$$Base)
+#define ITCM_END        ((uint8_t *)&Image$$ER_ITCM$$Limit)
+#define DTCM_START      ((uint8_t *)&Image$$RW_DTCM$$Base)
+#define DTCM_END        ((uint8_t *)&Image$$RW_DTCM$$ZI$$Limit)
+#define NOCACHE_START   ((uint8_t *)&Image$$RW_NOCACHE$$Base)
+#define NOCACHE_END     ((uint8_t *)&Image$$RW_NOCACHE$$ZI$$Limit)
+#define SDRAM_START     ((uint8_t *)&Image$$RW_SDRAM$$Base)
+#define SDRAM_END       ((uint8_t *)&Image$$RW_SDRAM$$ZI$$Limit)
+#define RAM_USED_END    ((uint8_t *)&Image$$RW_IRAM1$$ZI$$Limit)
+#define ROM_USED_END    ((uint8_t *)&Image$$ER_IROM1$$Limit)
+#elif defined(__GNUC__)
+extern uint8_t _siitcm, __itcm_start, __itcm_end;
+extern uint8_t __dtcm_start, __dtcm_free__;
+extern uint8_t __nocache_start, __nocache_free__;
+extern uint8_t __sdram_start, __sdram_free__;
+extern uint8_t _ebss;
+#define ITCM_LOAD       (&_siitcm)
+#define ITCM_START      (&__itcm_start)
+#define ITCM_END        (&__itcm_end)
+#define DTCM_START      (&__dtcm_start)
+#define DTCM_END        (&__dtcm_free__)
+#define NOCACHE_START   (&__nocache_start)
+#define NOCACHE_END     (&__nocache_free__)
+#define SDRAM_START     (&__sdram_start)
+#define SDRAM_END       (&__sdram_free__)
+#define RAM_USED_END    (&_ebss)
+#define ROM_USED_END    (&_siitcm + (ITCM_END - ITCM_START))
+#endif
+
+#define ITCM_BASE       0x00000000
+#define ITCM_SIZE       (64 * 1024)
+#define DTCM_BASE       0x20000000
+#define DTCM_SIZE       (128 * 1024)
+#define NOCACHE_BASE    0x30000000
+#define NOCACHE_SIZE    (256 * 1024)
+#define SDRAM_BASE      0xC0000000
+#define SDRAM_SIZE      (32 * 1024 * 1024)
+
+void rt_hw_mem_sections_init(void)
+{
+    /* the D2 SRAMs are clocked off after reset */
+    __HAL_RCC_D2SRAM1_CLK_ENABLE();
+    __HAL_RCC_D2SRAM2_CLK_ENABLE();
+
+    /* caches are still off here, no maintenance needed */
+#ifdef ITCM_LOAD
+    memcpy(ITCM_START, ITCM_LOAD, ITCM_END - ITCM_START);
+#endif
+    memset(DTCM_START, 0, DTCM_END - DTCM_START);
+    memset(NOCACHE_START, 0, NOCACHE_END - NOCACHE_START);
+}
+
+void *rt_hw_sdram_scratch(rt_size_t *size)
+{
+#ifdef BSP_USING_SDRAM
+    uint8_t *start = (uint8_t *)RT_ALIGN((rt_ubase_t)SDRAM_END, 32);
+
+    *size = (uint8_t *)(SDRAM_BASE + SDRAM_SIZE) - start;
+    return start;
+#else
+    *size = 0;
+    return RT_NULL;
+#endif
+}
+
+struct mem_region
+{
+    const char *name;
+    uint32_t base;
+    uint32_t size;
+    uint32_t used;
+    const char *attr;
+};
+
+static int mem_regions(struct mem_region *r)
+{
+    int n = 0;
+
+    r[n++] = (struct mem_region){"QSPI", ROM_START, ROM_SIZE * 1024,
+                                 (uint32_t)(ROM_USED_END - (uint8_t *)ROM_START), "XIP, cached WT"};
+    r[n++] = (struct mem_region){"ITCM", ITCM_BASE, ITCM_SIZE,
+                                 (uint32_t)ITCM_END - ITCM_BASE, "code, 0 wait"};
+    r[n++] = (struct mem_region){"DTCM", DTCM_BASE, DTCM_SIZE,
+                                 (uint32_t)DTCM_END - DTCM_BASE, "data, 0 wait, no DMA1/2"};
+    r[n++] = (struct mem_region){"AXI SRAM", RAM_START, RAM_SIZE * 1024,
+                                 (uint32_t)RAM_USED_END - RAM_START, "cached WT, heap above"};
+    r[n++] = (struct mem_region){"SRAM1/2", NOCACHE_BASE, NOCACHE_SIZE,
+                                 (uint32_t)NOCACHE_END - NOCACHE_BASE, "not cached, DMA"};
+#ifdef BSP_USING_SDRAM
+    r[n++] = (struct mem_region){"SDRAM", SDRAM_BASE, SDRAM_SIZE,
+                                 (uint32_t)SDRAM_END - SDRAM_BASE, "cached WT"};
+#endif
+    return n;
+}
+
+static void memmap_report(void)
+{
+    struct mem_region r[6];
+    int n, i;
+
+    n = mem_regions(r);
+    rt_kprintf("region    base        size(KB) used(KB) free(KB) attributes\n");
+    for (i = 0; i < n; i++) {
+        rt_kprintf("%-9s 0x%08x %8u %8u %8u %s\n", r[i].name, r[i].base, r[i].size / 1024,
+                   (r[i].used + 1023) / 1024, (r[i].size - r[i].used) / 1024, r[i].attr);
+    }
+#ifdef RT_USING_HEAP
+    {
+        rt_uint32_t total, used, max_used;
+
+        rt_memory_info(&total, &used, &max_used);
+        rt_kprintf("heap      %u KB, %u KB used, %u KB peak\n", total / 1024, used / 1024,
+                   max_used / 1024);
+    }
+#endif
+}
+
+static int memmap_init(void)
+{
+    memmap_report();
+    return 0;
+}
+INIT_APP_EXPORT(memmap_init);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+#define MEM_BENCH_SIZE      4096            /* bytes per buffer, two buffers per region */
+#define MEM_BENCH_CALL      256             /* words per kernel call in the code fetch test */
+
+enum
+{
+    BENCH_DTCM,
+    BENCH_AXI,
+    BENCH_NOCACHE,
+    BENCH_SDRAM,
+    BENCH_REGIONS,
+};
+
+/* cycles for one pass over MEM_BENCH_SIZE bytes, 0 if the region was not tested */
+struct mem_bench
+{
+    uint32_t copy;
+    uint32_t seq;                   /* word reads */
+    uint32_t stride;                /* one byte per cache line, cold: miss latency */
+    uint32_t dma;                   /* what the CPU pays to read a buffer a DMA just wrote */
+};
+
+static const char *const bench_names[BENCH_REGIONS] = {"DTCM", "AXI SRAM", "SRAM1/2", "SDRAM"};
+
+static uint8_t bench_nocache[2][MEM_BENCH_SIZE] __attribute__((aligned(32))) BSP_SECTION_NOCACHE;
+#ifdef BSP_USING_SDRAM
+static uint8_t bench_sdram[2][MEM_BENCH_SIZE] __attribute__((aligned(32))) BSP_SECTION_SDRAM;
+#endif
+
+/* the same loop linked twice, once in ITCM and once in QSPI flash */
+#define BENCH_KERNEL_BODY                                   \
+    {                                                       \
+        uint32_t sum = 0;                                   \
+        int i;                                              \
+        for (i = 0; i < words; i++) {                       \
+            sum = (sum << 5 | sum >> 27) ^ buf[i];          \
+        }                                                   \
+        return sum;                                         \
+    }
+
+static uint32_t __attribute__((noinline)) BSP_SECTION_ITCM
+bench_kernel_itcm(const volatile uint32_t *buf, int words) BENCH_KERNEL_BODY
+
+static uint32_t __attribute__((noinline))
+bench_kernel_flash(const volatile uint32_t *buf, int words) BENCH_KERNEL_BODY
+
+static void bench_flush(uint8_t *buf, rt_bool_t cached)
+{
+    if (cached) {
+        SCB_CleanInvalidateDCache_by_Addr((uint32_t *)buf, 2 * MEM_BENCH_SIZE);
+    }
+}
+
+static void bench_region(struct mem_bench *b, uint8_t *buf, rt_bool_t cached)
+{
+    volatile uint32_t *words = (volatile uint32_t *)buf;
+    volatile uint8_t sink = 0;
+    uint32_t start, sum = 0;
+    int i;
+
+    bench_flush(buf, cached);
+    start = DWT->CYCCNT;
+    memcpy(buf + MEM_BENCH_SIZE, buf, MEM_BENCH_SIZE);
+    b->copy = DWT->CYCCNT - start;
+
+    bench_flush(buf, cached);
+    start = DWT->CYCCNT;
+    for (i = 0; i < MEM_BENCH_SIZE / 4; i++) {
+        sum += words[i];
+    }
+    b->seq = DWT->CYCCNT - start;
+
+    bench_flush(buf, cached);
+    start = DWT->CYCCNT;
+    for (i = 0; i < MEM_BENCH_SIZE; i += 32) {
+        sink += buf[i];
+    }
+    b->stride = DWT->CYCCNT - start;
+
+    /* a cached buffer has to be invalidated before reading what the DMA wrote */
+    start = DWT->CYCCNT;
+    if (cached) {
+        SCB_InvalidateDCache_by_Addr((uint32_t *)buf, MEM_BENCH_SIZE);
+    }
+    for (i = 0; i < MEM_BENCH_SIZE / 4; i++) {
+        sum += words[i];
+    }
+    b->dma = DWT->CYCCNT - start;
+    sink += sum;
+}
+
+/* ratio a/b with one decimal, printed as "x.y" */
+static void bench_ratio(const char *what, const char *fast, uint32_t a, const char *slow, uint32_t b)
+{
+    if (a == 0 || b == 0) {
+        rt_kprintf("%-16s %s vs %s: not measured\n", what, fast, slow);
+        return;
+    }
+    rt_kprintf("%-16s %s vs %s: %u vs %u cycles, %u.%ux\n", what, fast, slow, a, b,
+               b * 10 / a / 10, b * 10 / a % 10);
+}
+
+static void mem_bench(void)
+{
+    struct mem_bench b[BENCH_REGIONS];
+    uint32_t code_cold[2], code_warm[2], start;
+    uint8_t *dtcm, *axi;
+    int i;
+
+    rt_hw_cycle_counter_enable();
+    rt_memset(b, 0, sizeof(b));
+
+    /* DTCM has no allocator, use whatever the sections left free */
+    dtcm = (uint8_t *)RT_ALIGN((uint32_t)DTCM_END, 32);
+    if (dtcm + 2 * MEM_BENCH_SIZE <= (uint8_t *)(DTCM_BASE + DTCM_SIZE)) {
+        bench_region(&b[BENCH_DTCM], dtcm, RT_FALSE);
+    }
+    axi = rt_malloc_align(2 * MEM_BENCH_SIZE, 32);
+    if (axi != RT_NULL) {
+        bench_region(&b[BENCH_AXI], axi, RT_TRUE);
+        rt_free_align(axi);
+    }
+    bench_region(&b[BENCH_NOCACHE], bench_nocache[0], RT_FALSE);
+#ifdef BSP_USING_SDRAM
+    bench_region(&b[BENCH_SDRAM], bench_sdram[0], RT_TRUE);
+#endif
+
+    /* code fetch: cold right after an I-cache invalidate, then warm */
+    for (i = 0; i < 2; i++) {
+        uint32_t (*kernel)(const volatile uint32_t *, int) = i == 0 ? bench_kernel_itcm : bench_kernel_flash;
+
+        SCB_InvalidateICache();
+        start = DWT->CYCCNT;
+        kernel((const volatile uint32_t *)bench_nocache[0], MEM_BENCH_CALL);
+        code_cold[i] = DWT->CYCCNT - start;
+        start = DWT->CYCCNT;
+        kernel((const volatile uint32_t *)bench_nocache[0], MEM_BENCH_CALL);
+        code_warm[i] = DWT->CYCCNT - start;
+    }
+
+    rt_kprintf("cycles per %u bytes, caches flushed before each test\n", MEM_BENCH_SIZE);
+    rt_kprintf("region     memcpy   seq rd  line rd  dma rd\n");
+    for (i = 0; i < BENCH_REGIONS; i++) {
+        if (b[i].copy == 0) {
+            rt_kprintf("%-9s  not measured\n", bench_names[i]);
+            continue;
+        }
+        rt_kprintf("%-9s %7u %8u %8u %7u\n", bench_names[i], b[i].copy, b[i].seq, b[i].stride, b[i].dma);
+    }
+    rt_kprintf("code       ITCM cold %u warm %u, QSPI cold %u warm %u\n",
+               code_cold[0], code_warm[0], code_cold[1], code_warm[1]);
+
+    /* each placement decision against the region the data would otherwise live in */
+    rt_kprintf("\n");
+    bench_ratio("vision kernels", "ITCM", code_cold[0], "QSPI", code_cold[1]);
+    bench_ratio("vision scratch", "DTCM", b[BENCH_DTCM].stride, "SDRAM", b[BENCH_SDRAM].stride);
+    bench_ratio("http jobs", "DTCM", b[BENCH_DTCM].copy, "AXI SRAM", b[BENCH_AXI].copy);
+    bench_ratio("dma buffers", "SRAM1/2", b[BENCH_NOCACHE].dma, "SDRAM", b[BENCH_SDRAM].dma);
+}
+MSH_CMD_EXPORT(mem_bench, compare memory regions for each buffer placement);
+
+static void memmap(void)
+{
+    memmap_report();
+}
+MSH_CMD_EXPORT(memmap, show memory regions and their usage);
+#endif
@@ -84,6 +84,22 @@ int mpu_init(void)
     HAL_MPU_ConfigRegion(&MPU_InitStruct);
 #endif
 
+    /* Configure the MPU attributes as normal not cacheable for D2 SRAM1/2,
+       which holds the .nocache DMA buffers (see link.lds) */
+    MPU_InitStruct.Enable            = MPU_REGION_ENABLE;
+    MPU_InitStruct.BaseAddress       = 0x30000000;
+    MPU_InitStruct.Size              = MPU_REGION_SIZE_256KB;
+    MPU_InitStruct.AccessPermission  = MPU_REGION_FULL_ACCESS;
+    MPU_InitStruct.IsBufferable      = MPU_ACCESS_NOT_BUFFERABLE;
+    MPU_InitStruct.IsCacheable       = MPU_ACCESS_NOT_CACHEABLE;
+    MPU_InitStruct.IsShareable       = MPU_ACCESS_NOT_SHAREABLE;
+    MPU_InitStruct.Number            = MPU_REGION_NUMBER5;
+    MPU_InitStruct.TypeExtField      = MPU_TEX_LEVEL1;
+    MPU_InitStruct.SubRegionDisable  = 0x00;
+    MPU_InitStruct.DisableExec       = MPU_INSTRUCTION_ACCESS_DISABLE;
+
+    HAL_MPU_ConfigRegion(&MPU_InitStruct);
+
     /* Configure the MPU attributes as WT for QSPI */
     MPU_InitStruct.Enable            = MPU_REGION_ENABLE;
     MPU_InitStruct.BaseAddress       = 0x90000000;
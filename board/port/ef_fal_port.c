@@ -34,6 +34,7 @@
 #include <rthw.h>
 #include <rtthread.h>
 #include <fal.h>
+#include "board.h"
 
 /* EasyFlash partition name on FAL partition table */
 #define FAL_EF_PART_NAME               "easyflash"
@@ -47,6 +48,11 @@ static char log_buf[RT_CONSOLEBUF_SIZE];
 static struct rt_semaphore env_cache_lock;
 static const struct fal_partition *part = NULL;
 
+/* erase/write counters for the metrics endpoint, NG mode only erases on GC and format */
+volatile rt_uint32_t ef_port_erase_count = 0;
+volatile rt_uint32_t ef_port_erase_fail = 0;
+volatile rt_uint32_t ef_port_write_bytes = 0;
+
 /**
  * Flash port for hardware initialize.
  *
@@ -106,6 +112,11 @@ EfErrCode ef_port_erase(uint32_t addr, size_t size) {
     if (fal_partition_erase(part, addr, size) < 0)
     {
         result = EF_ERASE_ERR;
+        ef_port_erase_fail++;
+    }
+    else
+    {
+        ef_port_erase_count += size / EF_ERASE_MIN_SIZE;
     }
 
     return result;
@@ -128,6 +139,10 @@ EfErrCode ef_port_write(uint32_t addr, const uint32_t *buf, size_t size) {
     {
         result = EF_WRITE_ERR;
     }
+    else
+    {
+        ef_port_write_bytes += size;
+    }
 
     return result;
 }
@@ -206,3 +221,24 @@ void ef_print(const char *format, ...) {
     rt_kprintf("%s", log_buf);
     va_end(args);
 }
+
+/**
+ * Bring up FAL and EasyFlash once. The wifi config and the http session key
+ * both read the ENV during startup, so neither may depend on the other
+ * having initialized it. Runs before the INIT_APP_EXPORT initializers.
+ *
+ * @return 0 on success
+ */
+int rt_hw_easyflash_init(void) {
+    static rt_bool_t init_ok = RT_FALSE;
+    static EfErrCode result = EF_NO_ERR;
+
+    if (!init_ok) {
+        fal_init();
+        result = easyflash_init();
+        init_ok = RT_TRUE;
+    }
+
+    return result == EF_NO_ERR ? 0 : -1;
+}
+INIT_ENV_EXPORT(rt_hw_easyflash_init);
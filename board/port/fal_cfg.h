@@ -40,15 +40,24 @@ extern struct fal_flash_dev nor_flash0;
 }
 /* ====================== Partition Configuration ========================== */
 #ifdef FAL_PART_HAS_TABLE_CFG
-/* partition table */
+/* partition table
+ * "fs_legacy" overlaps "filesystem" and the model slots: it is the 12MB
+ * filesystem of older firmware, only mounted once by filesystem.c to move
+ * its files into the shrunk "filesystem" partition. */
 #define FAL_PART_TABLE                                                                     \
 {                                                                                          \
     {FAL_PART_MAGIC_WORD, "wifi_image", NOR_FLASH_DEV_NAME,           0,     512*1024, 0}, \
     {FAL_PART_MAGIC_WORD, "bt_image",   NOR_FLASH_DEV_NAME,    512*1024,     512*1024, 0}, \
     {FAL_PART_MAGIC_WORD, "download",   NOR_FLASH_DEV_NAME,   1024*1024,  2*1024*1024, 0}, \
     {FAL_PART_MAGIC_WORD, "easyflash",  NOR_FLASH_DEV_NAME, 3*1024*1024,  1*1024*1024, 0}, \
-    {FAL_PART_MAGIC_WORD, "filesystem", NOR_FLASH_DEV_NAME, 4*1024*1024, 12*1024*1024, 0}, \
+    {FAL_PART_MAGIC_WORD, "filesystem", NOR_FLASH_DEV_NAME, 4*1024*1024,  8*1024*1024, 0}, \
+    {FAL_PART_MAGIC_WORD, "model_a",    NOR_FLASH_DEV_NAME, 12*1024*1024, 2*1024*1024, 0}, \
+    {FAL_PART_MAGIC_WORD, "model_b",    NOR_FLASH_DEV_NAME, 14*1024*1024, 2*1024*1024, 0}, \
+    {FAL_PART_MAGIC_WORD, "fs_legacy",  NOR_FLASH_DEV_NAME, 4*1024*1024, 12*1024*1024, 0}, \
 }
 #endif /* FAL_PART_HAS_TABLE_CFG */
 
+/* present once /flash uses the 8MB "filesystem" partition, until then the model slots are unusable */
+#define FS_LAYOUT_MARK                 "/flash/.layout_v2"
+
 #endif /* _FAL_CFG_H_ */
@@ -20,6 +20,7 @@
 #endif
 
 #include <dfs_fs.h>
+#include <dfs_posix.h>
 #include "dfs_romfs.h"
 #include "drv_sdio.h"
 #include "fal.h"
@@ -100,43 +101,231 @@ static void sd_mount(void *parameter)
 
 #endif /* BSP_USING_SDCARD_FS */
 
-int mount_init(void)
+#ifdef BSP_USING_SPI_FLASH_FS
+/*
+ * The model slots took the last 4MB of the NOR, shrinking "filesystem" from
+ * 12MB to 8MB (see fal_cfg.h). LittleFS keeps the block count in its
+ * superblock, so a volume formatted by older firmware no longer mounts.
+ * Instead of reformatting it, the old volume is mounted once through
+ * "fs_legacy", its files are staged in free SDRAM, and written back after
+ * formatting. FS_LAYOUT_MARK tells the two layouts apart.
+ * A power cut between formatting and the end of the copy loses the files.
+ */
+#define FS_STAGE_DIR        RT_UINT32_MAX
+
+struct fs_stage
 {
-    if (dfs_mount(RT_NULL, "/", "rom", 0, &(romfs_root)) != 0)
+    rt_uint8_t *buf;
+    rt_size_t size;
+    rt_size_t used;
+    rt_size_t blocks;           /* rough LittleFS block count of the staged tree */
+};
+
+struct fs_stage_entry
+{
+    rt_uint32_t size;           /* FS_STAGE_DIR for a directory */
+    rt_uint32_t path_len;       /* path follows, then the file data */
+};
+
+static rt_size_t fs_stage_len(rt_uint32_t size, rt_uint32_t path_len)
+{
+    return RT_ALIGN(sizeof(struct fs_stage_entry) + path_len + (size == FS_STAGE_DIR ? 0 : size), 4);
+}
+
+static rt_uint8_t *fs_stage_alloc(struct fs_stage *st, const char *path, rt_uint32_t size)
+{
+    struct fs_stage_entry *e;
+    rt_uint32_t path_len = rt_strlen(path) + 1;
+    rt_size_t len = fs_stage_len(size, path_len);
+
+    if (st->used + len > st->size)
     {
-        LOG_E("rom mount to '/' failed!");
+        return RT_NULL;
     }
-#ifdef BSP_USING_SPI_FLASH_FS
-    struct rt_device *flash_dev = RT_NULL;
-
-#ifndef RT_USING_WIFI
-    fal_init();
-#endif
+    e = (struct fs_stage_entry *)(st->buf + st->used);
+    e->size = size;
+    e->path_len = path_len;
+    rt_memcpy(e + 1, path, path_len);
+    st->used += len;
+    st->blocks += 1 + (size == FS_STAGE_DIR ? 0 : (size + 4095) / 4096);
+    return (rt_uint8_t *)(e + 1) + path_len;
+}
 
-    flash_dev = fal_mtd_nor_device_create("filesystem");
+/* copy the tree under path (a DFS_PATH_MAX buffer holding len chars) into st, parents first */
+static int fs_stage_dir(struct fs_stage *st, char *path, rt_size_t len)
+{
+    DIR *dir;
+    struct dirent *ent;
+    struct stat sb;
+    rt_uint8_t *data;
+    int fd, ret = 0;
 
-    if (flash_dev)
+    dir = opendir(path);
+    if (dir == RT_NULL)
+    {
+        return -1;
+    }
+    while (ret == 0 && (ent = readdir(dir)) != RT_NULL)
     {
-        //mount filesystem
-        if (dfs_mount(flash_dev->parent.name, "/flash", "lfs", 0, 0) != 0)
+        if (rt_strcmp(ent->d_name, ".") == 0 || rt_strcmp(ent->d_name, "..") == 0)
         {
-            LOG_W("mount to '/flash' failed! try to mkfs %s", flash_dev->parent.name);
-            dfs_mkfs("lfs", flash_dev->parent.name);
-            if (dfs_mount(flash_dev->parent.name, "/flash", "lfs", 0, 0) == 0)
+            continue;
+        }
+        if (len + 1 + rt_strlen(ent->d_name) >= DFS_PATH_MAX)
+        {
+            ret = -1;
+            break;
+        }
+        rt_snprintf(path + len, DFS_PATH_MAX - len, "/%s", ent->d_name);
+        if (stat(path, &sb) != 0)
+        {
+            ret = -1;
+        }
+        else if (S_ISDIR(sb.st_mode))
+        {
+            if (fs_stage_alloc(st, path, FS_STAGE_DIR) == RT_NULL ||
+                fs_stage_dir(st, path, rt_strlen(path)) != 0)
             {
-                LOG_I("mount to '/flash' success!");
+                ret = -1;
             }
         }
         else
         {
-            LOG_I("mount to '/flash' success!");
+            data = fs_stage_alloc(st, path, sb.st_size);
+            if (data == RT_NULL || (fd = open(path, O_RDONLY)) < 0)
+            {
+                ret = -1;
+            }
+            else
+            {
+                if (read(fd, data, sb.st_size) != (int)sb.st_size)
+                {
+                    ret = -1;
+                }
+                close(fd);
+            }
         }
+        path[len] = '\0';
     }
-    else
+    closedir(dir);
+    return ret;
+}
+
+static int fs_restore(const struct fs_stage *st)
+{
+    const struct fs_stage_entry *e;
+    const char *path;
+    rt_size_t pos;
+    int fd, n;
+
+    for (pos = 0; pos < st->used; pos += fs_stage_len(e->size, e->path_len))
+    {
+        e = (const struct fs_stage_entry *)(st->buf + pos);
+        path = (const char *)(e + 1);
+        if (e->size == FS_STAGE_DIR)
+        {
+            if (mkdir(path, 0) != 0)
+            {
+                return -1;
+            }
+            continue;
+        }
+        fd = open(path, O_WRONLY | O_CREAT | O_TRUNC);
+        if (fd < 0)
+        {
+            return -1;
+        }
+        n = write(fd, path + e->path_len, e->size);
+        close(fd);
+        if (n != (int)e->size)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* format "filesystem", write back the staged files if any and mark the new layout */
+static void flash_format(struct rt_device *flash_dev, const struct fs_stage *st)
+{
+    int fd;
+
+    dfs_mkfs("lfs", flash_dev->parent.name);
+    if (dfs_mount(flash_dev->parent.name, "/flash", "lfs", 0, 0) != 0)
+    {
+        LOG_E("mount to '/flash' failed!");
+        return;
+    }
+    if (st != RT_NULL && fs_restore(st) != 0)
+    {
+        LOG_E("restore of the old '/flash' files failed, some are lost");
+    }
+    fd = open(FS_LAYOUT_MARK, O_WRONLY | O_CREAT);
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    LOG_I("mount to '/flash' success!");
+}
+
+static void flash_mount(void)
+{
+    struct rt_device *flash_dev, *legacy_dev;
+    const struct fal_partition *part;
+    struct fs_stage st = {0};
+    char path[DFS_PATH_MAX] = "/flash";
+
+    flash_dev = fal_mtd_nor_device_create("filesystem");
+    if (flash_dev == RT_NULL)
     {
         LOG_E("Can't create  block device  filesystem or bt_image partition.");
+        return;
     }
+    if (dfs_mount(flash_dev->parent.name, "/flash", "lfs", 0, 0) == 0)
+    {
+        if (access(FS_LAYOUT_MARK, 0) == 0)
+        {
+            LOG_I("mount to '/flash' success!");
+            return;
+        }
+        /* older LittleFS versions mount an old volume despite the block count */
+        dfs_unmount("/flash");
+    }
+
+    legacy_dev = fal_mtd_nor_device_create("fs_legacy");
+    if (legacy_dev == RT_NULL || dfs_mount(legacy_dev->parent.name, "/flash", "lfs", 0, 0) != 0)
+    {
+        LOG_W("mount to '/flash' failed! try to mkfs %s", flash_dev->parent.name);
+        flash_format(flash_dev, RT_NULL);
+        return;
+    }
+
+    part = fal_partition_find("filesystem");
+    st.buf = rt_hw_sdram_scratch(&st.size);
+    if (st.buf == RT_NULL || fs_stage_dir(&st, path, rt_strlen(path)) != 0 ||
+        st.blocks > part->len / 4096 * 3 / 4)
+    {
+        /* keep the files; the model slots overlap this layout and refuse installs */
+        LOG_E("can't move '/flash' to the new layout (%d bytes staged), keeping the old one", st.used);
+        return;
+    }
+    dfs_unmount("/flash");
+    LOG_W("moving %d bytes of '/flash' to the new layout", st.used);
+    flash_format(flash_dev, &st);
+}
+#endif /* BSP_USING_SPI_FLASH_FS */
 
+int mount_init(void)
+{
+    if (dfs_mount(RT_NULL, "/", "rom", 0, &(romfs_root)) != 0)
+    {
+        LOG_E("rom mount to '/' failed!");
+    }
+#ifdef BSP_USING_SPI_FLASH_FS
+#ifndef RT_USING_WIFI
+    fal_init();
+#endif
+    flash_mount();
 #endif
 
 #ifdef BSP_USING_SDCARD_FS
@@ -33,6 +33,7 @@
 
 #include <easyflash.h>
 #include <fal.h>
+#include "board.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -254,8 +255,8 @@ static const struct rt_wlan_cfg_ops ops =
 
 void wlan_autoconnect_init(void)
 {
-    fal_init();
-    easyflash_init();
+    /* also run at INIT_ENV level, the second call only returns the result */
+    rt_hw_easyflash_init();
 
     rt_wlan_cfg_set_ops(&ops);
     rt_wlan_cfg_cache_refresh();